@@ -0,0 +1,83 @@
+#ifndef BENCHSUPPORT_H
+#define BENCHSUPPORT_H
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+/**
+ * Outils communs aux bancs d'essai du moteur : répertoire de travail temporaire, génération d'un vidage
+ * NDJSON de tâches (le format que le serveur Node écrit au démarrage) et chronométrage.
+ */
+
+using BenchClock = std::chrono::steady_clock;
+
+/**
+ * Secondes écoulées
+ * start L'instant de départ.
+ * Retourne Le temps écoulé depuis 'start', en secondes.
+ */
+inline double secondsSince(BenchClock::time_point start) {
+    return std::chrono::duration<double>(BenchClock::now() - start).count();
+}
+
+/**
+ * Créer le répertoire de travail
+ * Crée (vide) un répertoire propre au processus dans le répertoire temporaire du système.
+ * name Le nom du banc d'essai.
+ * Retourne Le chemin du répertoire, terminé par '/'.
+ */
+inline std::string makeBenchDirectory(const std::string& name) {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / (name + "-" + std::to_string(::getpid()));
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory.string() + "/";
+}
+
+/**
+ * Écrire un vidage de tâches
+ * Génère 'count' tâches reproductibles réparties entre 'users' utilisateurs : titres et descriptions de
+ * quelques mots, priorités et statuts variés, une échéance sur deux, une étiquette sur trois.
+ * path Le chemin du fichier NDJSON à écrire.
+ * count Le nombre de tâches.
+ * users Le nombre d'utilisateurs.
+ */
+inline void writeTaskDump(const std::string& path, size_t count, size_t users) {
+    static const char* const WORDS[] = { "review", "deploy", "invoice", "meeting", "report", "backup",
+                                         "release", "budget", "design", "migrate", "audit", "planning" };
+    const size_t wordCount = sizeof(WORDS) / sizeof(WORDS[0]);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot write " + path);
+
+    std::mt19937 random(7);
+    const long long now = 1700000000;
+    std::string line;
+    for (size_t i = 0; i < count; i++) {
+        const char* first = WORDS[random() % wordCount];
+        const char* second = WORDS[random() % wordCount];
+        int status = static_cast<int>(random() % 4);
+        long long createdAt = now - static_cast<long long>(random() % (365 * 86400));
+
+        line = "{\"taskId\":\"t" + std::to_string(i) + "\",\"userId\":\"user" + std::to_string(i % users) + "\"";
+        line += ",\"title\":\"" + std::string(first) + " " + second + " " + std::to_string(i) + "\"";
+        line += ",\"description\":\"" + std::string(second) + " notes for " + first + "\"";
+        line += ",\"priority\":" + std::to_string(1 + random() % 3);
+        line += ",\"status\":" + std::to_string(status);
+        line += ",\"tags\":" + std::string(i % 3 == 0 ? "[\"work\"]" : "[]");
+        line += ",\"isFavorite\":" + std::string(i % 10 == 0 ? "true" : "false");
+        line += ",\"dueDate\":" + (i % 2 == 0 ? std::to_string(now + static_cast<long long>(random() % (60 * 86400))) : std::string("null"));
+        line += ",\"createdAt\":" + std::to_string(createdAt);
+        line += ",\"completedAt\":" + (status == 3 ? std::to_string(createdAt + 86400) : std::string("null"));
+        line += "}\n";
+        out << line;
+    }
+    if (!out) throw std::runtime_error("Cannot write " + path);
+}
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * Banc d'essai : contention des files concurrentes
+ * Compare, de 1 à 32 threads, le débit de la File chaînée Queue<T> protégée par un mutex, de MPMCQueue
+ * (anneau borné) et de SegmentedQueue (segments chaînés). Deux charges sont mesurées :
+ *  - paires : chaque thread enfile puis défile un élément, en boucle (file presque vide, contention maximale
+ *    sur les deux extrémités) ;
+ *  - producteurs/consommateurs : la moitié des threads enfile, l'autre moitié défile.
+ *
+ * Compilation (depuis cpp-backend) :
+ *   g++ -std=c++17 -O2 -pthread -Iinclude bench/mpmc_queue_bench.cpp datastructures/Queue.cpp \
+ *       datastructures/MPMCQueue.cpp datastructures/SegmentedQueue.cpp -o mpmc_queue_bench
+ * Exécution : ./mpmc_queue_bench [opérations par configuration] [threads maximum]
+ */
+#include "../datastructures/MPMCQueue.h"
+#include "../datastructures/Queue.h"
+#include "../datastructures/SegmentedQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * File chaînée d'origine protégée par un mutex : la référence à battre.
+ */
+class LockedQueue {
+private:
+    Queue<int> queue;
+    std::mutex mutex;
+
+public:
+    bool tryEnqueue(int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.enqueue(value);
+        return true;
+    }
+
+    bool tryDequeue(int& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.isEmpty()) return false;
+        out = queue.dequeue();
+        return true;
+    }
+};
+
+/**
+ * Adaptateur de SegmentedQueue (non bornée : l'enfilement réussit toujours).
+ */
+class SegmentedAdapter {
+private:
+    SegmentedQueue<int> queue;
+
+public:
+    bool tryEnqueue(int value) { queue.enqueue(value); return true; }
+    bool tryDequeue(int& out) { return queue.tryDequeue(out); }
+};
+
+/**
+ * Adaptateur de MPMCQueue, dimensionné pour contenir toutes les paires en vol.
+ */
+class RingAdapter {
+private:
+    MPMCQueue<int> queue;
+
+public:
+    RingAdapter() : queue(4096) {}
+    bool tryEnqueue(int value) { return queue.tryEnqueue(value); }
+    bool tryDequeue(int& out) { return queue.tryDequeue(out); }
+};
+
+/**
+ * Lancer des threads
+ * Démarre 'threads' threads qui attendent un signal commun, puis chronomètre leur exécution.
+ * work La fonction exécutée par chaque thread, avec son numéro.
+ * Retourne La durée écoulée entre le signal de départ et la fin du dernier thread, en secondes.
+ */
+template<typename Work>
+static double runThreads(int threads, Work work) {
+    std::atomic<bool> start(false);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            work(t);
+        });
+    }
+    auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    for (std::thread& thread : pool) thread.join();
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+/**
+ * Paires enfilement/défilement
+ * Retourne Le débit en opérations (enfilements + défilements) par seconde.
+ */
+template<typename Q>
+static double pairs(int threads, long operations) {
+    Q queue;
+    long perThread = operations / 2 / threads;
+    double seconds = runThreads(threads, [&](int t) {
+        int value = 0;
+        for (long i = 0; i < perThread; i++) {
+            while (!queue.tryEnqueue(t)) std::this_thread::yield();
+            while (!queue.tryDequeue(value)) std::this_thread::yield();
+        }
+    });
+    return 2.0 * perThread * threads / seconds;
+}
+
+/**
+ * Producteurs et consommateurs
+ * La moitié des threads (au moins un) produit, les autres consomment jusqu'à avoir tout retiré.
+ * Retourne Le débit en éléments transférés par seconde.
+ */
+template<typename Q>
+static double producersConsumers(int threads, long operations) {
+    Q queue;
+    int producers = threads > 1 ? threads / 2 : 1;
+    int consumers = threads > 1 ? threads - producers : 1;
+    long perProducer = operations / 2 / producers;
+    long total = perProducer * producers;
+    std::atomic<long> consumed(0);
+
+    double seconds = runThreads(producers + consumers, [&](int t) {
+        if (t < producers) {
+            for (long i = 0; i < perProducer; i++) {
+                while (!queue.tryEnqueue(t)) std::this_thread::yield();
+            }
+            return;
+        }
+        int value = 0;
+        while (consumed.load(std::memory_order_relaxed) < total) {
+            if (queue.tryDequeue(value)) consumed.fetch_add(1, std::memory_order_relaxed);
+            else std::this_thread::yield();
+        }
+    });
+    return total / seconds;
+}
+
+int main(int argc, char** argv) {
+    long operations = argc > 1 ? std::atol(argv[1]) : 2000000;
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : 32;
+    if (operations <= 0 || maxThreads <= 0) {
+        std::fprintf(stderr, "usage: %s [operations > 0] [max threads > 0]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("Concurrent queue throughput, %ld operations per run, %u hardware threads\n\n",
+                operations, std::thread::hardware_concurrency());
+    std::printf("%-8s %-22s %16s %16s %16s\n", "threads", "workload", "mutex Queue", "MPMCQueue", "SegmentedQueue");
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::printf("%-8d %-22s %12.2f M/s %12.2f M/s %12.2f M/s\n", threads, "enqueue/dequeue pairs",
+                    pairs<LockedQueue>(threads, operations) / 1e6,
+                    pairs<RingAdapter>(threads, operations) / 1e6,
+                    pairs<SegmentedAdapter>(threads, operations) / 1e6);
+        std::printf("%-8d %-22s %12.2f M/s %12.2f M/s %12.2f M/s\n", threads, "producers/consumers",
+                    producersConsumers<LockedQueue>(threads, operations) / 1e6,
+                    producersConsumers<RingAdapter>(threads, operations) / 1e6,
+                    producersConsumers<SegmentedAdapter>(threads, operations) / 1e6);
+    }
+    return 0;
+}
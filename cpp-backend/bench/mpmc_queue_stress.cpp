@@ -0,0 +1,195 @@
+/**
+ * Test de charge : exactitude des files concurrentes
+ * Des producteurs enfilent chacun une suite numérotée pendant que des consommateurs défilent, sur MPMCQueue
+ * (dont une petite capacité, pour forcer les tours d'anneau et la file pleine) et sur SegmentedQueue (pour
+ * forcer l'ajout et la libération de segments). Vérifie que :
+ *  - chaque élément est retiré exactement une fois (ni perte, ni doublon) ;
+ *  - chaque consommateur voit les éléments d'un même producteur dans l'ordre où ils ont été enfilés ;
+ *  - la file est vide à la fin.
+ * Une variante sur QueueEntry (qui contient une chaîne) vérifie que les données ne sont pas lues à moitié
+ * écrites. Le programme se termine avec un code non nul au premier échec.
+ *
+ * Compilation (depuis cpp-backend ; ajouter -fsanitize=thread pour traquer les courses de données) :
+ *   g++ -std=c++17 -O2 -pthread -Iinclude bench/mpmc_queue_stress.cpp datastructures/MPMCQueue.cpp \
+ *       datastructures/SegmentedQueue.cpp -o mpmc_queue_stress
+ * Exécution : ./mpmc_queue_stress [éléments par producteur]
+ */
+#include "../datastructures/MPMCQueue.h"
+#include "../datastructures/SegmentedQueue.h"
+#include "../models/QueueEntry.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+/**
+ * Signaler un échec
+ */
+static void fail(const std::string& scenario, const std::string& message) {
+    std::printf("FAIL %s: %s\n", scenario.c_str(), message.c_str());
+    failures++;
+}
+
+/**
+ * Adaptateurs : un enfilement qui attend la place libre, un défilement non bloquant.
+ */
+template<typename T>
+static void put(MPMCQueue<T>& queue, const T& value) {
+    while (!queue.tryEnqueue(value)) std::this_thread::yield();
+}
+
+template<typename T>
+static void put(SegmentedQueue<T>& queue, const T& value) {
+    queue.enqueue(value);
+}
+
+/**
+ * Encodage d'un élément : producteur et rang dans sa suite.
+ */
+static int encode(int producer, int index, int perProducer) { return producer * perProducer + index; }
+
+static int encodedValue(int value) { return value; }
+
+static int encodedValue(const QueueEntry& entry) {
+    // La chaîne et le numéro d'ordre sont écrits ensemble : ils doivent concorder à la lecture
+    if (entry.taskId != std::to_string(entry.sequence)) return -1;
+    return static_cast<int>(entry.sequence);
+}
+
+static int makeItem(int value, int) { return value; }
+
+static QueueEntry makeItem(int value, const QueueEntry&) {
+    return QueueEntry(std::to_string(value), MEDIUM, 0, 0, value);
+}
+
+/**
+ * Exécuter un scénario
+ * queue La file testée (vide).
+ * producers Le nombre de producteurs.
+ * consumers Le nombre de consommateurs.
+ * perProducer Le nombre d'éléments enfilés par chaque producteur.
+ */
+template<typename Q, typename T>
+static void runScenario(const std::string& scenario, Q& queue, int producers, int consumers, int perProducer) {
+    const long total = static_cast<long>(producers) * perProducer;
+    std::unique_ptr<std::atomic<unsigned char>[]> seen(new std::atomic<unsigned char>[total]);
+    for (long i = 0; i < total; i++) seen[i].store(0, std::memory_order_relaxed);
+
+    std::atomic<long> consumed(0);
+    std::atomic<long> duplicates(0);
+    std::atomic<long> corrupted(0);
+    std::atomic<long> reordered(0);
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            const T sample{};
+            for (int i = 0; i < perProducer; i++) {
+                put(queue, makeItem(encode(p, i, perProducer), sample));
+            }
+        });
+    }
+
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            std::vector<int> lastByProducer(producers, -1);
+            std::vector<T> batch;
+            T item{};
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                // Alterne défilement unitaire et par lots pour couvrir les deux chemins
+                batch.clear();
+                if (queue.tryDequeue(item)) batch.push_back(item);
+                else if (queue.dequeueMany(8, batch) == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                for (const T& taken : batch) {
+                    int value = encodedValue(taken);
+                    if (value < 0 || value >= total) {
+                        corrupted.fetch_add(1);
+                        continue;
+                    }
+                    if (seen[value].fetch_add(1) != 0) duplicates.fetch_add(1);
+
+                    int producer = value / perProducer;
+                    int index = value % perProducer;
+                    if (index <= lastByProducer[producer]) reordered.fetch_add(1);
+                    lastByProducer[producer] = index;
+                }
+                consumed.fetch_add(static_cast<long>(batch.size()));
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+    for (std::thread& thread : threads) thread.join();
+
+    long missing = 0;
+    for (long i = 0; i < total; i++) {
+        if (seen[i].load() == 0) missing++;
+    }
+
+    int before = failures;
+    if (missing) fail(scenario, std::to_string(missing) + " items never dequeued");
+    if (duplicates) fail(scenario, std::to_string(duplicates.load()) + " items dequeued twice");
+    if (corrupted) fail(scenario, std::to_string(corrupted.load()) + " corrupted items");
+    if (reordered) fail(scenario, std::to_string(reordered.load()) + " items out of producer order");
+    if (!queue.isEmpty()) fail(scenario, "queue not empty at the end (size " + std::to_string(queue.getSize()) + ")");
+    if (failures == before) {
+        std::printf("ok   %-48s %ld items\n", scenario.c_str(), total);
+    }
+}
+
+int main(int argc, char** argv) {
+    int perProducer = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (perProducer <= 0) {
+        std::fprintf(stderr, "usage: %s [items per producer > 0]\n", argv[0]);
+        return 1;
+    }
+
+    const int configurations[][2] = { {1, 1}, {1, 4}, {4, 1}, {4, 4}, {8, 8}, {16, 16} };
+
+    for (const auto& config : configurations) {
+        int producers = config[0];
+        int consumers = config[1];
+        std::string shape = std::to_string(producers) + "P/" + std::to_string(consumers) + "C";
+
+        {
+            MPMCQueue<int> queue(1024);
+            runScenario<MPMCQueue<int>, int>("MPMCQueue<int> capacity 1024 " + shape, queue, producers, consumers, perProducer);
+        }
+        {
+            MPMCQueue<int> queue(4);
+            runScenario<MPMCQueue<int>, int>("MPMCQueue<int> capacity 4 " + shape, queue, producers, consumers, perProducer / 10);
+        }
+        {
+            SegmentedQueue<int> queue;
+            runScenario<SegmentedQueue<int>, int>("SegmentedQueue<int> " + shape, queue, producers, consumers, perProducer);
+        }
+    }
+
+    {
+        MPMCQueue<QueueEntry> queue(64);
+        runScenario<MPMCQueue<QueueEntry>, QueueEntry>("MPMCQueue<QueueEntry> capacity 64 4P/4C", queue, 4, 4, perProducer / 4);
+    }
+    {
+        SegmentedQueue<QueueEntry> queue;
+        runScenario<SegmentedQueue<QueueEntry>, QueueEntry>("SegmentedQueue<QueueEntry> 4P/4C", queue, 4, 4, perProducer / 4);
+    }
+
+    if (failures) {
+        std::printf("\n%d failure(s)\n", failures);
+        return 1;
+    }
+    std::printf("\nall scenarios passed\n");
+    return 0;
+}
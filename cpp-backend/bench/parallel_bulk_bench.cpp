@@ -0,0 +1,138 @@
+/**
+ * Banc d'essai : accélération des traitements en masse
+ * Mesure, de 1 à N threads de l'ordonnanceur à vol de tâches (setThreadCount), la durée des traitements en
+ * masse sur un magasin d'un million de tâches :
+ *  - importation du vidage NDJSON (analyse par blocs et reconstruction des index) ;
+ *  - exportation synchrone (sérialisation par blocs) ;
+ *  - chargement d'un instantané (reconstruction des index seule).
+ * L'accélération est rapportée par rapport à un thread. Chaque mesure utilise un contrôleur neuf et le nombre
+ * de tâches chargées est vérifié.
+ *
+ * Compilation (depuis cpp-backend) :
+ *   g++ -std=c++17 -O2 -pthread -Iinclude bench/parallel_bulk_bench.cpp \
+ *       $(find controllers models datastructures persistence query runtime -name '*.cpp') -o parallel_bulk_bench
+ * Exécution : ./parallel_bulk_bench [nombre de tâches] [threads maximum]
+ */
+#include "BenchSupport.h"
+#include "../controllers/TaskController.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+
+static const size_t USERS = 1000;
+
+/**
+ * Exécuter une requête
+ * Retourne La réponse analysée ; lève une exception si elle signale un échec.
+ */
+static json call(TaskController& controller, const json& request) {
+    json response = json::parse(controller.handleRequest(request.dump()));
+    if (!response.value("success", false)) {
+        throw std::runtime_error(request.value("action", "?") + " failed: " + response.dump());
+    }
+    return response;
+}
+
+/**
+ * Vérifier le nombre de tâches chargées
+ */
+static void expectTasks(TaskController& controller, size_t expected, const char* step) {
+    size_t loaded = call(controller, {{"action", "stats"}, {"userId", "user0"}})["totalTasks"].get<size_t>();
+    if (loaded != expected) {
+        throw std::runtime_error(std::string(step) + ": loaded " + std::to_string(loaded) + " tasks");
+    }
+}
+
+/**
+ * Durées d'une configuration, en secondes
+ */
+struct BulkTimes {
+    double import = 0;
+    double exportAll = 0;
+    double snapshotLoad = 0;
+};
+
+/**
+ * Mesurer une configuration
+ * threads Le nombre de threads de l'ordonnanceur.
+ */
+static BulkTimes measure(size_t threads, const std::string& directory, size_t expected) {
+    BulkTimes times;
+    {
+        TaskController controller;
+        controller.setThreadCount(threads);
+
+        auto start = BenchClock::now();
+        controller.importTasks(json{{"path", directory + "tasks.ndjson"}}.dump());
+        times.import = secondsSince(start);
+        expectTasks(controller, expected, "import");
+
+        start = BenchClock::now();
+        call(controller, {{"action", "export"}, {"data", {{"path", directory + "export.ndjson"}}}});
+        times.exportAll = secondsSince(start);
+    }
+    {
+        TaskController controller;
+        controller.setThreadCount(threads);
+
+        auto start = BenchClock::now();
+        controller.openSnapshots(directory + "tasks.snapshot", 0);
+        times.snapshotLoad = secondsSince(start);
+        expectTasks(controller, expected, "snapshot load");
+    }
+    return times;
+}
+
+int main(int argc, char** argv) {
+    long count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    long maxThreads = argc > 2 ? std::atol(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    if (count <= 0 || maxThreads <= 0) {
+        std::fprintf(stderr, "usage: %s [tasks > 0] [max threads > 0]\n", argv[0]);
+        return 1;
+    }
+
+    try {
+        std::string directory = makeBenchDirectory("parallel-bulk-bench");
+        writeTaskDump(directory + "tasks.ndjson", static_cast<size_t>(count), USERS);
+
+        // Instantané de référence, écrit une fois en arrière-plan puis attendu
+        {
+            TaskController controller;
+            controller.setThreadCount(1);
+            controller.openSnapshots(directory + "tasks.snapshot", 0);
+            controller.importTasks(json{{"path", directory + "tasks.ndjson"}}.dump());
+            call(controller, {{"action", "snapshot"}});
+            while (call(controller, {{"action", "snapshotStatus"}}).value("inProgress", false)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        std::printf("Bulk operations, %ld tasks across %zu users, %u hardware threads\n\n",
+                    count, USERS, std::thread::hardware_concurrency());
+        std::printf("%-8s %18s %18s %18s\n", "threads", "import", "export", "snapshot load");
+
+        std::vector<size_t> threadCounts;
+        for (size_t threads = 1; threads < static_cast<size_t>(maxThreads); threads *= 2) threadCounts.push_back(threads);
+        threadCounts.push_back(static_cast<size_t>(maxThreads));
+
+        BulkTimes baseline;
+        for (size_t threads : threadCounts) {
+            BulkTimes times = measure(threads, directory, static_cast<size_t>(count));
+            if (threads == 1) baseline = times;
+            std::printf("%-8zu %9.0f ms %5.2fx %9.0f ms %5.2fx %9.0f ms %5.2fx\n", threads,
+                        times.import * 1000.0, baseline.import / times.import,
+                        times.exportAll * 1000.0, baseline.exportAll / times.exportAll,
+                        times.snapshotLoad * 1000.0, baseline.snapshotLoad / times.snapshotLoad);
+        }
+
+        std::filesystem::remove_all(directory);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
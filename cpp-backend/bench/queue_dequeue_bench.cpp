@@ -0,0 +1,133 @@
+/**
+ * Banc d'essai : débit de retrait des files de traitement
+ * Remplit une file de 100 000 entrées (priorités, échéances et dates de mise en file variées), puis mesure
+ * le temps nécessaire pour la vider, pour le tas PriorityQueue seul et pour SchedulingQueue dans chaque
+ * politique. La File FIFO d'origine (Queue<QueueEntry>) sert de référence.
+ *
+ * Compilation (depuis cpp-backend) :
+ *   g++ -std=c++17 -O2 -Iinclude bench/queue_dequeue_bench.cpp datastructures/PriorityQueue.cpp \
+ *       datastructures/SchedulingQueue.cpp datastructures/Queue.cpp models/Task.cpp -o queue_dequeue_bench
+ * Exécution : ./queue_dequeue_bench [nombre d'entrées] [répétitions]
+ */
+#include "../datastructures/PriorityQueue.h"
+#include "../datastructures/Queue.h"
+#include "../datastructures/SchedulingQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Générer les entrées
+ * Produit des entrées reproductibles : priorité aléatoire, échéance absente une fois sur quatre, date de
+ * mise en file étalée sur une journée.
+ * count Le nombre d'entrées.
+ * Retourne Les entrées, dans l'ordre d'arrivée.
+ */
+static std::vector<QueueEntry> makeEntries(int count) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> priority(LOW, HIGH);
+    std::uniform_int_distribution<int> dueOffset(0, 30 * 86400);
+    std::uniform_int_distribution<int> ageOffset(0, 86400);
+
+    const time_t now = 1700000000;
+    std::vector<QueueEntry> entries;
+    entries.reserve(count);
+    for (int i = 0; i < count; i++) {
+        time_t due = (i % 4 == 0) ? 0 : now + dueOffset(random);
+        entries.emplace_back("task-" + std::to_string(i), static_cast<Priority>(priority(random)), due,
+                             now - ageOffset(random), i);
+    }
+    return entries;
+}
+
+/**
+ * Mesurer
+ * Exécute 'prepare' (non chronométré) puis 'drain' (chronométré), 'repeat' fois, et garde le meilleur temps.
+ * Retourne Le meilleur temps de 'drain', en secondes.
+ */
+template<typename Prepare, typename Drain>
+static double bestOf(int repeat, Prepare prepare, Drain drain) {
+    double best = 1e30;
+    for (int r = 0; r < repeat; r++) {
+        prepare();
+        auto start = Clock::now();
+        drain();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+/**
+ * Afficher une ligne de résultat
+ */
+static void report(const char* name, int count, double seconds, long long checksum) {
+    std::printf("%-42s %10.2f ms %12.0f dequeues/s   (checksum %lld)\n",
+                name, seconds * 1000.0, count / seconds, checksum);
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (count <= 0 || repeat <= 0) {
+        std::fprintf(stderr, "usage: %s [entries > 0] [repeat > 0]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<QueueEntry> entries = makeEntries(count);
+    std::printf("Dequeue throughput, %d entries, best of %d\n\n", count, repeat);
+
+    // Référence : la File chaînée utilisée avant les politiques d'ordonnancement
+    {
+        Queue<QueueEntry> queue;
+        long long checksum = 0;
+        double seconds = bestOf(repeat,
+            [&] { queue.clear(); queue.enqueueMany(entries); },
+            [&] { checksum = 0; while (!queue.isEmpty()) checksum += queue.dequeue().sequence; });
+        report("Queue<QueueEntry> (baseline)", count, seconds, checksum);
+    }
+
+    const SchedulingPolicy heapPolicies[] = { PRIORITY_POLICY, DEADLINE_POLICY, AGING_POLICY };
+
+    for (SchedulingPolicy policy : heapPolicies) {
+        PriorityQueue heap(policy);
+        long long checksum = 0;
+        double seconds = bestOf(repeat,
+            [&] { heap.clear(); heap.pushMany(entries); },
+            [&] { checksum = 0; while (!heap.isEmpty()) checksum += heap.pop().sequence; });
+        std::string name = "PriorityQueue " + policyToString(policy);
+        report(name.c_str(), count, seconds, checksum);
+    }
+
+    const SchedulingPolicy allPolicies[] = { FIFO_POLICY, PRIORITY_POLICY, DEADLINE_POLICY, AGING_POLICY };
+
+    for (SchedulingPolicy policy : allPolicies) {
+        SchedulingQueue queue;
+        long long checksum = 0;
+        auto fill = [&] {
+            queue.clear();
+            queue.setPolicy(policy, 3600);
+            for (const QueueEntry& entry : entries) queue.restore(entry);
+        };
+
+        double single = bestOf(repeat, fill,
+            [&] { checksum = 0; while (!queue.isEmpty()) checksum += queue.dequeue().sequence; });
+        std::string name = "SchedulingQueue " + policyToString(policy);
+        report(name.c_str(), count, single, checksum);
+
+        std::vector<QueueEntry> out;
+        out.reserve(count);
+        double batched = bestOf(repeat, fill,
+            [&] { out.clear(); while (queue.dequeueMany(256, out) > 0) {} });
+        checksum = 0;
+        for (const QueueEntry& entry : out) checksum += entry.sequence;
+        name += " (batches of 256)";
+        report(name.c_str(), count, batched, checksum);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+/**
+ * Banc d'essai : lectures et écritures pendant une exportation ou un instantané
+ * Des clients envoient un mélange de 90 % de lectures (getById) et de 10 % d'écritures (update) au moteur,
+ * de 1 à N threads clients. Comme le pont Node, les clients partagent un seul canal : les requêtes sont
+ * servies une à une. Chaque configuration est mesurée quatre fois :
+ *  - sans traitement de fond ;
+ *  - pendant une exportation synchrone (la boucle de requêtes est bloquée jusqu'à la fin de l'écriture) ;
+ *  - pendant une exportation en arrière-plan (processus dupliqué lisant une vue figée de l'état) ;
+ *  - pendant un instantané en arrière-plan.
+ * Le débit et les latences (attente du canal comprise) sont rapportés, ainsi que la durée de l'écriture
+ * de fond.
+ *
+ * Compilation (depuis cpp-backend) :
+ *   g++ -std=c++17 -O2 -pthread -Iinclude bench/read_write_mix_bench.cpp \
+ *       $(find controllers models datastructures persistence query runtime -name '*.cpp') -o read_write_mix_bench
+ * Exécution : ./read_write_mix_bench [nombre de tâches] [requêtes par configuration] [threads maximum]
+ */
+#include "BenchSupport.h"
+#include "../controllers/TaskController.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+
+static const size_t USERS = 100;
+
+/**
+ * Exécuter une requête
+ * Retourne La réponse analysée ; lève une exception si elle signale un échec.
+ */
+static json call(TaskController& controller, const json& request) {
+    json response = json::parse(controller.handleRequest(request.dump()));
+    if (!response.value("success", false)) {
+        throw std::runtime_error(request.value("action", "?") + " failed: " + response.dump());
+    }
+    return response;
+}
+
+/**
+ * Traitement lancé au début d'une mesure
+ */
+enum BackgroundWork { NO_BACKGROUND, SYNC_EXPORT, BACKGROUND_EXPORT, BACKGROUND_SNAPSHOT };
+
+static const char* backgroundName(BackgroundWork work) {
+    switch (work) {
+        case SYNC_EXPORT: return "synchronous export";
+        case BACKGROUND_EXPORT: return "background export";
+        case BACKGROUND_SNAPSHOT: return "background snapshot";
+        default: return "idle";
+    }
+}
+
+/**
+ * Moteur partagé
+ * Le contrôleur n'est pas réentrant : un mutex sérialise les requêtes, comme le canal unique du pont Node.
+ */
+struct SharedEngine {
+    TaskController controller;
+    std::mutex channel;
+    std::string exportPath;
+    size_t taskCount = 0;
+
+    json request(const json& body) {
+        std::lock_guard<std::mutex> lock(channel);
+        return call(controller, body);
+    }
+};
+
+/**
+ * Lancer le traitement de fond
+ * L'exportation synchrone est envoyée par un thread à part : elle occupe le canal jusqu'à sa fin.
+ */
+static std::thread startBackground(SharedEngine& engine, BackgroundWork work) {
+    if (work == SYNC_EXPORT) {
+        std::atomic<bool> holding(false);
+        std::thread exporter([&engine, &holding] {
+            std::lock_guard<std::mutex> lock(engine.channel);
+            holding.store(true, std::memory_order_release);
+            call(engine.controller, {{"action", "export"}, {"data", {{"path", engine.exportPath}}}});
+        });
+        // Les clients ne partent qu'une fois le canal pris par l'exportation
+        while (!holding.load(std::memory_order_acquire)) std::this_thread::yield();
+        return exporter;
+    }
+    if (work == BACKGROUND_EXPORT) {
+        engine.request({{"action", "export"}, {"data", {{"path", engine.exportPath}, {"background", true}}}});
+    } else if (work == BACKGROUND_SNAPSHOT) {
+        engine.request({{"action", "snapshot"}});
+    }
+    return std::thread();
+}
+
+/**
+ * Attendre la fin du traitement de fond
+ * Retourne Le temps écoulé depuis 'start' jusqu'à la fin de l'écriture, en secondes.
+ */
+static double waitBackground(SharedEngine& engine, BackgroundWork work, std::thread& exporter, BenchClock::time_point start) {
+    if (exporter.joinable()) exporter.join();
+    const char* status = work == BACKGROUND_EXPORT ? "exportStatus" : work == BACKGROUND_SNAPSHOT ? "snapshotStatus" : nullptr;
+    while (status && engine.request({{"action", status}}).value("inProgress", false)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return secondsSince(start);
+}
+
+/**
+ * Mesurer une configuration
+ * Chaque client envoie sa part des requêtes : une mise à jour du titre toutes les dix requêtes, des lectures
+ * de tâches tirées au hasard sinon.
+ */
+static void measure(SharedEngine& engine, BackgroundWork work, int threads, long requests) {
+    long perThread = requests / threads;
+    std::vector<std::vector<double>> latencies(threads);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> clients;
+
+    for (int t = 0; t < threads; t++) {
+        clients.emplace_back([&, t] {
+            std::mt19937 random(1000 + t);
+            std::vector<double>& mine = latencies[t];
+            mine.reserve(perThread);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            for (long i = 0; i < perThread; i++) {
+                std::string taskId = "t" + std::to_string(random() % engine.taskCount);
+                json body = (i % 10 == 9)
+                    ? json{{"action", "update"}, {"taskId", taskId}, {"data", {{"title", "edited " + std::to_string(i)}}}}
+                    : json{{"action", "getById"}, {"taskId", taskId}};
+                auto sent = BenchClock::now();
+                engine.request(body);
+                mine.push_back(secondsSince(sent));
+            }
+        });
+    }
+
+    auto start = BenchClock::now();
+    std::thread exporter = startBackground(engine, work);
+    go.store(true, std::memory_order_release);
+    for (std::thread& client : clients) client.join();
+    double elapsed = secondsSince(start);
+    double background = waitBackground(engine, work, exporter, start);
+
+    std::vector<double> all;
+    for (const std::vector<double>& mine : latencies) all.insert(all.end(), mine.begin(), mine.end());
+    std::sort(all.begin(), all.end());
+    auto percentile = [&](double p) { return all[std::min(all.size() - 1, static_cast<size_t>(p * all.size()))] * 1000.0; };
+
+    std::printf("%-8d %-22s %10.0f req/s %9.3f %9.3f %10.3f", threads, backgroundName(work),
+                all.size() / elapsed, percentile(0.50), percentile(0.99), all.back() * 1000.0);
+    if (work == NO_BACKGROUND) std::printf("\n");
+    else std::printf("   %10.0f ms\n", background * 1000.0);
+}
+
+int main(int argc, char** argv) {
+    long count = argc > 1 ? std::atol(argv[1]) : 200000;
+    long requests = argc > 2 ? std::atol(argv[2]) : 20000;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : 8;
+    if (count <= 0 || requests <= 0 || maxThreads <= 0) {
+        std::fprintf(stderr, "usage: %s [tasks > 0] [requests > 0] [max threads > 0]\n", argv[0]);
+        return 1;
+    }
+
+    try {
+        std::string directory = makeBenchDirectory("read-write-mix-bench");
+        std::string dumpPath = directory + "tasks.ndjson";
+        writeTaskDump(dumpPath, static_cast<size_t>(count), USERS);
+
+        SharedEngine engine;
+        engine.exportPath = directory + "export.ndjson";
+        engine.taskCount = static_cast<size_t>(count);
+        engine.controller.openSnapshots(directory + "tasks.snapshot", 0);
+        engine.controller.importTasks(json{{"path", dumpPath}}.dump());
+
+        std::printf("90/10 getById/update mix, %ld tasks, %ld requests per run, %u hardware threads\n\n",
+                    count, requests, std::thread::hardware_concurrency());
+        std::printf("%-8s %-22s %16s %9s %9s %10s   %13s\n", "threads", "background", "throughput",
+                    "p50 ms", "p99 ms", "max ms", "background");
+
+        const BackgroundWork works[] = { NO_BACKGROUND, SYNC_EXPORT, BACKGROUND_EXPORT, BACKGROUND_SNAPSHOT };
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            for (BackgroundWork work : works) measure(engine, work, threads, requests);
+        }
+
+        std::filesystem::remove_all(directory);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
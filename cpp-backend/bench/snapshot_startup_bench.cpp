@@ -0,0 +1,132 @@
+/**
+ * Banc d'essai : temps de démarrage du moteur
+ * Compare, pour un même magasin de tâches, les trois façons de reconstruire l'état au démarrage :
+ *  - importation du vidage NDJSON (ce que fait le serveur Node sans persistance côté moteur) ;
+ *  - rejeu complet du journal d'écriture anticipée ;
+ *  - chargement de l'instantané projeté en mémoire (--snapshot).
+ * Le temps mesuré va de la construction du contrôleur à la réponse à une première requête (liste des tâches
+ * d'un utilisateur), chaque mode étant exécuté plusieurs fois sur un contrôleur neuf.
+ *
+ * Compilation (depuis cpp-backend) :
+ *   g++ -std=c++17 -O2 -pthread -Iinclude bench/snapshot_startup_bench.cpp \
+ *       $(find controllers models datastructures persistence query runtime -name '*.cpp') -o snapshot_startup_bench
+ * Exécution : ./snapshot_startup_bench [nombre de tâches] [répétitions]
+ */
+#include "BenchSupport.h"
+#include "../controllers/TaskController.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+using json = nlohmann::json;
+
+static const size_t USERS = 100;
+
+/**
+ * Exécuter une requête
+ * Retourne La réponse analysée ; lève une exception si elle signale un échec.
+ */
+static json call(TaskController& controller, const json& request) {
+    json response = json::parse(controller.handleRequest(request.dump()));
+    if (!response.value("success", false)) {
+        throw std::runtime_error(request.value("action", "?") + " failed: " + response.dump());
+    }
+    return response;
+}
+
+/**
+ * Nombre total de tâches chargées
+ */
+static size_t totalTasks(TaskController& controller) {
+    return call(controller, {{"action", "stats"}, {"userId", "user0"}})["totalTasks"].get<size_t>();
+}
+
+/**
+ * Mesurer un mode de démarrage
+ * Construit un contrôleur neuf, exécute 'load' puis une première requête, et garde le meilleur temps.
+ * La destruction du contrôleur n'est pas chronométrée.
+ */
+static void measure(const char* name, int repeat, size_t expected, const std::function<void(TaskController&)>& load) {
+    double best = 1e30;
+    double bestFirstQuery = 0;
+    for (int r = 0; r < repeat; r++) {
+        TaskController controller;
+        auto start = BenchClock::now();
+        load(controller);
+        double loaded = secondsSince(start);
+        call(controller, {{"action", "getAll"}, {"userId", "user1"}, {"fields", {"id", "title"}}});
+        double total = secondsSince(start);
+
+        if (totalTasks(controller) != expected) {
+            throw std::runtime_error(std::string(name) + ": loaded " + std::to_string(totalTasks(controller)) + " tasks");
+        }
+        if (total < best) {
+            best = total;
+            bestFirstQuery = total - loaded;
+        }
+    }
+    std::printf("%-28s %10.1f ms %14.0f tasks/s   (first query %.2f ms)\n",
+                name, best * 1000.0, expected / best, bestFirstQuery * 1000.0);
+}
+
+int main(int argc, char** argv) {
+    long count = argc > 1 ? std::atol(argv[1]) : 200000;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    if (count <= 0 || repeat <= 0) {
+        std::fprintf(stderr, "usage: %s [tasks > 0] [repeat > 0]\n", argv[0]);
+        return 1;
+    }
+
+    try {
+        std::string directory = makeBenchDirectory("snapshot-startup-bench");
+        std::string dumpPath = directory + "tasks.ndjson";
+        std::string walPath = directory + "tasks.wal";
+        std::string snapshotPath = directory + "tasks.snapshot";
+        json importRequest = {{"path", dumpPath}};
+
+        writeTaskDump(dumpPath, static_cast<size_t>(count), USERS);
+
+        // Journal complet : chaque tâche importée y est un enregistrement TASK_PUT
+        {
+            TaskController controller;
+            controller.openWriteAheadLog(walPath, FSYNC_OFF, 0);
+            controller.importTasks(importRequest.dump());
+        }
+
+        // Instantané du même état, écrit en arrière-plan puis attendu
+        {
+            TaskController controller;
+            controller.openSnapshots(snapshotPath, 0);
+            controller.importTasks(importRequest.dump());
+            call(controller, {{"action", "snapshot"}});
+            while (call(controller, {{"action", "snapshotStatus"}}).value("inProgress", false)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        std::printf("Startup time, %ld tasks across %zu users, best of %d, %u hardware threads\n",
+                    count, USERS, repeat, std::thread::hardware_concurrency());
+        std::printf("NDJSON dump %.1f MB, write-ahead log %.1f MB, snapshot %.1f MB\n\n",
+                    std::filesystem::file_size(dumpPath) / 1e6, std::filesystem::file_size(walPath) / 1e6,
+                    std::filesystem::file_size(snapshotPath) / 1e6);
+
+        size_t expected = static_cast<size_t>(count);
+        measure("NDJSON import", repeat, expected, [&](TaskController& controller) {
+            controller.importTasks(importRequest.dump());
+        });
+        measure("write-ahead log replay", repeat, expected, [&](TaskController& controller) {
+            controller.openWriteAheadLog(walPath, FSYNC_OFF, 0);
+        });
+        measure("snapshot load (mmap)", repeat, expected, [&](TaskController& controller) {
+            controller.openSnapshots(snapshotPath, 0);
+        });
+
+        std::filesystem::remove_all(directory);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
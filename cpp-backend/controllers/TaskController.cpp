@@ -1,10 +1,81 @@
 #include "TaskController.h"
+#include "../persistence/BinaryCodec.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <limits>
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <unordered_set>
 
 using json = nlohmann::json;
 
+/**
+ * Ajouter un tableau brut à une réponse
+ * Sérialise l'enveloppe de la réponse puis y ajoute un tableau d'objets JSON déjà sérialisés,
+ * sans les analyser de nouveau. Utilisé par les réponses groupées pour éviter un aller-retour
+ * parse/dump par tâche.
+ * envelope L'objet JSON de la réponse (sans le tableau).
+ * key Le nom du champ du tableau.
+ * items Les éléments du tableau, déjà sérialisés en JSON.
+ * Retourne La réponse complète sérialisée.
+ */
+static std::string dumpWithRawArray(const json& envelope, const std::string& key, const std::vector<std::string>& items) {
+    std::string out = envelope.dump();
+    out.pop_back();
+
+    out += out.size() > 1 ? ",\"" : "\"";
+    out += key;
+    out += "\":[";
+    for (size_t i = 0; i < items.size(); i++) {
+        if (i > 0) out += ',';
+        out += items[i];
+    }
+    out += "]}";
+    return out;
+}
+
+/**
+ * Construire un ETag
+ * Combine la version de la ressource et le masque de projection (deux projections différentes d'une
+ * même version n'ont pas le même ETag).
+ * version La version de la tâche ou de la liste.
+ * fields Le masque des champs sérialisés.
+ * Retourne L'ETag, sans guillemets.
+ */
+static std::string makeEtag(uint64_t version, unsigned fields) {
+    std::string etag = std::to_string(version);
+    if (fields != FIELD_ALL) etag += "-" + std::to_string(fields);
+    return etag;
+}
+
+/**
+ * Réponse "non modifié"
+ * etag L'ETag toujours valide.
+ * Retourne La réponse sérialisée, sans aucune tâche.
+ */
+static std::string notModified(const std::string& etag) {
+    json response;
+    response["success"] = true;
+    response["notModified"] = true;
+    response["etag"] = etag;
+    return response.dump();
+}
+
+/**
+ * Réponse de conflit de version
+ * currentVersion La version actuelle de la tâche.
+ * Retourne La réponse sérialisée ; rien n'a été modifié.
+ */
+static std::string versionConflict(uint64_t currentVersion) {
+    json error;
+    error["success"] = false;
+    error["error"] = "Version conflict";
+    error["conflict"] = true;
+    error["currentVersion"] = currentVersion;
+    return error.dump();
+}
+
 /**
  * Pousser l'opération d'annulation (pushUndo)
  * Ajoute une opération d'annulation au sommet de la pile 'undoStack'. 
@@ -16,6 +87,629 @@ void TaskController::pushUndo(const Operation& op) {
         undoStack.pop();
     }
     undoStack.push(op);
+
+    if (wal.isOpen()) wal.append(UNDO_PUSH, op.toJson());
+}
+
+/**
+ * Obtenir la file d'un utilisateur
+ * Recherche la file de traitement de l'utilisateur dans la table, et la crée vide (mode FIFO) si elle n'existe pas.
+ * userId L'identifiant de l'utilisateur.
+ * Retourne Une référence vers la file de l'utilisateur.
+ */
+SchedulingQueue& TaskController::getUserQueue(const std::string& userId) {
+    return userQueues[userId];
+}
+
+/**
+ * Rendre un bail
+ * Restaure le statut que la tâche avait avant d'être louée et réinsère son entrée dans la file.
+ * Si la tâche a été supprimée ou modifiée entre-temps (terminée, éditée), le bail est simplement
+ * abandonné : la tâche garde son état et ne revient pas en file.
+ * lease Le bail à rendre.
+ * Retourne true si la tâche a été remise en file.
+ */
+bool TaskController::releaseLease(const Lease& lease) {
+    Task* task = taskList.find(lease.entry.taskId);
+    if (!task || task->getStatus() != IN_PROGRESS) return false;
+    // Un bail rechargé depuis le disque n'a pas de version : seul le statut peut alors être vérifié
+    if (lease.taskVersion != 0 && task->getVersion() != lease.taskVersion) return false;
+
+    task->setStatus(lease.previousStatus);
+    getUserQueue(lease.userId).requeue(lease.entry);
+
+    taskChanged(*task);
+    logEnqueue(lease.userId, lease.entry);
+    return true;
+}
+
+/**
+ * Expirer les baux
+ * Récupère les minuteurs échus de la roue temporelle. Un minuteur est ignoré si son bail a déjà été
+ * acquitté ou rendu (annulation paresseuse) ; sinon le bail est rendu et la tâche remise en file.
+ */
+void TaskController::expireLeases() {
+    if (leaseTimers.isEmpty()) return;
+
+    std::vector<long long> expired;
+    leaseTimers.advance(std::time(nullptr), expired);
+
+    for (long long leaseId : expired) {
+        auto it = activeLeases.find(leaseId);
+        if (it == activeLeases.end()) continue;
+
+        Lease lease = it->second;
+        activeLeases.erase(it);
+        logLeaseEnd(leaseId);
+        releaseLease(lease);
+    }
+}
+
+/**
+ * Annoncer les échéances
+ * L'échéancier est avancé même sans flux ouvert, pour qu'il ne garde pas les tâches déjà échues.
+ */
+void TaskController::publishDueTasks() {
+    std::vector<std::string> due;
+    dueIndex.advance(std::time(nullptr), due);
+    if (due.empty() || !dueFeed.isOpen()) return;
+
+    std::vector<std::string> events;
+    events.reserve(due.size());
+    for (const std::string& taskId : due) {
+        Task* task = taskList.find(taskId);
+        if (!task) continue;
+
+        json event;
+        event["type"] = "task.due";
+        event["taskId"] = taskId;
+        event["userId"] = task->getUserId();
+        event["title"] = task->getTitle();
+        event["dueDate"] = task->getDueDate();
+        events.push_back(event.dump());
+    }
+    dueFeed.publishEvents(events);
+}
+
+/**
+ * Journaliser une tâche
+ * Ajoute au journal un enregistrement TASK_PUT contenant l'état complet de la tâche.
+ * task La tâche créée ou modifiée.
+ */
+void TaskController::logTask(const Task& task) {
+    if (!wal.isOpen()) return;
+
+    std::string payload;
+    BinaryWriter writer(payload);
+    encodeTask(writer, task);
+    wal.append(TASK_PUT, payload);
+}
+
+/**
+ * Journaliser une suppression
+ * Ajoute au journal un enregistrement TASK_DELETE.
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void TaskController::logTaskDelete(const std::string& taskId) {
+    if (!wal.isOpen()) return;
+
+    std::string payload;
+    BinaryWriter writer(payload);
+    writer.writeString(taskId);
+    wal.append(TASK_DELETE, payload);
+}
+
+/**
+ * Indexer une tâche
+ * Met à jour les index dérivés (statistiques, recherche, autocomplétion, tri) avec l'état courant de la tâche. Chaque index
+ * ignore les modifications qui ne le concernent pas.
+ * task La tâche insérée ou modifiée.
+ */
+void TaskController::indexTask(const Task& task) {
+    taskStats.update(task);
+    searchIndex.update(task.getId(), task.getUserId(), task.getTitle(), task.getDescription());
+    titleIndex.update(task.getId(), task.getUserId(), task.getTitle());
+    orderIndex.update(task);
+    dueIndex.update(task);
+    userTasks.update(task);
+    syncLog.touch(task.getId(), task.getUserId());
+}
+
+/**
+ * Désindexer une tâche
+ * Retire la tâche des index dérivés.
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void TaskController::unindexTask(const std::string& taskId) {
+    taskStats.erase(taskId);
+    searchIndex.erase(taskId);
+    titleIndex.erase(taskId);
+    orderIndex.erase(taskId);
+    dueIndex.erase(taskId);
+    userTasks.erase(taskId);
+    syncLog.remove(taskId);
+}
+
+/**
+ * Indexer des tâches en masse
+ * Un travail par index dérivé de indexTask ; en dessous d'un lot de PARALLEL_INDEX_MIN_TASKS tâches, le
+ * découpage coûterait plus qu'il ne rapporte et les tâches sont indexées une à une.
+ * tasks Les tâches, telles que stockées dans la liste.
+ */
+void TaskController::indexTasks(const std::vector<const Task*>& tasks) {
+    static const size_t PARALLEL_INDEX_MIN_TASKS = 4096;
+    if (tasks.size() < PARALLEL_INDEX_MIN_TASKS || getExecutor().getThreadCount() == 1) {
+        for (const Task* task : tasks) indexTask(*task);
+        return;
+    }
+
+    getExecutor().invokeAll({
+        [&] { for (const Task* task : tasks) taskStats.update(*task); },
+        [&] { for (const Task* task : tasks) searchIndex.update(task->getId(), task->getUserId(), task->getTitle(), task->getDescription()); },
+        [&] { for (const Task* task : tasks) titleIndex.update(task->getId(), task->getUserId(), task->getTitle()); },
+        [&] { for (const Task* task : tasks) orderIndex.update(*task); },
+        [&] { for (const Task* task : tasks) dueIndex.update(*task); },
+        [&] { for (const Task* task : tasks) userTasks.update(*task); },
+        [&] { for (const Task* task : tasks) syncLog.touch(task->getId(), task->getUserId()); }
+    });
+}
+
+/**
+ * Obtenir l'ordonnanceur
+ * Retourne L'ordonnanceur des traitements en masse, démarré au premier appel.
+ */
+WorkStealingExecutor& TaskController::getExecutor() {
+    if (!executor) {
+        executor.reset(new WorkStealingExecutor(executorThreads));
+    }
+    return *executor;
+}
+
+/**
+ * Enregistrer une modification
+ * Met à jour les index dérivés avec l'état courant de la tâche, puis la journalise.
+ * task La tâche créée ou modifiée.
+ */
+void TaskController::taskChanged(const Task& task) {
+    indexTask(task);
+    logTask(task);
+}
+
+/**
+ * Enregistrer une suppression
+ * Retire la tâche des index dérivés, puis journalise la suppression.
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void TaskController::taskRemoved(const std::string& taskId) {
+    unindexTask(taskId);
+    logTaskDelete(taskId);
+}
+
+/**
+ * Journaliser une mise en file
+ * Ajoute au journal un enregistrement QUEUE_ENQUEUE contenant l'entrée complète, afin qu'elle retrouve
+ * exactement sa place lors du rejeu.
+ * userId L'identifiant du propriétaire de la file.
+ * entry L'entrée ajoutée.
+ */
+void TaskController::logEnqueue(const std::string& userId, const QueueEntry& entry) {
+    if (!wal.isOpen()) return;
+
+    std::string payload;
+    BinaryWriter writer(payload);
+    writer.writeString(userId);
+    encodeQueueEntry(writer, entry);
+    wal.append(QUEUE_ENQUEUE, payload);
+}
+
+/**
+ * Journaliser un retrait de file
+ * Ajoute au journal un enregistrement QUEUE_DEQUEUE. Le contenu de la file et sa politique étant eux-mêmes
+ * journalisés, rejouer le retrait produit les mêmes entrées.
+ * userId L'identifiant du propriétaire de la file.
+ * count Le nombre d'entrées retirées.
+ */
+void TaskController::logDequeue(const std::string& userId, int count) {
+    if (!wal.isOpen() || count <= 0) return;
+
+    std::string payload;
+    BinaryWriter writer(payload);
+    writer.writeString(userId);
+    writer.writeU32(static_cast<uint32_t>(count));
+    wal.append(QUEUE_DEQUEUE, payload);
+}
+
+/**
+ * Journaliser une politique de file
+ * Ajoute au journal un enregistrement QUEUE_POLICY.
+ * userId L'identifiant du propriétaire de la file.
+ * policy La nouvelle politique.
+ * agingSeconds Le paramètre de vieillissement.
+ */
+void TaskController::logQueuePolicy(const std::string& userId, SchedulingPolicy policy, int agingSeconds) {
+    if (!wal.isOpen()) return;
+
+    std::string payload;
+    BinaryWriter writer(payload);
+    writer.writeString(userId);
+    writer.writeU8(static_cast<uint8_t>(policy));
+    writer.writeU32(static_cast<uint32_t>(agingSeconds));
+    wal.append(QUEUE_POLICY, payload);
+}
+
+/**
+ * Journaliser un bail accordé
+ * Ajoute au journal un enregistrement LEASE_GRANT contenant le bail complet.
+ * lease Le bail accordé.
+ */
+void TaskController::logLeaseGrant(const Lease& lease) {
+    if (!wal.isOpen()) return;
+
+    std::string payload;
+    BinaryWriter writer(payload);
+    encodeLease(writer, lease);
+    wal.append(LEASE_GRANT, payload);
+}
+
+/**
+ * Journaliser la fin d'un bail
+ * Ajoute au journal un enregistrement LEASE_END. Les effets de la fin du bail (statut, remise en file)
+ * sont journalisés séparément.
+ * leaseId L'identifiant du bail terminé.
+ */
+void TaskController::logLeaseEnd(long long leaseId) {
+    if (!wal.isOpen()) return;
+
+    std::string payload;
+    BinaryWriter writer(payload);
+    writer.writeI64(leaseId);
+    wal.append(LEASE_END, payload);
+}
+
+/**
+ * Appliquer un enregistrement
+ * Reproduit l'effet physique de l'enregistrement sur la liste des tâches, les files, les baux ou la pile
+ * d'annulation.
+ * record L'enregistrement relu.
+ */
+void TaskController::applyLogRecord(const LogRecord& record) {
+    BinaryReader reader(record.payload.data(), record.payload.size());
+
+    switch (record.type) {
+        case TASK_PUT:
+            upsertTask(decodeTask(reader));
+            break;
+
+        case TASK_DELETE: {
+            std::string taskId = reader.readString();
+            taskList.remove(taskId);
+            unindexTask(taskId);
+            break;
+        }
+
+        case QUEUE_ENQUEUE: {
+            std::string userId = reader.readString();
+            getUserQueue(userId).restore(decodeQueueEntry(reader));
+            break;
+        }
+
+        case QUEUE_DEQUEUE: {
+            std::string userId = reader.readString();
+            std::vector<QueueEntry> removed;
+            getUserQueue(userId).dequeueMany(static_cast<int>(reader.readU32()), removed);
+            break;
+        }
+
+        case QUEUE_POLICY: {
+            std::string userId = reader.readString();
+            SchedulingPolicy policy = static_cast<SchedulingPolicy>(reader.readU8());
+            getUserQueue(userId).setPolicy(policy, static_cast<int>(reader.readU32()));
+            break;
+        }
+
+        case LEASE_GRANT: {
+            Lease lease = decodeLease(reader);
+            activeLeases[lease.leaseId] = lease;
+            leaseTimers.schedule(lease.leaseId, lease.expiresAt);
+            if (lease.leaseId >= nextLeaseId) nextLeaseId = lease.leaseId + 1;
+            break;
+        }
+
+        case LEASE_END:
+            activeLeases.erase(reader.readI64());
+            break;
+
+        case UNDO_PUSH:
+            if (!undoStack.isEmpty()) undoStack.pop();
+            undoStack.push(Operation::fromJson(record.payload));
+            break;
+
+        case UNDO_POP:
+            if (!undoStack.isEmpty()) undoStack.pop();
+            break;
+
+        case CHECKPOINT:
+            break;
+    }
+}
+
+/**
+ * Insérer ou remplacer une tâche
+ * Place la tâche puis met à jour les index dérivés.
+ * task La tâche à insérer.
+ * Retourne true si la tâche a été insérée, false si elle en a remplacé une existante.
+ */
+bool TaskController::upsertTask(Task* task) {
+    bool inserted = false;
+    indexTask(*placeTask(task, inserted));
+    return inserted;
+}
+
+/**
+ * Placer une tâche
+ * Une tâche déjà présente est mise à jour sur place (en conservant son lien 'next') pour garder sa
+ * position dans la liste.
+ * task La tâche à insérer.
+ * inserted Reçoit true si la tâche a été insérée, false si elle en a remplacé une existante.
+ * Retourne La tâche stockée dans la liste.
+ */
+Task* TaskController::placeTask(Task* task, bool& inserted) {
+    Task* existing = taskList.find(task->getId());
+    if (!existing) {
+        taskList.insert(task);
+        inserted = true;
+        return task;
+    }
+
+    Task* link = existing->next;
+    *existing = *task;
+    existing->next = link;
+    delete task;
+    inserted = false;
+    return existing;
+}
+
+/**
+ * Ouvrir le journal d'écriture anticipée
+ * Rejoue chaque enregistrement valide du journal sur le contrôleur vide, puis active la journalisation.
+ * Les baux rejoués dont l'échéance est passée seront remis en file à la première requête.
+ * path Le chemin du fichier du journal.
+ * policy La politique de synchronisation sur disque.
+ * intervalMs L'intervalle de synchronisation en millisecondes (FSYNC_INTERVAL).
+ */
+void TaskController::openWriteAheadLog(const std::string& path, FsyncPolicy policy, int intervalMs) {
+    wal.open(path, policy, intervalMs, [this](const LogRecord& record) {
+        applyLogRecord(record);
+    }, lastSnapshotLsn);
+}
+
+/**
+ * Ouvrir le flux de changements
+ * Les événements sont publiés par le journal à chaque validation, après l'écriture sur disque : un
+ * consommateur ne voit jamais une mutation qui pourrait être perdue.
+ * target Un chemin de fichier ou "fd:N".
+ */
+void TaskController::openChangeFeed(const std::string& target) {
+    if (!wal.isOpen()) {
+        throw std::runtime_error("The change feed requires the write-ahead log");
+    }
+    changeFeed.open(target);
+    wal.setCommitListener([this](const std::vector<LogRecord>& records) {
+        changeFeed.publish(records);
+    });
+}
+
+/**
+ * Ouvrir le flux des échéances
+ * target Un chemin de fichier ou "fd:N".
+ */
+void TaskController::openDueFeed(const std::string& target) {
+    dueFeed.open(target);
+}
+
+/**
+ * Destructeur
+ * Attend la fin de l'instantané et de l'exportation en cours pour ne pas laisser de processus enfant orphelin.
+ */
+TaskController::~TaskController() {
+    snapshotWriter.wait();
+    exportWriter.wait();
+}
+
+/**
+ * Encoder l'état
+ * Format du corps : tâches (dans l'ordre de la liste), pile d'annulation (du fond vers le sommet),
+ * files par utilisateur (politique, numéro d'ordre suivant, entrées dans l'ordre de sortie), puis baux.
+ * Les index (table des identifiants, tas des files) ne sont pas stockés : ils sont reconstruits au chargement.
+ * writer L'écrivain de destination.
+ */
+void TaskController::encodeSnapshot(BinaryWriter& writer) {
+    std::vector<Task*> tasks = taskList.getAll();
+    writer.writeU64(tasks.size());
+    for (Task* task : tasks) {
+        encodeTask(writer, *task);
+    }
+
+    std::vector<Operation> operations = undoStack.toVector();
+    writer.writeU32(static_cast<uint32_t>(operations.size()));
+    for (const Operation& op : operations) {
+        writer.writeString(op.toJson());
+    }
+
+    writer.writeU32(static_cast<uint32_t>(userQueues.size()));
+    for (const auto& pair : userQueues) {
+        const SchedulingQueue& queue = pair.second;
+        writer.writeString(pair.first);
+        writer.writeU8(static_cast<uint8_t>(queue.getPolicy()));
+        writer.writeU32(static_cast<uint32_t>(queue.getAgingSeconds()));
+        writer.writeI64(queue.getNextSequence());
+        writer.writeU32(static_cast<uint32_t>(queue.getSize()));
+        queue.forEachInOrder([&writer](const QueueEntry& entry) {
+            encodeQueueEntry(writer, entry);
+            return true;
+        });
+    }
+
+    writer.writeU32(static_cast<uint32_t>(activeLeases.size()));
+    for (const auto& pair : activeLeases) {
+        encodeLease(writer, pair.second);
+    }
+    writer.writeI64(nextLeaseId);
+}
+
+/**
+ * Décoder l'état
+ * Lit le corps dans l'ordre d'encodage. Les tâches sont insérées en fin de liste (O(1)) avec un index
+ * pré-dimensionné, puis les index dérivés sont reconstruits en parallèle ; la politique de chaque file
+ * est fixée avant ses entrées.
+ * reader Le lecteur source.
+ * withCompletedAt Faux pour un instantané antérieur à la date d'achèvement des tâches.
+ */
+void TaskController::decodeSnapshot(BinaryReader& reader, bool withCompletedAt) {
+    uint64_t taskCount = reader.readU64();
+    taskList.reserve(static_cast<size_t>(taskCount));
+    std::vector<const Task*> tasks;
+    tasks.reserve(static_cast<size_t>(taskCount));
+    for (uint64_t i = 0; i < taskCount; i++) {
+        Task* task = decodeTask(reader, withCompletedAt);
+        taskList.insert(task);
+        tasks.push_back(task);
+    }
+    indexTasks(tasks);
+
+    uint32_t operationCount = reader.readU32();
+    for (uint32_t i = 0; i < operationCount; i++) {
+        undoStack.push(Operation::fromJson(reader.readString()));
+    }
+
+    uint32_t queueCount = reader.readU32();
+    for (uint32_t i = 0; i < queueCount; i++) {
+        SchedulingQueue& queue = getUserQueue(reader.readString());
+        SchedulingPolicy policy = static_cast<SchedulingPolicy>(reader.readU8());
+        queue.setPolicy(policy, static_cast<int>(reader.readU32()));
+        queue.setNextSequence(reader.readI64());
+
+        uint32_t entryCount = reader.readU32();
+        for (uint32_t j = 0; j < entryCount; j++) {
+            queue.restore(decodeQueueEntry(reader));
+        }
+    }
+
+    uint32_t leaseCount = reader.readU32();
+    for (uint32_t i = 0; i < leaseCount; i++) {
+        Lease lease = decodeLease(reader);
+        activeLeases[lease.leaseId] = lease;
+        leaseTimers.schedule(lease.leaseId, lease.expiresAt);
+    }
+    nextLeaseId = reader.readI64();
+}
+
+/**
+ * Ouvrir les instantanés
+ * Projette l'instantané avec mmap, vérifie son en-tête et sa somme de contrôle, puis décode le corps
+ * directement depuis la projection, sans le copier.
+ * path Le chemin du fichier d'instantané.
+ * intervalSeconds La période des instantanés automatiques en secondes (0 pour les désactiver).
+ */
+void TaskController::openSnapshots(const std::string& path, int intervalSeconds) {
+    MappedFile file;
+    if (file.open(path)) {
+        SnapshotHeader header = readSnapshotHeader(file);
+        BinaryReader reader(file.getData() + SNAPSHOT_HEADER_SIZE, static_cast<size_t>(header.bodySize));
+        decodeSnapshot(reader, header.version >= SNAPSHOT_VERSION_COMPLETED_AT);
+        lastSnapshotLsn = header.lsn;
+    }
+
+    snapshotPath = path;
+    snapshotIntervalSeconds = intervalSeconds > 0 ? intervalSeconds : 0;
+    lastSnapshotAt = time(nullptr);
+}
+
+/**
+ * Configurer les points de contrôle
+ * walBytes La taille du segment actif au-delà de laquelle un point de contrôle est déclenché (0 pour aucune).
+ * maxBytesPerSecond Le débit d'écriture maximal de l'instantané (0 pour aucune limite).
+ */
+void TaskController::setCheckpointPolicy(uint64_t walBytes, uint64_t maxBytesPerSecond) {
+    checkpointBytes = walBytes;
+    checkpointBytesPerSecond = maxBytesPerSecond;
+}
+
+/**
+ * Configurer le parallélisme
+ * threads Le nombre de threads des traitements en masse (0 pour le nombre de cœurs).
+ */
+void TaskController::setThreadCount(size_t threads) {
+    executorThreads = threads;
+}
+
+/**
+ * Démarrer un instantané (point de contrôle)
+ * Le segment actif est d'abord scellé : il contient alors exactement les enregistrements couverts par
+ * l'instantané (jusqu'au dernier LSN attribué, l'état en mémoire les reflétant déjà tous), et pourra être
+ * supprimé dès que l'instantané sera durable.
+ */
+void TaskController::startSnapshot() {
+    uint64_t lsn = wal.isOpen() ? wal.rotate() : 0;
+    snapshotWriter.start(snapshotPath, lsn, [this](BinaryWriter& writer) {
+        encodeSnapshot(writer);
+    }, checkpointBytesPerSecond);
+    lastSnapshotAt = time(nullptr);
+}
+
+/**
+ * Suivre les instantanés
+ * Appelée au début de chaque requête. Lorsqu'un instantané se termine, son LSN est enregistré dans le
+ * journal (CHECKPOINT) et les segments scellés qu'il couvre sont supprimés ; en cas d'échec ils sont
+ * conservés et seront couverts par le point de contrôle suivant. Un point de contrôle n'est démarré que si
+ * l'état a changé depuis le dernier instantané (LSN différent) ou si le journal est désactivé, et jamais
+ * pendant qu'un autre est en cours, ce qui limite leur fréquence.
+ */
+void TaskController::pollSnapshots() {
+    bool succeeded = false;
+    uint64_t finishedLsn = 0;
+    if (snapshotWriter.poll(succeeded, finishedLsn)) {
+        if (succeeded) {
+            lastSnapshotLsn = finishedLsn;
+            if (wal.isOpen()) {
+                std::string payload;
+                BinaryWriter writer(payload);
+                writer.writeU64(finishedLsn);
+                lastCheckpointRecordLsn = wal.append(CHECKPOINT, payload);
+                wal.removeSegmentsUpTo(finishedLsn);
+            }
+        } else {
+            std::cerr << "Snapshot failed" << std::endl;
+        }
+    }
+
+    if (snapshotPath.empty() || snapshotWriter.isRunning()) return;
+    if (wal.isOpen() && (wal.getLastLsn() == lastSnapshotLsn || wal.getLastLsn() == lastCheckpointRecordLsn)) return;
+
+    bool periodic = snapshotIntervalSeconds > 0 && time(nullptr) - lastSnapshotAt >= snapshotIntervalSeconds;
+    bool logTooLarge = checkpointBytes > 0 && wal.isOpen() && wal.getActiveSize() >= checkpointBytes;
+    if (!periodic && !logTooLarge) return;
+
+    try {
+        startSnapshot();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        lastSnapshotAt = time(nullptr);
+    }
+}
+
+/**
+ * Suivre les exportations
+ * Appelée au début de chaque requête : le bilan de l'exportation terminée est conservé pour getExportStatus.
+ */
+void TaskController::pollExports() {
+    ExportReport report;
+    if (exportWriter.poll(report)) {
+        if (!report.succeeded) {
+            std::cerr << "Export failed: " << report.error << std::endl;
+        }
+        lastExport = report;
+    }
 }
 
 
@@ -23,7 +717,7 @@ void TaskController::pushUndo(const Operation& op) {
  * Créer une tâche
  * Traite une requête JSON pour créer une nouvelle tâche, l'insère dans la liste chaînée et gère la réponse.
  * jsonData Chaîne JSON contenant les détails de la nouvelle tâche.
- * Retourne Une chaîne JSON indiquant le succès ou l'échec de l'opération.
+ * Retourne Une chaîne JSON indiquant le succès ou l'échec de l'opération (échec si l'identifiant existe déjà).
  */
 std::string TaskController::createTask(const std::string& jsonData) {
     try {
@@ -33,10 +727,19 @@ std::string TaskController::createTask(const std::string& jsonData) {
         std::string userId = input["userId"].get<std::string>();
         int priorityValue = input.value("priority", 2);
 
+        // Un doublon masquerait la tâche existante dans l'index de la liste, et le rejeu du journal
+        // (qui remplace) ne reproduirait pas cet état
+        if (taskList.find(taskId)) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Task already exists";
+            return error.dump();
+        }
+
         Task* newTask = new Task(
             taskId,
             input["title"].get<std::string>(),
-            input.value("description", ""),
+            input.value("description", input.value("Description", "")),
             static_cast<Priority>(priorityValue),
             userId
         );
@@ -44,8 +747,12 @@ std::string TaskController::createTask(const std::string& jsonData) {
         if (input.contains("dueDate") && !input["dueDate"].is_null()) {
             newTask->setDueDate(input["dueDate"].get<time_t>());
         }
+        if (input.contains("status") && !input["status"].is_null()) {
+            newTask->setStatus(static_cast<Status>(input["status"].get<int>()));
+        }
 
         taskList.insert(newTask);
+        taskChanged(*newTask);
 
         json response;
         response["success"] = true;
@@ -64,24 +771,35 @@ std::string TaskController::createTask(const std::string& jsonData) {
 
 /**
  * Obtenir toutes les tâches pour un utilisateur
- * Récupère toutes les tâches associées à un ID utilisateur spécifique en utilisant la liste chaînée.
+ * Récupère les tâches de l'utilisateur à partir d'une vue (O(1)) de sa collection persistante, sans parcourir la liste.
  * userId L'identifiant de l'utilisateur.
- * Retourne Une chaîne JSON contenant la liste des tâches ou un message d'erreur.
+ * L'ETag de la liste est la version de synchronisation de l'utilisateur : toute création, modification ou
+ * suppression d'une de ses tâches le change. S'il correspond à "ifNoneMatch", rien n'est lu ni sérialisé.
+ * fields Masque des champs à sérialiser pour chaque tâche.
+ * ifNoneMatch L'ETag déjà détenu par le client (vide si aucun).
+ * Retourne Une chaîne JSON contenant la liste des tâches, la version à passer ensuite à "changesSince" et
+ * l'ETag, ou "notModified", ou un message d'erreur.
  */
-std::string TaskController::getTasks(const std::string& userId) {
+std::string TaskController::getTasks(const std::string& userId, unsigned fields, const std::string& ifNoneMatch) {
     try {
-        std::vector<Task*> tasks = taskList.getByUserId(userId);
+        uint64_t version = syncLog.getVersion(userId);
+        std::string etag = makeEtag(version, fields);
+        if (!ifNoneMatch.empty() && ifNoneMatch == etag) return notModified(etag);
+
+        PersistentTaskVector tasks = userTasks.snapshot(userId);
+
+        std::vector<std::string> items;
+        items.reserve(tasks.size());
+        tasks.forEach([&](const Task& task) {
+            items.push_back(task.toJson(fields));
+        });
 
         json response;
         response["success"] = true;
         response["count"] = tasks.size();
-        response["data"] = json::array();
-
-        for (Task* task : tasks) {
-            response["data"].push_back(json::parse(task->toJson()));
-        }
-
-        return response.dump();
+        response["version"] = version;
+        response["etag"] = etag;
+        return dumpWithRawArray(response, "data", items);
 
     } catch (const std::exception& e) {
         json error;
@@ -95,9 +813,13 @@ std::string TaskController::getTasks(const std::string& userId) {
  * Obtenir une seule tâche par ID
  * Recherche une tâche spécifique dans la liste chaînée par son ID.
  * taskId L'identifiant de la tâche à récupérer.
- * Retourne Une chaîne JSON contenant la tâche ou un message d'erreur si elle n'est pas trouvée.
+ * L'ETag est la version de la tâche, renouvelée par chacun de ses mutateurs.
+ * fields Masque des champs à sérialiser.
+ * ifNoneMatch L'ETag déjà détenu par le client (vide si aucun).
+ * Retourne Une chaîne JSON contenant la tâche et son ETag, "notModified", ou un message d'erreur si elle
+ * n'est pas trouvée.
  */
-std::string TaskController::getTask(const std::string& taskId) {
+std::string TaskController::getTask(const std::string& taskId, unsigned fields, const std::string& ifNoneMatch) {
     try {
         Task* task = taskList.find(taskId);
 
@@ -108,9 +830,13 @@ std::string TaskController::getTask(const std::string& taskId) {
             return error.dump();
         }
 
+        std::string etag = makeEtag(task->getVersion(), fields);
+        if (!ifNoneMatch.empty() && ifNoneMatch == etag) return notModified(etag);
+
         json response;
         response["success"] = true;
-        response["data"] = json::parse(task->toJson());
+        response["etag"] = etag;
+        response["data"] = json::parse(task->toJson(fields));
 
         return response.dump();
 
@@ -126,10 +852,14 @@ std::string TaskController::getTask(const std::string& taskId) {
  * Mettre à jour une tâche
  * Met à jour les propriétés d'une tâche existante à partir des données JSON. L'état précédent est sauvegardé pour l'annulation.
  * taskId L'identifiant de la tâche à modifier.
+ * Avec une version attendue, la mise à jour est une comparaison-échange : les requêtes étant traitées une à
+ * une, la vérification et l'écriture sont atomiques, et un écrivain concurrent qui a lu une version
+ * dépassée échoue aussitôt au lieu d'écraser la modification de l'autre.
  * jsonData Chaîne JSON contenant les champs de la tâche à mettre à jour.
- * Retourne Une chaîne JSON indiquant le succès ou l'échec.
+ * expectedVersion La version attendue de la tâche (0 pour une mise à jour inconditionnelle).
+ * Retourne Une chaîne JSON indiquant le succès (avec la nouvelle version dans "data"), un conflit ou l'échec.
  */
-std::string TaskController::editTask(const std::string& taskId, const std::string& jsonData) {
+std::string TaskController::editTask(const std::string& taskId, const std::string& jsonData, uint64_t expectedVersion) {
     try {
         Task* task = taskList.find(taskId);
         if (!task) {
@@ -138,6 +868,9 @@ std::string TaskController::editTask(const std::string& taskId, const std::strin
             error["error"] = "Task not found";
             return error.dump();
         }
+        if (expectedVersion != 0 && task->getVersion() != expectedVersion) {
+            return versionConflict(task->getVersion());
+        }
 
         std::string prevState = task->toJson();
 
@@ -162,6 +895,8 @@ std::string TaskController::editTask(const std::string& taskId, const std::strin
         if (input.contains("dueDate") && !input["dueDate"].is_null())
             task->setDueDate(input["dueDate"].get<time_t>());
 
+        taskChanged(*task);
+
         json response;
         response["success"] = true;
         response["message"] = "Task updated successfully";
@@ -181,9 +916,10 @@ std::string TaskController::editTask(const std::string& taskId, const std::strin
  * Supprimer une tâche
  * Recherche une tâche par ID, la sauvegarde pour l'annulation (Undo) et la retire de la liste chaînée.
  * taskId L'identifiant de la tâche à supprimer.
- * Retourne Une chaîne JSON indiquant le succès ou l'échec de la suppression.
+ * expectedVersion La version attendue de la tâche (0 pour une suppression inconditionnelle).
+ * Retourne Une chaîne JSON indiquant le succès, un conflit de version ou l'échec de la suppression.
  */
-std::string TaskController::deleteTask(const std::string& taskId) {
+std::string TaskController::deleteTask(const std::string& taskId, uint64_t expectedVersion) {
     try {
         Task* task = taskList.find(taskId);
         if (!task) {
@@ -192,8 +928,12 @@ std::string TaskController::deleteTask(const std::string& taskId) {
             error["error"] = "Task not found";
             return error.dump();
         }
+        if (expectedVersion != 0 && task->getVersion() != expectedVersion) {
+            return versionConflict(task->getVersion());
+        }
 
         bool removed = taskList.remove(taskId);
+        if (removed) taskRemoved(taskId);
 
         json response;
         response["success"] = removed;
@@ -209,6 +949,43 @@ std::string TaskController::deleteTask(const std::string& taskId) {
     }
 }
 
+/**
+ * Supprimer toutes les tâches d'un utilisateur
+ * Les identifiants sont relevés sur une vue figée de ses tâches, puis chaque tâche passe par le même
+ * chemin qu'une suppression unitaire : les index, les statistiques et la version de l'utilisateur (donc
+ * son ETag) restent cohérents, et le rejeu du journal reproduit les suppressions.
+ * userId L'identifiant de l'utilisateur.
+ * Retourne Une chaîne JSON avec le nombre de tâches supprimées ("deletedCount").
+ */
+std::string TaskController::clearTasks(const std::string& userId) {
+    try {
+        std::vector<std::string> taskIds;
+        userTasks.snapshot(userId).forEach([&taskIds](const Task& task) {
+            taskIds.push_back(task.getId());
+        });
+
+        size_t deleted = 0;
+        for (const std::string& taskId : taskIds) {
+            if (taskList.remove(taskId)) {
+                taskRemoved(taskId);
+                deleted++;
+            }
+        }
+
+        json response;
+        response["success"] = true;
+        response["deletedCount"] = deleted;
+        response["message"] = "All tasks cleared";
+        return response.dump();
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Clear tasks error: ") + e.what();
+        return error.dump();
+    }
+}
+
 /**
  * Annuler la dernière opération
  * Retire la dernière opération de la pile 'undoStack' et applique l'action inverse (créer/supprimer/restaurer l'état).
@@ -227,9 +1004,11 @@ std::string TaskController::undoLastOperation(const std::string& userId) {
         Operation op = undoStack.pop();
         Task* task;
 
+        if (wal.isOpen()) wal.append(UNDO_POP, "");
+
         switch (op.type) {
             case CREATE:
-                taskList.remove(op.taskId);
+                if (taskList.remove(op.taskId)) taskRemoved(op.taskId);
                 break;
 
             case DELETE_OP: {
@@ -250,14 +1029,16 @@ std::string TaskController::undoLastOperation(const std::string& userId) {
                     for (auto& t : j["tags"]) tags.push_back(t.get<std::string>());
                     task->setTags(tags);
                 }
+                if (j.contains("completedAt")) task->setCompletedAt(j["completedAt"].get<time_t>());
                 taskList.insert(task);
+                taskChanged(*task);
                 break;
             }
 
             case UPDATE: {
                 json j = json::parse(op.previousState);
                 
-                taskList.remove(op.taskId);
+                if (taskList.remove(op.taskId)) taskRemoved(op.taskId);
                 
                 task = new Task(
                     j["id"].get<std::string>(),
@@ -274,7 +1055,9 @@ std::string TaskController::undoLastOperation(const std::string& userId) {
                     for (auto& t : j["tags"]) tags.push_back(t.get<std::string>());
                     task->setTags(tags);
                 }
+                if (j.contains("completedAt")) task->setCompletedAt(j["completedAt"].get<time_t>());
                 taskList.insert(task);
+                taskChanged(*task);
                 break;
             }
         }
@@ -325,7 +1108,8 @@ std::string TaskController::getUndoHistory(const std::string& userId) {
 
 /**
  * Ajouter une tâche à la file de traitement
- * Recherche une tâche par ID et l'ajoute à la file de traitement (`processingQueue`), si son statut le permet.
+ * Recherche une tâche par ID et l'ajoute à la file de traitement de son propriétaire, si son statut le permet
+ * et si elle n'y est pas déjà.
  * taskId L'identifiant de la tâche à mettre en file.
  * Retourne Une chaîne JSON indiquant le succès et la taille actuelle de la file.
  */
@@ -347,12 +1131,19 @@ std::string TaskController::addToQueue(const std::string& taskId) {
             return error.dump();
         }
 
-        processingQueue.enqueue(taskId);
+        SchedulingQueue& queue = getUserQueue(task->getUserId());
+        if (queue.containsTask(taskId)) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Task is already in the queue";
+            return error.dump();
+        }
+        logEnqueue(task->getUserId(), queue.enqueue(*task));
         
         json response;
         response["success"] = true;
         response["message"] = "Task added to processing queue";
-        response["queueSize"] = processingQueue.getSize();
+        response["queueSize"] = queue.getSize();
         
         return response.dump();
         
@@ -366,20 +1157,23 @@ std::string TaskController::addToQueue(const std::string& taskId) {
 
 /**
  * Traiter la prochaine tâche
- * Retire la tâche la plus ancienne de la file (`processingQueue.dequeue()`) et met à jour son statut à IN_PROGRESS.
+ * Retire la prochaine tâche de la file de l'utilisateur selon sa politique d'ordonnancement et met à jour son statut à IN_PROGRESS.
  * userId L'identifiant de l'utilisateur.
  * Retourne Une chaîne JSON avec les détails de la tâche démarrée ou un message d'erreur.
  */
 std::string TaskController::processNextTask(const std::string& userId) {
     try {
-        if (processingQueue.isEmpty()) {
+        SchedulingQueue& queue = getUserQueue(userId);
+
+        if (queue.isEmpty()) {
             json error;
             error["success"] = false;
             error["error"] = "Processing queue is empty";
             return error.dump();
         }
 
-        std::string taskId = processingQueue.dequeue();
+        std::string taskId = queue.dequeue().taskId;
+        logDequeue(userId, 1);
         Task* task = taskList.find(taskId);
         
         if (!task) {
@@ -389,20 +1183,14 @@ std::string TaskController::processNextTask(const std::string& userId) {
             return error.dump();
         }
 
-        if (task->getUserId() != userId) {
-            json error;
-            error["success"] = false;
-            error["error"] = "Task does not belong to this user";
-            return error.dump();
-        }
-
         task->setStatus(IN_PROGRESS);
+        taskChanged(*task);
         
         json response;
         response["success"] = true;
         response["message"] = "Started working on task";
         response["task"] = json::parse(task->toJson());
-        response["remainingInQueue"] = processingQueue.getSize();
+        response["remainingInQueue"] = queue.getSize();
         
         return response.dump();
         
@@ -416,18 +1204,92 @@ std::string TaskController::processNextTask(const std::string& userId) {
 
 /**
  * Voir la file de traitement
- * Retourne l'état actuel de la file de traitement (taille et si elle est vide).
+ * Parcourt la file dans son ordre de sortie (selon la politique courante) sans la copier et retourne une page
+ * d'entrées avec leur position et le détail de la tâche. La page commence après l'entrée désignée par
+ * "cursor" (renvoyé comme "nextCursor" par la page précédente), ou à "offset" si aucun curseur n'est fourni.
+ * En mode FIFO, le curseur est retrouvé sans parcourir les entrées qui le précèdent. Si l'entrée du curseur
+ * a quitté la file entre-temps, la requête échoue avec "staleCursor" : le client repart de l'avant.
  * userId L'identifiant de l'utilisateur.
- * Retourne Une chaîne JSON avec les informations sur la file.
+ * jsonData Chaîne JSON contenant optionnellement "offset", "limit" et "cursor".
+ * Retourne Une chaîne JSON avec la taille de la file, la page demandée et le curseur de la page suivante.
  */
-std::string TaskController::viewQueue(const std::string& userId) {
+std::string TaskController::viewQueue(const std::string& userId, const std::string& jsonData) {
     try {
+        json input = json::parse(jsonData);
+        int offset = input.value("offset", 0);
+        int limit = input.value("limit", DEFAULT_PAGE_SIZE);
+        std::string cursor = input.value("cursor", "");
+
+        if (offset < 0 || limit <= 0) {
+            json error;
+            error["success"] = false;
+            error["error"] = "offset must be >= 0 and limit must be positive";
+            return error.dump();
+        }
+
+        SchedulingQueue& queue = getUserQueue(userId);
+
+        std::vector<const QueueEntry*> page;
+        bool hasMore = false;
+        auto collect = [&](const QueueEntry& entry) {
+            if (static_cast<int>(page.size()) == limit) {
+                hasMore = true;
+                return false;
+            }
+            page.push_back(&entry);
+            return true;
+        };
+
+        int startPosition = offset;
+
+        if (!cursor.empty()) {
+            startPosition = queue.forEachAfter(std::stoll(cursor), collect);
+            if (startPosition < 0) {
+                json error;
+                error["success"] = false;
+                error["error"] = "Cursor is no longer in the queue";
+                error["staleCursor"] = true;
+                return error.dump();
+            }
+        } else {
+            int position = 0;
+            queue.forEachInOrder([&](const QueueEntry& entry) {
+                if (position++ < startPosition) return true;
+                return collect(entry);
+            });
+        }
+
+        std::vector<std::string> taskIds;
+        taskIds.reserve(page.size());
+        for (const QueueEntry* entry : page)
+            taskIds.push_back(entry->taskId);
+
+        std::vector<Task*> tasks = taskList.findMany(taskIds);
+        std::vector<std::string> items;
+        items.reserve(page.size());
+
+        for (size_t i = 0; i < page.size(); i++) {
+            std::string item = "{\"position\":" + std::to_string(startPosition + i + 1);
+            item += ",\"taskId\":" + json(page[i]->taskId).dump();
+            item += ",\"enqueuedAt\":" + std::to_string(page[i]->enqueuedAt);
+            item += ",\"task\":" + (tasks[i] ? tasks[i]->toJson() : std::string("null"));
+            item += "}";
+            items.push_back(item);
+        }
+
         json response;
         response["success"] = true;
-        response["queueSize"] = processingQueue.getSize();
-        response["isEmpty"] = processingQueue.isEmpty();
-        
-        return response.dump();
+        response["queueSize"] = queue.getSize();
+        response["isEmpty"] = queue.isEmpty();
+        response["policy"] = policyToString(queue.getPolicy());
+        response["count"] = items.size();
+        if (hasMore && !page.empty()) {
+            response["nextCursor"] = std::to_string(page.back()->sequence);
+        } else {
+            response["nextCursor"] = nullptr;
+        }
+
+        return dumpWithRawArray(response, "queue", items);
         
     } catch (const std::exception& e) {
         json error;
@@ -445,11 +1307,14 @@ std::string TaskController::viewQueue(const std::string& userId) {
  */
 std::string TaskController::getQueueStatus(const std::string& userId) {
     try {
+        SchedulingQueue& queue = getUserQueue(userId);
+
         json response;
         response["success"] = true;
-        response["queueSize"] = processingQueue.getSize();
-        response["isEmpty"] = processingQueue.isEmpty();
-        response["hasNext"] = !processingQueue.isEmpty();
+        response["queueSize"] = queue.getSize();
+        response["isEmpty"] = queue.isEmpty();
+        response["hasNext"] = !queue.isEmpty();
+        response["policy"] = policyToString(queue.getPolicy());
         
         return response.dump();
         
@@ -462,30 +1327,1258 @@ std::string TaskController::getQueueStatus(const std::string& userId) {
 }
 
 /**
- * Gérer la requête (Point d'entrée principal)
- * Reçoit une requête JSON, identifie l'action demandée (ex: "create", "update", "undo"), et délègue l'exécution à la méthode appropriée.
- * jsonRequest Chaîne JSON contenant l'action et les données nécessaires.
- * Retourne Le résultat de la méthode appelée, formaté en JSON.
+ * Vider la file de traitement
+ * Retire toutes les entrées de la file de l'utilisateur. Le journal reçoit un retrait de toutes les entrées,
+ * qui vide la file de la même manière au rejeu.
+ * userId L'identifiant de l'utilisateur.
+ * Retourne Une chaîne JSON avec le nombre d'entrées retirées.
  */
-std::string TaskController::handleRequest(const std::string& jsonRequest) {
+std::string TaskController::clearQueue(const std::string& userId) {
     try {
-        json request = json::parse(jsonRequest);
-        std::string action = request["action"].get<std::string>();
+        SchedulingQueue& queue = getUserQueue(userId);
+        int cleared = queue.getSize();
 
-        if (action == "create") return createTask(request["data"].dump());
-        else if (action == "getAll") return getTasks(request["userId"].get<std::string>());
-        else if (action == "getById") return getTask(request["taskId"].get<std::string>());
-        else if (action == "update") return editTask(request["taskId"].get<std::string>(), request["data"].dump());
-        else if (action == "delete") return deleteTask(request["taskId"].get<std::string>());
+        logDequeue(userId, cleared);
+        queue.clear();
 
-        else if (action == "undo") return undoLastOperation(request["userId"].get<std::string>());
-        else if (action == "undoStatus") return getUndoStatus(request["userId"].get<std::string>());
-        else if (action == "undoHistory") return getUndoHistory(request["userId"].get<std::string>());
-        
-        else if (action == "addToQueue") return addToQueue(request["taskId"].get<std::string>());
-        else if (action == "processNext") return processNextTask(request["userId"].get<std::string>());
-        else if (action == "viewQueue") return viewQueue(request["userId"].get<std::string>());
-        else if (action == "queueStatus") return getQueueStatus(request["userId"].get<std::string>());
+        json response;
+        response["success"] = true;
+        response["message"] = "Queue cleared";
+        response["cleared"] = cleared;
+        response["queueSize"] = 0;
+        return response.dump();
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Clear queue error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Ajouter plusieurs tâches à la file
+ * Résout toutes les tâches en un seul lot, vérifie leur statut, puis les ajoute par lots
+ * à la file de chaque propriétaire en conservant l'ordre de la requête.
+ * jsonData Chaîne JSON contenant le tableau "taskIds".
+ * Retourne Une chaîne JSON avec le nombre de tâches ajoutées et la liste des tâches rejetées avec leur raison.
+ */
+std::string TaskController::enqueueMany(const std::string& jsonData) {
+    try {
+        json input = json::parse(jsonData);
+
+        if (!input.contains("taskIds") || !input["taskIds"].is_array()) {
+            json error;
+            error["success"] = false;
+            error["error"] = "taskIds must be an array";
+            return error.dump();
+        }
+
+        std::vector<std::string> taskIds;
+        for (const auto& id : input["taskIds"])
+            taskIds.push_back(id.get<std::string>());
+
+        std::vector<Task*> tasks = taskList.findMany(taskIds);
+        std::unordered_map<std::string, std::vector<Task*>> byUser;
+        std::unordered_set<std::string> batched;
+        json rejected = json::array();
+        int enqueued = 0;
+
+        for (size_t i = 0; i < tasks.size(); i++) {
+            Task* task = tasks[i];
+
+            if (!task) {
+                rejected.push_back({{"taskId", taskIds[i]}, {"error", "Task not found"}});
+            } else if (task->getStatus() != TO_DO && task->getStatus() != PENDING) {
+                rejected.push_back({{"taskId", taskIds[i]}, {"error", "Only TO_DO or PENDING tasks can be added to queue"}});
+            } else if (getUserQueue(task->getUserId()).containsTask(taskIds[i]) || !batched.insert(taskIds[i]).second) {
+                rejected.push_back({{"taskId", taskIds[i]}, {"error", "Task is already in the queue"}});
+            } else {
+                byUser[task->getUserId()].push_back(task);
+                enqueued++;
+            }
+        }
+
+        for (const auto& entry : byUser) {
+            for (const QueueEntry& queued : getUserQueue(entry.first).enqueueMany(entry.second)) {
+                logEnqueue(entry.first, queued);
+            }
+        }
+
+        json response;
+        response["success"] = true;
+        response["message"] = "Tasks added to processing queue";
+        response["enqueued"] = enqueued;
+        response["rejected"] = rejected;
+
+        return response.dump();
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Enqueue many error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Traiter les N prochaines tâches
+ * Retire jusqu'à 'count' entrées en un seul lot, résout les tâches en un seul lot,
+ * les passe à IN_PROGRESS et construit une seule réponse à partir de leur JSON déjà sérialisé.
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant "count".
+ * Retourne Une chaîne JSON avec les tâches démarrées, les identifiants introuvables et la taille restante de la file.
+ */
+std::string TaskController::processNextTasks(const std::string& userId, const std::string& jsonData) {
+    try {
+        json input = json::parse(jsonData);
+        int count = input.value("count", 1);
+
+        if (count <= 0) {
+            json error;
+            error["success"] = false;
+            error["error"] = "count must be positive";
+            return error.dump();
+        }
+
+        SchedulingQueue& queue = getUserQueue(userId);
+
+        if (queue.isEmpty()) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Processing queue is empty";
+            return error.dump();
+        }
+
+        std::vector<QueueEntry> entries;
+        logDequeue(userId, queue.dequeueMany(count, entries));
+
+        std::vector<std::string> taskIds;
+        taskIds.reserve(entries.size());
+        for (const QueueEntry& entry : entries)
+            taskIds.push_back(entry.taskId);
+
+        std::vector<Task*> tasks = taskList.findMany(taskIds);
+        std::vector<std::string> started;
+        json missing = json::array();
+
+        for (size_t i = 0; i < tasks.size(); i++) {
+            if (!tasks[i]) {
+                missing.push_back(taskIds[i]);
+                continue;
+            }
+            tasks[i]->setStatus(IN_PROGRESS);
+            taskChanged(*tasks[i]);
+            started.push_back(tasks[i]->toJson());
+        }
+
+        json response;
+        response["success"] = true;
+        response["message"] = "Started working on tasks";
+        response["count"] = started.size();
+        response["missing"] = missing;
+        response["remainingInQueue"] = queue.getSize();
+
+        return dumpWithRawArray(response, "tasks", started);
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Process next N error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Définir la politique de la file
+ * Change la politique d'ordonnancement de la file de l'utilisateur. Les tâches déjà en file sont conservées
+ * et réordonnées selon la nouvelle politique.
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant "policy" et optionnellement "agingSeconds".
+ * Retourne Une chaîne JSON avec la politique appliquée.
+ */
+std::string TaskController::setQueuePolicy(const std::string& userId, const std::string& jsonData) {
+    try {
+        json input = json::parse(jsonData);
+        SchedulingPolicy policy;
+
+        if (!input.contains("policy") || !input["policy"].is_string() ||
+            !policyFromString(input["policy"].get<std::string>(), policy)) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Policy must be one of: fifo, priority, deadline, aging";
+            return error.dump();
+        }
+
+        SchedulingQueue& queue = getUserQueue(userId);
+        queue.setPolicy(policy, input.value("agingSeconds", queue.getAgingSeconds()));
+        logQueuePolicy(userId, queue.getPolicy(), queue.getAgingSeconds());
+
+        json response;
+        response["success"] = true;
+        response["message"] = "Queue policy updated";
+        response["policy"] = policyToString(queue.getPolicy());
+        response["agingSeconds"] = queue.getAgingSeconds();
+        response["queueSize"] = queue.getSize();
+
+        return response.dump();
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Set queue policy error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Obtenir la politique de la file
+ * Retourne la politique d'ordonnancement courante de la file de l'utilisateur.
+ * userId L'identifiant de l'utilisateur.
+ * Retourne Une chaîne JSON avec la politique et son paramètre de vieillissement.
+ */
+std::string TaskController::getQueuePolicy(const std::string& userId) {
+    try {
+        SchedulingQueue& queue = getUserQueue(userId);
+
+        json response;
+        response["success"] = true;
+        response["policy"] = policyToString(queue.getPolicy());
+        response["agingSeconds"] = queue.getAgingSeconds();
+
+        return response.dump();
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Louer la prochaine tâche
+ * Retire la prochaine tâche de la file de l'utilisateur, la passe à IN_PROGRESS et enregistre un bail
+ * dont l'échéance est programmée dans la roue temporelle. Sans acquittement avant l'échéance, la tâche
+ * est automatiquement remise en file.
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant optionnellement "leaseSeconds".
+ * Retourne Une chaîne JSON avec l'identifiant du bail, son échéance et la tâche louée.
+ */
+std::string TaskController::leaseNextTask(const std::string& userId, const std::string& jsonData) {
+    try {
+        json input = json::parse(jsonData);
+        int leaseSeconds = input.value("leaseSeconds", DEFAULT_LEASE_SECONDS);
+
+        if (leaseSeconds <= 0) {
+            json error;
+            error["success"] = false;
+            error["error"] = "leaseSeconds must be positive";
+            return error.dump();
+        }
+
+        SchedulingQueue& queue = getUserQueue(userId);
+
+        if (queue.isEmpty()) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Processing queue is empty";
+            return error.dump();
+        }
+
+        QueueEntry entry = queue.dequeue();
+        logDequeue(userId, 1);
+        Task* task = taskList.find(entry.taskId);
+
+        if (!task) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Task not found";
+            return error.dump();
+        }
+
+        time_t expiresAt = std::time(nullptr) + leaseSeconds;
+        long long leaseId = nextLeaseId++;
+
+        activeLeases[leaseId] = Lease(leaseId, userId, entry, task->getStatus(), expiresAt);
+        leaseTimers.schedule(leaseId, expiresAt);
+        task->setStatus(IN_PROGRESS);
+        activeLeases[leaseId].taskVersion = task->getVersion();
+
+        logLeaseGrant(activeLeases[leaseId]);
+        taskChanged(*task);
+
+        json response;
+        response["success"] = true;
+        response["message"] = "Task leased";
+        response["leaseId"] = leaseId;
+        response["expiresAt"] = expiresAt;
+        response["task"] = json::parse(task->toJson());
+        response["remainingInQueue"] = queue.getSize();
+
+        return response.dump();
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Lease next error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Acquitter un bail
+ * Retire le bail actif et marque la tâche comme COMPLETED. Le minuteur du bail reste dans la roue
+ * mais sera ignoré à son expiration.
+ * leaseId L'identifiant du bail.
+ * Retourne Une chaîne JSON avec la tâche terminée, ou une erreur si le bail est inconnu ou expiré.
+ */
+std::string TaskController::ackLease(long long leaseId) {
+    try {
+        auto it = activeLeases.find(leaseId);
+        if (it == activeLeases.end()) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Lease not found or expired";
+            return error.dump();
+        }
+
+        std::string taskId = it->second.entry.taskId;
+        activeLeases.erase(it);
+        logLeaseEnd(leaseId);
+
+        Task* task = taskList.find(taskId);
+        if (!task) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Task not found";
+            return error.dump();
+        }
+
+        task->setStatus(COMPLETED);
+        taskChanged(*task);
+
+        json response;
+        response["success"] = true;
+        response["message"] = "Task completed";
+        response["task"] = json::parse(task->toJson());
+
+        return response.dump();
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Ack error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Rendre un bail (nack)
+ * Retire le bail actif et remet immédiatement la tâche dans la file avec son statut précédent. Une tâche
+ * modifiée pendant le bail (par exemple terminée) n'est pas remise en file.
+ * leaseId L'identifiant du bail.
+ * Retourne Une chaîne JSON avec la nouvelle taille de la file, ou une erreur si le bail est inconnu ou expiré.
+ */
+std::string TaskController::nackLease(long long leaseId) {
+    try {
+        auto it = activeLeases.find(leaseId);
+        if (it == activeLeases.end()) {
+            json error;
+            error["success"] = false;
+            error["error"] = "Lease not found or expired";
+            return error.dump();
+        }
+
+        Lease lease = it->second;
+        activeLeases.erase(it);
+        logLeaseEnd(leaseId);
+        bool requeued = releaseLease(lease);
+
+        json response;
+        response["success"] = true;
+        response["message"] = requeued ? "Task returned to queue" : "Lease released; task changed since it was leased";
+        response["requeued"] = requeued;
+        response["queueSize"] = getUserQueue(lease.userId).getSize();
+
+        return response.dump();
+
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Nack error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Importer des tâches
+ * Un vidage NDJSON est lu par lots de blocs analysés en parallèle ; un vidage binaire (export) est lu
+ * enregistrement par enregistrement ; un instantané est projeté en mémoire et seules ses tâches sont importées. Chaque lot est inséré et journalisé, indexé en parallèle (un travail par index)
+ * puis validé, ce qui borne la mémoire du journal quelle que soit la taille du fichier. Les importations ne sont pas annulables.
+ * jsonData Chaîne JSON contenant "path", et optionnellement "format" et "threads".
+ * Retourne Réponse JSON avec "imported", "updated", "rejected", "seconds" et "tasksPerSecond".
+ */
+std::string TaskController::importTasks(const std::string& jsonData) {
+    static const size_t IMPORT_BATCH_TASKS = 65536; // Tâches indexées et validées ensemble (vidages binaires et instantanés)
+
+    try {
+        json input = json::parse(jsonData);
+        std::string path = input["path"].get<std::string>();
+        std::string detected = isSnapshotFile(path) ? "snapshot" : (isBinaryDumpFile(path) ? "binary" : "ndjson");
+        std::string format = input.value("format", detected);
+        size_t threads = input.value("threads", 0);
+
+        auto started = std::chrono::steady_clock::now();
+        size_t imported = 0;
+        size_t updated = 0;
+        size_t rejected = 0;
+
+        // Les tâches d'un lot sont placées dans la liste une à une, puis indexées ensemble en parallèle
+        std::vector<const Task*> placed;
+        auto store = [&](Task* task) {
+            logTask(*task);
+            bool inserted = false;
+            placed.push_back(placeTask(task, inserted));
+            if (inserted) imported++;
+            else updated++;
+        };
+        auto commitBatch = [&]() {
+            indexTasks(placed);
+            placed.clear();
+            wal.commit();
+        };
+
+        try {
+            if (format == "snapshot") {
+                MappedFile file;
+                if (!file.open(path)) {
+                    throw std::runtime_error("Cannot open import file " + path);
+                }
+                SnapshotHeader header = readSnapshotHeader(file);
+                BinaryReader reader(file.getData() + SNAPSHOT_HEADER_SIZE, static_cast<size_t>(header.bodySize));
+
+                uint64_t taskCount = reader.readU64();
+                taskList.reserve(static_cast<size_t>(taskList.getSize() + taskCount));
+                for (uint64_t i = 0; i < taskCount; i++) {
+                    store(decodeTask(reader, header.version >= SNAPSHOT_VERSION_COMPLETED_AT));
+                    if (placed.size() == IMPORT_BATCH_TASKS) commitBatch();
+                }
+                commitBatch();
+            } else if (format == "binary") {
+                BinaryTaskReader dump(path);
+                while (Task* task = dump.next()) {
+                    store(task);
+                    if (placed.size() == IMPORT_BATCH_TASKS) commitBatch();
+                }
+                commitBatch();
+            } else if (format == "ndjson") {
+                NdjsonTaskReader dump(path, getExecutor(), threads);
+                threads = dump.getThreadCount();
+
+                std::vector<Task*> batch;
+                while (dump.nextBatch(batch, rejected)) {
+                    for (Task* task : batch) {
+                        store(task);
+                    }
+                    batch.clear();
+                    commitBatch();
+                }
+            } else {
+                throw std::runtime_error("Unknown import format: " + format);
+            }
+        } catch (...) {
+            // Les tâches déjà placées restent importées : leurs index doivent suivre
+            indexTasks(placed);
+            throw;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        size_t total = imported + updated;
+
+        json response;
+        response["success"] = true;
+        response["message"] = "Tasks imported";
+        response["format"] = format;
+        response["imported"] = imported;
+        response["updated"] = updated;
+        response["rejected"] = rejected;
+        if (format == "ndjson") response["threads"] = threads;
+        response["seconds"] = seconds;
+        response["tasksPerSecond"] = seconds > 0 ? static_cast<long long>(total / seconds) : static_cast<long long>(total);
+        return response.dump();
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Import error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Exporter des tâches
+ * Parcourt la liste directement (sans vecteur intermédiaire ni document JSON global) et écrit chaque tâche
+ * retenue dans le tampon de taille fixe de l'écrivain.
+ * jsonData Chaîne JSON contenant "path", et optionnellement "format", "userId" et "modifiedSince" (horodatage :
+ * seules les tâches modifiées à partir de cet instant sont exportées).
+ * allowStdout Autorise le chemin "-" (sortie standard).
+ * Retourne Réponse JSON avec "exported", "bytes" et "seconds".
+ */
+std::string TaskController::exportTasks(const std::string& jsonData, bool allowStdout) {
+    try {
+        json input = json::parse(jsonData);
+        std::string path = input["path"].get<std::string>();
+        std::string userId = input.value("userId", "");
+        time_t modifiedSince = input.value("modifiedSince", static_cast<time_t>(0));
+
+        DumpFormat format;
+        if (!parseDumpFormat(input.value("format", "ndjson"), format)) {
+            throw std::runtime_error("Unknown export format: " + input.value("format", ""));
+        }
+        if (path == "-" && !allowStdout) {
+            throw std::runtime_error("Standard output is reserved for responses");
+        }
+
+        // La sérialisation est répartie sur l'ordonnanceur, sauf dans l'enfant d'une exportation en arrière-plan
+        // (ses threads n'existent pas après fork)
+        auto writeTasks = [this, userId, modifiedSince](TaskDumpWriter& dump, WorkStealingExecutor* parallel) {
+            std::vector<const Task*> tasks;
+            auto visit = [&](const Task& task) {
+                if (task.getUpdatedAt() < modifiedSince) return;
+                tasks.push_back(&task);
+            };
+            if (userId.empty()) taskList.forEach(visit);
+            else userTasks.snapshot(userId).forEach(visit);
+            dump.writeAll(tasks, parallel);
+        };
+
+        if (input.value("background", false)) {
+            if (path == "-") {
+                throw std::runtime_error("Background exports need a file path");
+            }
+            uint64_t lsn = wal.isOpen() ? wal.getLastLsn() : 0;
+            exportWriter.start(path, format, lsn, [&writeTasks](TaskDumpWriter& dump) {
+                writeTasks(dump, nullptr);
+            });
+
+            json response;
+            response["success"] = true;
+            response["message"] = "Export started";
+            response["lsn"] = lsn;
+            return response.dump();
+        }
+
+        auto started = std::chrono::steady_clock::now();
+
+        TaskDumpWriter dump(path, format);
+        writeTasks(dump, &getExecutor());
+        dump.finish();
+
+        json response;
+        response["success"] = true;
+        response["message"] = "Tasks exported";
+        response["exported"] = dump.getCount();
+        response["bytes"] = dump.getBytes();
+        response["seconds"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        return response.dump();
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Export error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Obtenir le statut des exportations
+ * Retourne Réponse JSON avec "inProgress" (et alors "path" et "lsn" de l'exportation en cours) et "last",
+ * le bilan de la dernière exportation en arrière-plan terminée (null si aucune).
+ */
+std::string TaskController::getExportStatus() {
+    json response;
+    response["success"] = true;
+    response["inProgress"] = exportWriter.isRunning();
+    if (exportWriter.isRunning()) {
+        response["path"] = exportWriter.getCurrent().path;
+        response["lsn"] = exportWriter.getCurrent().lsn;
+    }
+
+    if (lastExport.path.empty()) {
+        response["last"] = nullptr;
+    } else {
+        json last;
+        last["success"] = lastExport.succeeded;
+        last["path"] = lastExport.path;
+        last["lsn"] = lastExport.lsn;
+        last["seconds"] = lastExport.seconds;
+        if (lastExport.succeeded) {
+            last["exported"] = lastExport.count;
+            last["bytes"] = lastExport.bytes;
+        } else {
+            last["error"] = lastExport.error;
+        }
+        response["last"] = last;
+    }
+    return response.dump();
+}
+
+/**
+ * Prendre un instantané
+ * Démarre un instantané en arrière-plan ; la réponse n'attend pas la fin de l'écriture
+ * (voir snapshotStatus).
+ * Retourne Réponse JSON contenant le LSN couvert par l'instantané.
+ */
+std::string TaskController::takeSnapshot() {
+    json response;
+
+    if (snapshotPath.empty()) {
+        response["success"] = false;
+        response["error"] = "Snapshots are not enabled";
+        return response.dump();
+    }
+    if (snapshotWriter.isRunning()) {
+        response["success"] = false;
+        response["error"] = "A snapshot is already in progress";
+        return response.dump();
+    }
+
+    try {
+        startSnapshot();
+        response["success"] = true;
+        response["message"] = "Snapshot started";
+        response["lsn"] = wal.isOpen() ? wal.getLastLsn() : 0;
+        return response.dump();
+    } catch (const std::exception& e) {
+        response["success"] = false;
+        response["error"] = std::string("Snapshot error: ") + e.what();
+        return response.dump();
+    }
+}
+
+/**
+ * Obtenir le statut des instantanés
+ * Retourne Réponse JSON avec "enabled", "inProgress", "lastSnapshotLsn", "lastSnapshotAt", "walLsn" et
+ * "walActiveBytes" (taille du segment actif du journal).
+ */
+std::string TaskController::getSnapshotStatus() {
+    json response;
+    response["success"] = true;
+    response["enabled"] = !snapshotPath.empty();
+    response["inProgress"] = snapshotWriter.isRunning();
+    response["lastSnapshotLsn"] = lastSnapshotLsn;
+    response["lastSnapshotAt"] = lastSnapshotAt;
+    response["walLsn"] = wal.isOpen() ? wal.getLastLsn() : 0;
+    response["walActiveBytes"] = wal.isOpen() ? wal.getActiveSize() : 0;
+    return response.dump();
+}
+
+/**
+ * Interroger les tâches
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON de la requête.
+ * fields Masque des champs à sérialiser pour chaque tâche.
+ * Retourne Réponse JSON avec "count", "data", "nextCursor", "plan" et "examined" (tâches examinées).
+ */
+std::string TaskController::queryTasks(const std::string& userId, const std::string& jsonData, unsigned fields) {
+    json response;
+
+    try {
+        TaskQuery query = TaskQuery::parse(jsonData);
+        QueryResult result = QueryPlanner(taskList, searchIndex, orderIndex).run(userId, query);
+
+        std::vector<std::string> items;
+        items.reserve(result.tasks.size());
+        for (Task* task : result.tasks) {
+            items.push_back(task->toJson(fields));
+        }
+
+        response["success"] = true;
+        response["count"] = result.tasks.size();
+        if (result.hasMore && !result.tasks.empty()) {
+            const Task* last = result.tasks.back();
+            response["nextCursor"] = query.encodeCursor(OrderKey{TaskOrderIndex::sortValue(*last, query.sort), last->getId()});
+        } else {
+            response["nextCursor"] = nullptr;
+        }
+        response["plan"] = result.plan;
+        response["examined"] = result.examined;
+        return dumpWithRawArray(response, "data", items);
+    } catch (const std::exception& e) {
+        response["success"] = false;
+        response["error"] = std::string("Invalid query: ") + e.what();
+        return response.dump();
+    }
+}
+
+/**
+ * Tâches les plus urgentes
+ * Les tâches terminées sont exclues sauf si "includeCompleted" est vrai.
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant optionnellement "limit" (10 par défaut, 100 au plus) et "includeCompleted".
+ * fields Masque des champs à sérialiser pour chaque tâche.
+ * Retourne Réponse JSON avec "count" et les tâches dans "data".
+ */
+std::string TaskController::getTopTasks(const std::string& userId, const std::string& jsonData, unsigned fields) {
+    json response;
+
+    try {
+        json input = json::parse(jsonData);
+        int limit = input.value("limit", 10);
+        if (limit <= 0 || limit > 100) {
+            response["success"] = false;
+            response["error"] = "limit must be between 1 and 100";
+            return response.dump();
+        }
+
+        unsigned statusMask = (1u << TO_DO) | (1u << PENDING) | (1u << IN_PROGRESS);
+        if (input.value("includeCompleted", false)) statusMask |= 1u << COMPLETED;
+
+        std::vector<std::string> items;
+        items.reserve(limit);
+        orderIndex.scan(userId, statusMask, SORT_URGENCY, false, nullptr, false, [&](const OrderKey& key) {
+            Task* task = taskList.find(key.taskId);
+            if (task) items.push_back(task->toJson(fields));
+            return items.size() < static_cast<size_t>(limit);
+        });
+
+        response["success"] = true;
+        response["count"] = items.size();
+        return dumpWithRawArray(response, "data", items);
+    } catch (const std::exception& e) {
+        response["success"] = false;
+        response["error"] = std::string("Top tasks error: ") + e.what();
+        return response.dump();
+    }
+}
+
+/**
+ * Changements depuis une version
+ * Le client applique d'abord les suppressions puis les tâches modifiées (une tâche supprimée puis
+ * recréée par une annulation apparaît dans les deux), et reprend avec la "version" renvoyée. Si
+ * "hasMore" est vrai, il rappelle aussitôt l'action avec cette version.
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant "since" et optionnellement "limit" (500 par défaut, 5000 au plus).
+ * fields Masque des champs à sérialiser pour chaque tâche.
+ * Retourne Réponse JSON avec "changed", "deleted", "version", "hasMore" et "resync".
+ */
+std::string TaskController::getChangesSince(const std::string& userId, const std::string& jsonData, unsigned fields) {
+    json response;
+
+    try {
+        json input = json::parse(jsonData);
+        uint64_t since = input["since"].get<uint64_t>();
+        int limit = input.value("limit", 500);
+        if (limit <= 0 || limit > 5000) {
+            response["success"] = false;
+            response["error"] = "limit must be between 1 and 5000";
+            return response.dump();
+        }
+
+        std::vector<std::string> changed;
+        json deleted = json::array();
+        uint64_t version = 0;
+        bool hasMore = false;
+        bool served = syncLog.changesSince(userId, since, static_cast<size_t>(limit),
+            [&](const std::string& taskId) {
+                Task* task = taskList.find(taskId);
+                if (task) changed.push_back(task->toJson(fields));
+            },
+            [&](const std::string& taskId) { deleted.push_back(taskId); },
+            version, hasMore);
+
+        response["success"] = true;
+        response["resync"] = !served;
+        response["version"] = version;
+        response["hasMore"] = hasMore;
+        response["deleted"] = deleted;
+        return dumpWithRawArray(response, "changed", changed);
+    } catch (const std::exception& e) {
+        response["success"] = false;
+        response["error"] = std::string("Changes since error: ") + e.what();
+        return response.dump();
+    }
+}
+
+/**
+ * Lister par échéance
+ * Le parcours part de la borne inférieure dans les partitions non terminées de l'index des échéances et
+ * s'arrête à la borne supérieure ou à la limite (100 par défaut, 1000 au plus).
+ * userId L'identifiant de l'utilisateur.
+ * from La première échéance retenue.
+ * to La dernière échéance retenue.
+ * jsonData Chaîne JSON contenant optionnellement "limit".
+ * fields Masque des champs à sérialiser pour chaque tâche.
+ * Retourne Réponse JSON avec "count", "hasMore" et les tâches dans "data".
+ */
+std::string TaskController::listByDueDate(const std::string& userId, time_t from, time_t to, const std::string& jsonData, unsigned fields) {
+    json response;
+    json input = json::parse(jsonData);
+    int limit = input.value("limit", 100);
+    if (limit <= 0 || limit > 1000) {
+        response["success"] = false;
+        response["error"] = "limit must be between 1 and 1000";
+        return response.dump();
+    }
+
+    unsigned statusMask = (1u << TO_DO) | (1u << PENDING) | (1u << IN_PROGRESS);
+    OrderKey start{static_cast<long long>(from), ""};
+    std::vector<std::string> items;
+    bool hasMore = false;
+    orderIndex.scan(userId, statusMask, SORT_DUE_DATE, false, &start, false, [&](const OrderKey& key) {
+        if (key.value > static_cast<long long>(to)) return false;
+        if (items.size() == static_cast<size_t>(limit)) {
+            hasMore = true;
+            return false;
+        }
+        Task* task = taskList.find(key.taskId);
+        if (task) items.push_back(task->toJson(fields));
+        return true;
+    });
+
+    response["success"] = true;
+    response["count"] = items.size();
+    response["hasMore"] = hasMore;
+    return dumpWithRawArray(response, "data", items);
+}
+
+/**
+ * Tâches en retard
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant optionnellement "limit".
+ * fields Masque des champs à sérialiser pour chaque tâche.
+ * Retourne Réponse JSON avec les tâches dont l'échéance est strictement antérieure à l'heure courante.
+ */
+std::string TaskController::getOverdueTasks(const std::string& userId, const std::string& jsonData, unsigned fields) {
+    try {
+        return listByDueDate(userId, 1, std::time(nullptr) - 1, jsonData, fields);
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Overdue tasks error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Tâches à échéance proche
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant "seconds" (durée de la fenêtre) et optionnellement "limit".
+ * fields Masque des champs à sérialiser pour chaque tâche.
+ * Retourne Réponse JSON avec les tâches dont l'échéance tombe entre maintenant et maintenant + seconds.
+ */
+std::string TaskController::getDueWithin(const std::string& userId, const std::string& jsonData, unsigned fields) {
+    try {
+        json input = json::parse(jsonData);
+        long long seconds = input["seconds"].get<long long>();
+        if (seconds < 0) {
+            json error;
+            error["success"] = false;
+            error["error"] = "seconds must be positive";
+            return error.dump();
+        }
+
+        time_t now = std::time(nullptr);
+        return listByDueDate(userId, now, now + static_cast<time_t>(seconds), jsonData, fields);
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Due within error: ") + e.what();
+        return error.dump();
+    }
+}
+
+/**
+ * Obtenir l'état de l'échéancier
+ * Retourne Réponse JSON avec "scheduled" (tâches programmées) et "nextDueAt" (0 si aucune).
+ */
+std::string TaskController::getDueStatus() {
+    json response;
+    response["success"] = true;
+    response["scheduled"] = dueIndex.getSize();
+    response["nextDueAt"] = dueIndex.nextDue();
+    return response.dump();
+}
+
+/**
+ * Rechercher des tâches
+ * Seules les tâches rendues sont triées (tri partiel) ; les tâches sans échéance viennent après les autres.
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant "query" et optionnellement "limit" (50 par défaut, 500 au plus).
+ * fields Masque des champs à sérialiser pour chaque tâche.
+ * Retourne Réponse JSON avec "count" (nombre total de correspondances) et les tâches dans "data".
+ */
+std::string TaskController::searchTasks(const std::string& userId, const std::string& jsonData, unsigned fields) {
+    json response;
+
+    try {
+        json input = json::parse(jsonData);
+        std::string query = input["query"].get<std::string>();
+        int limit = input.value("limit", 50);
+        if (limit <= 0 || limit > 500) {
+            response["success"] = false;
+            response["error"] = "limit must be between 1 and 500";
+            return response.dump();
+        }
+
+        std::vector<Task*> matches;
+        for (const std::string& taskId : searchIndex.search(userId, query)) {
+            Task* task = taskList.find(taskId);
+            if (task) matches.push_back(task);
+        }
+
+        size_t count = std::min(matches.size(), static_cast<size_t>(limit));
+        std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), [](const Task* a, const Task* b) {
+            if (a->getPriority() != b->getPriority()) return a->getPriority() > b->getPriority();
+            time_t dueA = a->getDueDate() == 0 ? std::numeric_limits<time_t>::max() : a->getDueDate();
+            time_t dueB = b->getDueDate() == 0 ? std::numeric_limits<time_t>::max() : b->getDueDate();
+            if (dueA != dueB) return dueA < dueB;
+            return a->getCreatedAt() < b->getCreatedAt();
+        });
+
+        std::vector<std::string> items;
+        items.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            items.push_back(matches[i]->toJson(fields));
+        }
+
+        response["success"] = true;
+        response["count"] = matches.size();
+        return dumpWithRawArray(response, "data", items);
+    } catch (const std::exception& e) {
+        response["success"] = false;
+        response["error"] = std::string("Invalid search: ") + e.what();
+        return response.dump();
+    }
+}
+
+/**
+ * Compléter un titre
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant "prefix" et optionnellement "limit" (10 par défaut, 50 au plus).
+ * Retourne Réponse JSON avec les suggestions dans "data".
+ */
+std::string TaskController::autocomplete(const std::string& userId, const std::string& jsonData) {
+    json response;
+
+    try {
+        json input = json::parse(jsonData);
+        std::string prefix = input["prefix"].get<std::string>();
+        int limit = input.value("limit", 10);
+        if (limit <= 0 || limit > 50) {
+            response["success"] = false;
+            response["error"] = "limit must be between 1 and 50";
+            return response.dump();
+        }
+
+        json completions = json::array();
+        for (const Completion& completion : titleIndex.complete(userId, prefix, static_cast<size_t>(limit))) {
+            completions.push_back({{"title", completion.title}, {"count", completion.count}});
+        }
+
+        response["success"] = true;
+        response["data"] = completions;
+        return response.dump();
+    } catch (const std::exception& e) {
+        response["success"] = false;
+        response["error"] = std::string("Invalid autocomplete request: ") + e.what();
+        return response.dump();
+    }
+}
+
+/**
+ * Obtenir les statistiques
+ * Les créations sont rendues pour les 12 derniers mois (clé "AAAA-MM", heure locale), du plus ancien au
+ * mois courant. "totalTasks" compte les tâches de tous les utilisateurs.
+ * userId L'identifiant de l'utilisateur.
+ * Retourne Réponse JSON contenant les compteurs dans "data".
+ */
+std::string TaskController::getStats(const std::string& userId) {
+    time_t now = std::time(nullptr);
+    const UserTaskStats* stats = taskStats.get(userId, now);
+    UserTaskStats empty;
+    if (!stats) stats = &empty;
+
+    json data;
+    data["total"] = stats->total;
+    data["byStatus"] = {
+        {"todo", stats->byStatus[TO_DO]},
+        {"pending", stats->byStatus[PENDING]},
+        {"inProgress", stats->byStatus[IN_PROGRESS]},
+        {"completed", stats->byStatus[COMPLETED]}
+    };
+    data["byPriority"] = {
+        {"low", stats->byPriority[LOW - LOW]},
+        {"medium", stats->byPriority[MEDIUM - LOW]},
+        {"high", stats->byPriority[HIGH - LOW]}
+    };
+    data["favorites"] = stats->favorites;
+    data["overdue"] = stats->overdue;
+
+    int currentMonth = TaskStats::monthKey(now);
+    json months = json::array();
+    for (int month = currentMonth - 11; month <= currentMonth; month++) {
+        auto it = stats->createdByMonth.find(month);
+        char key[16];
+        std::snprintf(key, sizeof(key), "%04d-%02d", month / 12, month % 12 + 1);
+        months.push_back({{"month", key}, {"count", it == stats->createdByMonth.end() ? 0 : it->second}});
+    }
+    data["createdThisMonth"] = months.back()["count"];
+    data["createdByMonth"] = months;
+
+    json response;
+    response["success"] = true;
+    response["userId"] = userId;
+    response["totalTasks"] = taskStats.getTaskCount();
+    response["data"] = data;
+    return response.dump();
+}
+
+/**
+ * Convertir une journée
+ * Retourne L'objet JSON {"date", "created", "completed"} du jour.
+ */
+static json dayToJson(const DayBucket& bucket) {
+    json j;
+    j["date"] = TaskStats::dayString(bucket.day);
+    j["created"] = bucket.created;
+    j["completed"] = bucket.completed;
+    return j;
+}
+
+/**
+ * Obtenir les statistiques de la semaine
+ * userId L'identifiant de l'utilisateur.
+ * Retourne Réponse JSON contenant sept jours {"day", "date", "created", "completed"} dans "data".
+ */
+std::string TaskController::getWeekStats(const std::string& userId) {
+    static const char* const DAY_NAMES[7] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+
+    time_t now = std::time(nullptr);
+    const UserTaskStats* stats = taskStats.get(userId, now);
+    int today = TaskStats::dayKey(now);
+    int monday = today - TaskStats::weekday(today);
+
+    json days = json::array();
+    for (int i = 0; i < 7; i++) {
+        json day = dayToJson(stats ? stats->getDay(monday + i) : DayBucket(monday + i));
+        day["day"] = DAY_NAMES[i];
+        days.push_back(day);
+    }
+
+    json response;
+    response["success"] = true;
+    response["data"] = days;
+    return response.dump();
+}
+
+/**
+ * Obtenir les statistiques d'une plage
+ * Les bornes sont incluses et converties en jours locaux ; la plage est limitée à l'historique conservé.
+ * userId L'identifiant de l'utilisateur.
+ * jsonData Chaîne JSON contenant optionnellement "from" et "to".
+ * Retourne Réponse JSON avec "from", "to", "created", "completed" (totaux) et les jours dans "data".
+ */
+std::string TaskController::getRangeStats(const std::string& userId, const std::string& jsonData) {
+    json response;
+
+    try {
+        json input = json::parse(jsonData);
+        time_t now = std::time(nullptr);
+        time_t to = input.value("to", now);
+        time_t from = input.value("from", to - 6 * 24 * 3600);
+
+        int firstDay = TaskStats::dayKey(from);
+        int lastDay = TaskStats::dayKey(to);
+        if (firstDay > lastDay || lastDay - firstDay >= TaskStats::HISTORY_DAYS) {
+            response["success"] = false;
+            response["error"] = "The range must cover between 1 and " + std::to_string(TaskStats::HISTORY_DAYS) + " days";
+            return response.dump();
+        }
+
+        const UserTaskStats* stats = taskStats.get(userId, now);
+        json days = json::array();
+        uint64_t created = 0;
+        uint64_t completed = 0;
+        for (int day = firstDay; day <= lastDay; day++) {
+            DayBucket bucket = stats ? stats->getDay(day) : DayBucket(day);
+            created += bucket.created;
+            completed += bucket.completed;
+            days.push_back(dayToJson(bucket));
+        }
+
+        response["success"] = true;
+        response["from"] = TaskStats::dayString(firstDay);
+        response["to"] = TaskStats::dayString(lastDay);
+        response["created"] = created;
+        response["completed"] = completed;
+        response["data"] = days;
+        return response.dump();
+    } catch (const std::exception& e) {
+        response["success"] = false;
+        response["error"] = std::string("Invalid range: ") + e.what();
+        return response.dump();
+    }
+}
+
+/**
+ * Obtenir les changements
+ * Les événements ont le même format que ceux du flux de changements. Si les enregistrements suivant
+ * 'fromLsn' ont déjà été supprimés par un point de contrôle, la requête échoue avec "oldestLsn" :
+ * le consommateur doit alors repartir d'un export complet.
+ * jsonData Chaîne JSON contenant "fromLsn" et optionnellement "limit" (1000 par défaut, 10000 au plus).
+ * Retourne Réponse JSON avec "changes", "nextLsn" et "lastLsn".
+ */
+std::string TaskController::getChanges(const std::string& jsonData) {
+    json response;
+
+    if (!wal.isOpen()) {
+        response["success"] = false;
+        response["error"] = "The write-ahead log is not enabled";
+        return response.dump();
+    }
+
+    try {
+        json input = json::parse(jsonData);
+        uint64_t fromLsn = input.value("fromLsn", static_cast<uint64_t>(0));
+        int limit = input.value("limit", 1000);
+        if (limit <= 0 || limit > 10000) {
+            response["success"] = false;
+            response["error"] = "limit must be between 1 and 10000";
+            return response.dump();
+        }
+
+        std::vector<std::string> changes;
+        uint64_t nextLsn = fromLsn;
+        uint64_t oldestLsn = wal.readCommitted(fromLsn, static_cast<size_t>(limit), [&](const LogRecord& record) {
+            nextLsn = record.lsn;
+            std::string event = changeEventToJson(record);
+            if (!event.empty()) changes.push_back(event);
+        });
+
+        if (oldestLsn > 0 && fromLsn + 1 < oldestLsn) {
+            response["success"] = false;
+            response["error"] = "Changes after this LSN are no longer retained";
+            response["oldestLsn"] = oldestLsn;
+            return response.dump();
+        }
+
+        response["success"] = true;
+        response["count"] = changes.size();
+        response["nextLsn"] = nextLsn;
+        response["lastLsn"] = wal.getLastLsn();
+        return dumpWithRawArray(response, "changes", changes);
+    } catch (const std::exception& e) {
+        response["success"] = false;
+        response["error"] = std::string("Invalid changes request: ") + e.what();
+        return response.dump();
+    }
+}
+
+/**
+ * Gérer la requête (Point d'entrée principal)
+ * Suit les instantanés et les exportations, remet en file les baux échus, exécute la requête puis valide en une seule écriture tous les enregistrements
+ * du journal produits pendant la requête (validation groupée). La réponse n'est renvoyée qu'une fois les
+ * mutations journalisées selon la politique de synchronisation. Une fois le journal en échec, toutes les
+ * requêtes sont refusées.
+ * jsonRequest Chaîne JSON contenant l'action et les données nécessaires.
+ * Retourne Le résultat de la méthode appelée, formaté en JSON.
+ */
+std::string TaskController::handleRequest(const std::string& jsonRequest) {
+    // Après un échec du journal, l'état en mémoire peut contenir des mutations non journalisées : plus
+    // aucune requête n'est servie, le redémarrage reconstruit l'état validé à partir du disque
+    if (wal.hasFailed()) {
+        json error;
+        error["success"] = false;
+        error["error"] = "Write-ahead log failed, restart the engine to recover: " + wal.getFailure();
+        return error.dump();
+    }
+
+    pollSnapshots();
+    pollExports();
+    expireLeases();
+    publishDueTasks();
+
+    std::string response = routeRequest(jsonRequest);
+
+    try {
+        wal.commit();
+    } catch (const std::exception& e) {
+        json error;
+        error["success"] = false;
+        error["error"] = std::string("Write-ahead log error: ") + e.what();
+        return error.dump();
+    }
+
+    return response;
+}
+
+/**
+ * Router la requête
+ * Reçoit une requête JSON, identifie l'action demandée (ex: "create", "update", "undo"), et délègue l'exécution à la méthode appropriée.
+ * jsonRequest Chaîne JSON contenant l'action et les données nécessaires.
+ * Retourne Le résultat de la méthode appelée, formaté en JSON.
+ */
+std::string TaskController::routeRequest(const std::string& jsonRequest) {
+    try {
+        json request = json::parse(jsonRequest);
+        std::string action = request["action"].get<std::string>();
+
+        // Projection optionnelle des tâches rendues : seuls les champs listés sont sérialisés
+        unsigned fields = FIELD_ALL;
+        if (request.contains("fields")) {
+            fields = Task::parseFields(request["fields"].get<std::vector<std::string>>());
+        }
+        // Lecture conditionnelle : "non modifié" sans sérialisation si l'ETag du client est toujours valide
+        std::string ifNoneMatch = request.value("ifNoneMatch", "");
+        // Écriture conditionnelle : la mise à jour ou la suppression échoue si la tâche a changé depuis cette version
+        uint64_t expectedVersion = request.value("expectedVersion", static_cast<uint64_t>(0));
+
+        if (action == "create") return createTask(request["data"].dump());
+        else if (action == "getAll") return getTasks(request["userId"].get<std::string>(), fields, ifNoneMatch);
+        else if (action == "getById") return getTask(request["taskId"].get<std::string>(), fields, ifNoneMatch);
+        else if (action == "update") return editTask(request["taskId"].get<std::string>(), request["data"].dump(), expectedVersion);
+        else if (action == "delete") return deleteTask(request["taskId"].get<std::string>(), expectedVersion);
+        else if (action == "clear") return clearTasks(request["userId"].get<std::string>());
+
+        else if (action == "undo") return undoLastOperation(request["userId"].get<std::string>());
+        else if (action == "undoStatus") return getUndoStatus(request["userId"].get<std::string>());
+        else if (action == "undoHistory") return getUndoHistory(request["userId"].get<std::string>());
+        
+        else if (action == "addToQueue") return addToQueue(request["taskId"].get<std::string>());
+        else if (action == "processNext") return processNextTask(request["userId"].get<std::string>());
+        else if (action == "viewQueue") return viewQueue(request["userId"].get<std::string>(), request.value("data", json::object()).dump());
+        else if (action == "queueStatus") return getQueueStatus(request["userId"].get<std::string>());
+        else if (action == "clearQueue") return clearQueue(request["userId"].get<std::string>());
+        else if (action == "enqueueMany") return enqueueMany(request["data"].dump());
+        else if (action == "processNextN") return processNextTasks(request["userId"].get<std::string>(), request["data"].dump());
+        else if (action == "setQueuePolicy") return setQueuePolicy(request["userId"].get<std::string>(), request["data"].dump());
+        else if (action == "queuePolicy") return getQueuePolicy(request["userId"].get<std::string>());
+
+        else if (action == "leaseNext") return leaseNextTask(request["userId"].get<std::string>(), request.value("data", json::object()).dump());
+        else if (action == "ack") return ackLease(request["leaseId"].get<long long>());
+        else if (action == "nack") return nackLease(request["leaseId"].get<long long>());
+
+        else if (action == "import") return importTasks(request["data"].dump());
+        else if (action == "export") return exportTasks(request["data"].dump());
+        else if (action == "exportStatus") return getExportStatus();
+
+        else if (action == "snapshot") return takeSnapshot();
+        else if (action == "snapshotStatus") return getSnapshotStatus();
+
+        else if (action == "query") return queryTasks(request["userId"].get<std::string>(), request.value("data", json::object()).dump(), fields);
+        else if (action == "top") return getTopTasks(request["userId"].get<std::string>(), request.value("data", json::object()).dump(), fields);
+        else if (action == "changesSince") return getChangesSince(request["userId"].get<std::string>(), request["data"].dump(), fields);
+        else if (action == "overdue") return getOverdueTasks(request["userId"].get<std::string>(), request.value("data", json::object()).dump(), fields);
+        else if (action == "dueWithin") return getDueWithin(request["userId"].get<std::string>(), request["data"].dump(), fields);
+        else if (action == "dueStatus") return getDueStatus();
+        else if (action == "search") return searchTasks(request["userId"].get<std::string>(), request["data"].dump(), fields);
+        else if (action == "autocomplete") return autocomplete(request["userId"].get<std::string>(), request["data"].dump());
+
+        else if (action == "stats") return getStats(request["userId"].get<std::string>());
+        else if (action == "weekStats") return getWeekStats(request["userId"].get<std::string>());
+        else if (action == "rangeStats") return getRangeStats(request["userId"].get<std::string>(), request.value("data", json::object()).dump());
+
+        else if (action == "changes") return getChanges(request.value("data", json::object()).dump());
         
         else {
             json error;
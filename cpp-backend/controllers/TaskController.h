@@ -4,9 +4,27 @@
 #include "../models/Task.h"
 #include "../models/LinkedList.h"
 #include "../models/Operation.h"
+#include "../models/Lease.h"
 #include "../datastructures/Stack.h"
 #include "../datastructures/Queue.h"
+#include "../datastructures/SchedulingQueue.h"
+#include "../datastructures/TimerWheel.h"
+#include "../datastructures/TaskStats.h"
+#include "../datastructures/TrigramIndex.h"
+#include "../datastructures/AutocompleteIndex.h"
+#include "../datastructures/TaskOrderIndex.h"
+#include "../datastructures/DueIndex.h"
+#include "../datastructures/SyncLog.h"
+#include "../datastructures/UserTaskIndex.h"
+#include "../query/TaskQuery.h"
+#include "../persistence/WriteAheadLog.h"
+#include "../persistence/Snapshot.h"
+#include "../persistence/TaskDump.h"
+#include "../persistence/ChangeFeed.h"
+#include "../runtime/WorkStealingExecutor.h"
 #include <string>
+#include <unordered_map>
+#include <memory>
 
 /**
  * Agit comme le contrôleur principal pour la gestion des tâches. Il gère la logique métier, 
@@ -17,9 +35,36 @@ class TaskController {
 private:
     TaskLinkedList taskList; 
     Stack undoStack;
-    Queue<std::string> processingQueue;
+    std::unordered_map<std::string, SchedulingQueue> userQueues; // Une file de traitement par utilisateur
+    std::unordered_map<long long, Lease> activeLeases; // Baux en cours, indexés par identifiant
+    TimerWheel<long long> leaseTimers;                   // Échéances des baux
+    TaskStats taskStats;                                 // Compteurs par utilisateur, tenus à jour à chaque mutation
+    TrigramIndex searchIndex;                            // Index de recherche du titre et de la description
+    AutocompleteIndex titleIndex;                        // Index d'autocomplétion des titres
+    TaskOrderIndex orderIndex;                           // Index ordonnés par champ de tri et par statut
+    DueIndex dueIndex;                                   // Échéancier des tâches non terminées
+    UserTaskIndex userTasks;                             // Collection persistante des tâches de chaque utilisateur
+    SyncLog syncLog;                                     // Versions par utilisateur et suppressions récentes (synchronisation différentielle)
+    WriteAheadLog wal;                                   // Journal des mutations (désactivé par défaut)
+    ChangeFeed changeFeed;                               // Flux des mutations validées (désactivé par défaut)
+    ChangeFeed dueFeed;                                  // Flux des échéances atteintes (désactivé par défaut)
+    BackgroundSnapshot snapshotWriter;                   // Instantané en cours d'écriture
+    BackgroundExport exportWriter;                       // Exportation en arrière-plan en cours
+    ExportReport lastExport;                             // Bilan de la dernière exportation en arrière-plan terminée
+    std::string snapshotPath;                            // Chemin des instantanés (vide si désactivés)
+    int snapshotIntervalSeconds;                         // Période des instantanés automatiques (0 si aucun)
+    time_t lastSnapshotAt;                               // Moment du dernier instantané démarré ou chargé
+    uint64_t lastSnapshotLsn;                            // LSN couvert par le dernier instantané écrit ou chargé
+    uint64_t lastCheckpointRecordLsn;                    // LSN du dernier enregistrement CHECKPOINT (rien n'a changé depuis s'il est le dernier)
+    uint64_t checkpointBytes;                            // Taille du segment actif déclenchant un point de contrôle (0 si aucune)
+    uint64_t checkpointBytesPerSecond;                   // Débit d'écriture maximal des instantanés (0 si illimité)
+    std::unique_ptr<WorkStealingExecutor> executor;     // Ordonnanceur des traitements en masse (créé au premier besoin)
+    size_t executorThreads;                              // Nombre de threads de l'ordonnanceur (0 pour le nombre de cœurs)
     int nextId;
+    long long nextLeaseId;
     const int MAX_UNDO_SIZE = 20;
+    const int DEFAULT_LEASE_SECONDS = 300;
+    const int DEFAULT_PAGE_SIZE = 50;
 
     /**
      * Pousser l'opération d'annulation
@@ -28,11 +73,262 @@ private:
      */
     void pushUndo(const Operation& op);
 
+    /**
+     * Obtenir la file d'un utilisateur
+     * Retourne la file de traitement de l'utilisateur, en la créant si nécessaire.
+     * userId L'identifiant de l'utilisateur.
+     */
+    SchedulingQueue& getUserQueue(const std::string& userId);
+
+    /**
+     * Rendre un bail
+     * Remet la tâche du bail dans la file de son utilisateur et restaure son statut précédent,
+     * sauf si la tâche a été supprimée ou modifiée depuis la location.
+     * lease Le bail à rendre.
+     * Retourne true si la tâche a été remise en file.
+     */
+    bool releaseLease(const Lease& lease);
+
+    /**
+     * Expirer les baux
+     * Fait avancer la roue temporelle jusqu'à l'heure courante et rend chaque bail échu.
+     */
+    void expireLeases();
+
+    /**
+     * Annoncer les échéances
+     * Fait avancer l'échéancier jusqu'à l'heure courante et publie un événement "task.due" par tâche échue.
+     */
+    void publishDueTasks();
+
+    /**
+     * Lister par échéance
+     * Parcourt l'index des échéances des tâches non terminées de l'utilisateur entre deux bornes incluses.
+     * userId L'identifiant de l'utilisateur.
+     * from La première échéance retenue.
+     * to La dernière échéance retenue.
+     * jsonData Chaîne JSON contenant optionnellement "limit".
+     * fields Masque des champs à sérialiser.
+     * Retourne Réponse JSON avec les tâches dans "data" et "hasMore".
+     */
+    std::string listByDueDate(const std::string& userId, time_t from, time_t to, const std::string& jsonData, unsigned fields);
+
+    // Write-ahead log
+
+    /**
+     * Journaliser une tâche
+     * Enregistre l'état complet d'une tâche créée ou modifiée.
+     */
+    void logTask(const Task& task);
+
+    /**
+     * Journaliser une suppression
+     * Enregistre la suppression d'une tâche.
+     */
+    void logTaskDelete(const std::string& taskId);
+
+    /**
+     * Indexer une tâche
+     * Met à jour les index dérivés (statistiques, recherche, autocomplétion, tri) d'une tâche insérée ou modifiée.
+     */
+    void indexTask(const Task& task);
+
+    /**
+     * Désindexer une tâche
+     * Retire une tâche supprimée des index dérivés.
+     */
+    void unindexTask(const std::string& taskId);
+
+    /**
+     * Indexer des tâches en masse
+     * Comme indexTask pour chaque tâche, mais chaque index dérivé est mis à jour par son propre travail sur
+     * l'ordonnanceur (les index sont indépendants ; chacun reçoit les tâches dans l'ordre).
+     * tasks Les tâches, telles que stockées dans la liste.
+     */
+    void indexTasks(const std::vector<const Task*>& tasks);
+
+    /**
+     * Obtenir l'ordonnanceur
+     * Démarre l'ordonnanceur des traitements en masse au premier appel.
+     */
+    WorkStealingExecutor& getExecutor();
+
+    /**
+     * Enregistrer une modification
+     * Met à jour les index dérivés d'une tâche créée ou modifiée, puis la journalise.
+     */
+    void taskChanged(const Task& task);
+
+    /**
+     * Enregistrer une suppression
+     * Retire une tâche supprimée des index dérivés, puis journalise la suppression.
+     */
+    void taskRemoved(const std::string& taskId);
+
+    /**
+     * Journaliser une mise en file
+     * Enregistre une entrée ajoutée ou remise dans la file d'un utilisateur.
+     */
+    void logEnqueue(const std::string& userId, const QueueEntry& entry);
+
+    /**
+     * Journaliser un retrait de file
+     * Enregistre le retrait des 'count' prochaines entrées de la file d'un utilisateur.
+     */
+    void logDequeue(const std::string& userId, int count);
+
+    /**
+     * Journaliser une politique de file
+     * Enregistre le changement de politique d'ordonnancement de la file d'un utilisateur.
+     */
+    void logQueuePolicy(const std::string& userId, SchedulingPolicy policy, int agingSeconds);
+
+    /**
+     * Journaliser un bail accordé
+     */
+    void logLeaseGrant(const Lease& lease);
+
+    /**
+     * Journaliser la fin d'un bail
+     */
+    void logLeaseEnd(long long leaseId);
+
+    /**
+     * Appliquer un enregistrement
+     * Rejoue l'effet d'un enregistrement du journal sur les structures en mémoire, sans le journaliser à nouveau.
+     * record L'enregistrement relu.
+     */
+    void applyLogRecord(const LogRecord& record);
+
+    /**
+     * Insérer ou remplacer une tâche
+     * Insère la tâche, ou remplace sur place l'état de la tâche existante de même identifiant
+     * (qui garde sa position dans la liste).
+     * task La tâche (la mémoire appartient désormais au contrôleur).
+     * Retourne true si la tâche a été insérée, false si elle en a remplacé une existante.
+     */
+    bool upsertTask(Task* task);
+
+    /**
+     * Placer une tâche
+     * Comme upsertTask, sans mettre à jour les index dérivés.
+     * task La tâche (la mémoire appartient désormais au contrôleur).
+     * inserted Reçoit true si la tâche a été insérée, false si elle en a remplacé une existante.
+     * Retourne La tâche stockée dans la liste (celle qui a été remplacée sur place, le cas échéant).
+     */
+    Task* placeTask(Task* task, bool& inserted);
+
+    // Snapshots
+
+    /**
+     * Encoder l'état
+     * Écrit l'état complet du contrôleur (tâches, pile d'annulation, files, baux) dans le corps d'un instantané.
+     * writer L'écrivain de destination.
+     */
+    void encodeSnapshot(BinaryWriter& writer);
+
+    /**
+     * Décoder l'état
+     * Reconstruit l'état du contrôleur à partir du corps d'un instantané.
+     * reader Le lecteur source.
+     * withCompletedAt Faux pour un instantané antérieur à la date d'achèvement des tâches.
+     */
+    void decodeSnapshot(BinaryReader& reader, bool withCompletedAt);
+
+    /**
+     * Démarrer un instantané (point de contrôle)
+     * Scelle le segment actif du journal puis lance l'écriture en arrière-plan d'un instantané de l'état courant.
+     * Lève une exception en cas d'échec.
+     */
+    void startSnapshot();
+
+    /**
+     * Suivre les instantanés
+     * Enregistre la fin de l'instantané en cours, supprime les segments du journal qu'il couvre, et démarre
+     * un point de contrôle lorsqu'il est dû (période écoulée ou journal trop volumineux).
+     */
+    void pollSnapshots();
+
+    /**
+     * Suivre les exportations
+     * Enregistre le bilan de l'exportation en arrière-plan lorsqu'elle se termine.
+     */
+    void pollExports();
+
+    /**
+     * Router la requête
+     * Délègue l'exécution à la méthode correspondant au champ 'action' de la requête.
+     * jsonRequest Chaîne JSON contenant l'action et les données.
+     * Retourne Le résultat de l'opération en format JSON.
+     */
+    std::string routeRequest(const std::string& jsonRequest);
+
 public:
     /**
      * Initialise le contrôleur.
      */
-    TaskController() : nextId(1) {}
+    TaskController() : snapshotIntervalSeconds(0), lastSnapshotAt(0), lastSnapshotLsn(0), lastCheckpointRecordLsn(0),
+                       checkpointBytes(0), checkpointBytesPerSecond(0), executorThreads(0), nextId(1), nextLeaseId(1) {}
+
+    /**
+     * Attend la fin de l'instantané en cours.
+     */
+    ~TaskController();
+
+    /**
+     * Ouvrir les instantanés
+     * Charge l'instantané existant (projeté en mémoire) puis active les instantanés à ce chemin.
+     * Doit être appelé avant openWriteAheadLog afin que seuls les enregistrements postérieurs soient rejoués.
+     * Lève une exception si l'instantané existant est illisible.
+     * path Le chemin du fichier d'instantané.
+     * intervalSeconds La période des instantanés automatiques en secondes (0 pour les désactiver).
+     */
+    void openSnapshots(const std::string& path, int intervalSeconds);
+
+    /**
+     * Configurer les points de contrôle
+     * Un point de contrôle scelle le segment actif du journal, écrit un instantané en arrière-plan puis
+     * supprime les segments qu'il couvre.
+     * walBytes La taille du segment actif au-delà de laquelle un point de contrôle est déclenché (0 pour aucune).
+     * maxBytesPerSecond Le débit d'écriture maximal de l'instantané (0 pour aucune limite).
+     */
+    void setCheckpointPolicy(uint64_t walBytes, uint64_t maxBytesPerSecond);
+
+    /**
+     * Configurer le parallélisme
+     * Fixe le nombre de threads des traitements en masse (importation, exportation, reconstruction des
+     * index). Doit être appelé avant le premier de ces traitements.
+     * threads Le nombre de threads (0 pour le nombre de cœurs).
+     */
+    void setThreadCount(size_t threads);
+
+    /**
+     * Ouvrir le journal d'écriture anticipée
+     * Rejoue le journal existant pour reconstruire l'état en mémoire, puis journalise toutes les mutations
+     * suivantes. Lève une exception en cas d'erreur d'entrée/sortie.
+     * path Le chemin du fichier du journal.
+     * policy La politique de synchronisation sur disque.
+     * intervalMs L'intervalle de synchronisation en millisecondes (FSYNC_INTERVAL).
+     */
+    void openWriteAheadLog(const std::string& path, FsyncPolicy policy, int intervalMs);
+
+    /**
+     * Ouvrir le flux de changements
+     * Publie chaque mutation validée dans le journal vers la destination, une ligne JSON par événement.
+     * Doit être appelé après openWriteAheadLog. Lève une exception si le journal n'est pas ouvert ou si la
+     * destination ne peut pas être ouverte.
+     * target Un chemin de fichier (ouvert en ajout) ou "fd:N" pour un descripteur hérité.
+     */
+    void openChangeFeed(const std::string& target);
+
+    /**
+     * Ouvrir le flux des échéances
+     * Publie un événement {"type":"task.due",...} chaque fois que l'échéance d'une tâche non terminée est
+     * atteinte (vérifié à chaque requête). Les échéances déjà passées au démarrage ne sont pas annoncées.
+     * Lève une exception si la destination ne peut pas être ouverte.
+     * target Un chemin de fichier (ouvert en ajout) ou "fd:N" pour un descripteur hérité.
+     */
+    void openDueFeed(const std::string& target);
 
     // Core CRUD Operations
 
@@ -48,34 +344,50 @@ public:
      * Obtenir toutes les tâches pour un utilisateur
      * Récupère la liste des tâches d'un utilisateur.
      * userId L'identifiant de l'utilisateur.
-     * Retourne Réponse JSON contenant la liste des tâches.
+     * fields Masque des champs à sérialiser (FIELD_ALL par défaut).
+     * ifNoneMatch L'ETag déjà détenu par le client (vide si aucun).
+     * Retourne Réponse JSON contenant la liste des tâches, la version de synchronisation ("version") et
+     * l'"etag" de la liste, ou "notModified" à true si l'ETag du client est toujours valide.
      */
-    std::string getTasks(const std::string& userId);
+    std::string getTasks(const std::string& userId, unsigned fields = FIELD_ALL, const std::string& ifNoneMatch = "");
 
     /**
      * Obtenir une seule tâche
      * Récupère une tâche spécifique par son ID.
      * taskId L'identifiant de la tâche.
-     * Retourne Réponse JSON contenant les données de la tâche.
+     * fields Masque des champs à sérialiser (FIELD_ALL par défaut).
+     * ifNoneMatch L'ETag déjà détenu par le client (vide si aucun).
+     * Retourne Réponse JSON contenant les données de la tâche et son "etag", ou "notModified" à true si
+     * l'ETag du client est toujours valide.
      */
-    std::string getTask(const std::string& taskId);
+    std::string getTask(const std::string& taskId, unsigned fields = FIELD_ALL, const std::string& ifNoneMatch = "");
 
     /**
      * Mettre à jour une tâche
      * Modifie les propriétés d'une tâche existante.
      * taskId L'identifiant de la tâche à modifier.
      * jsonData Chaîne JSON contenant les champs à mettre à jour.
-     * Retourne Réponse JSON.
+     * expectedVersion La version attendue de la tâche (0 pour une mise à jour inconditionnelle).
+     * Retourne Réponse JSON, ou un conflit ("conflict" et "currentVersion") si la version a changé.
      */
-    std::string editTask(const std::string& taskId, const std::string& jsonData);
+    std::string editTask(const std::string& taskId, const std::string& jsonData, uint64_t expectedVersion = 0);
 
     /**
      * Supprimer une tâche
      * Supprime une tâche de la liste.
      * taskId L'identifiant de la tâche à supprimer.
-     * Retourne Réponse JSON.
+     * expectedVersion La version attendue de la tâche (0 pour une suppression inconditionnelle).
+     * Retourne Réponse JSON, ou un conflit ("conflict" et "currentVersion") si la version a changé.
      */
-    std::string deleteTask(const std::string& taskId);
+    std::string deleteTask(const std::string& taskId, uint64_t expectedVersion = 0);
+
+    /**
+     * Supprimer toutes les tâches d'un utilisateur
+     * Supprime chaque tâche de l'utilisateur de la liste et des index, avec une suppression journalisée par tâche.
+     * userId L'identifiant de l'utilisateur.
+     * Retourne Réponse JSON avec le nombre de tâches supprimées ("deletedCount").
+     */
+    std::string clearTasks(const std::string& userId);
 
     // Undo
 
@@ -115,7 +427,7 @@ public:
 
     /**
      * Traiter la prochaine tâche
-     * Retire la tâche la plus ancienne de la file et commence son traitement (par exemple, changer son statut).
+     * Retire la prochaine tâche de la file de l'utilisateur selon sa politique et commence son traitement (par exemple, changer son statut).
      * userId L'identifiant de l'utilisateur.
      * Retourne Réponse JSON.
      */
@@ -123,11 +435,12 @@ public:
 
     /**
      * Voir la file
-     * Donne un aperçu de l'état actuel de la file de traitement.
+     * Donne le contenu ordonné de la file de traitement, page par page, avec la position de chaque tâche.
      * userId L'identifiant de l'utilisateur.
-     * Retourne Réponse JSON.
+     * jsonData Chaîne JSON contenant optionnellement "offset", "limit" et "cursor".
+     * Retourne Réponse JSON, ou une erreur "staleCursor" si l'entrée du curseur a quitté la file.
      */
-    std::string viewQueue(const std::string& userId);
+    std::string viewQueue(const std::string& userId, const std::string& jsonData);
 
     /**
      * Retirer de la file
@@ -145,6 +458,253 @@ public:
      */
     std::string getQueueStatus(const std::string& userId);
 
+    /**
+     * Vider la file
+     * Retire toutes les entrées de la file de l'utilisateur.
+     * userId L'identifiant de l'utilisateur.
+     * Retourne Réponse JSON avec le nombre d'entrées retirées ("cleared").
+     */
+    std::string clearQueue(const std::string& userId);
+
+    /**
+     * Définir la politique de la file
+     * Choisit la façon dont la prochaine tâche est sélectionnée dans la file de l'utilisateur.
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant "policy" (fifo, priority, deadline, aging) et optionnellement "agingSeconds".
+     * Retourne Réponse JSON.
+     */
+    std::string setQueuePolicy(const std::string& userId, const std::string& jsonData);
+
+    /**
+     * Obtenir la politique de la file
+     * Retourne la politique d'ordonnancement de la file de l'utilisateur.
+     * userId L'identifiant de l'utilisateur.
+     * Retourne Réponse JSON.
+     */
+    std::string getQueuePolicy(const std::string& userId);
+
+    /**
+     * Ajouter plusieurs tâches à la file
+     * Met en file un lot de tâches en une seule requête ; chaque tâche rejoint la file de son propriétaire.
+     * jsonData Chaîne JSON contenant le tableau "taskIds".
+     * Retourne Réponse JSON avec le nombre de tâches ajoutées et les tâches rejetées.
+     */
+    std::string enqueueMany(const std::string& jsonData);
+
+    /**
+     * Traiter les N prochaines tâches
+     * Retire jusqu'à N tâches de la file de l'utilisateur et les passe toutes à IN_PROGRESS.
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant "count".
+     * Retourne Réponse JSON contenant les tâches démarrées.
+     */
+    std::string processNextTasks(const std::string& userId, const std::string& jsonData);
+
+    // Leases
+
+    /**
+     * Louer la prochaine tâche
+     * Retire la prochaine tâche de la file et accorde un bail limité dans le temps au consommateur.
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant optionnellement "leaseSeconds".
+     * Retourne Réponse JSON contenant l'identifiant du bail et la tâche.
+     */
+    std::string leaseNextTask(const std::string& userId, const std::string& jsonData);
+
+    /**
+     * Acquitter un bail
+     * Termine le traitement de la tâche louée et marque la tâche comme COMPLETED.
+     * leaseId L'identifiant du bail.
+     * Retourne Réponse JSON.
+     */
+    std::string ackLease(long long leaseId);
+
+    /**
+     * Rendre un bail (nack)
+     * Abandonne le traitement : la tâche est remise en file avec son statut précédent, si elle n'a pas
+     * été modifiée depuis la location.
+     * leaseId L'identifiant du bail.
+     * Retourne Réponse JSON.
+     */
+    std::string nackLease(long long leaseId);
+
+    // Bulk import / export
+
+    /**
+     * Importer des tâches
+     * Charge en une requête toutes les tâches d'un fichier de vidage (NDJSON, vidage binaire ou instantané).
+     * Les tâches existantes de même identifiant sont remplacées.
+     * jsonData Chaîne JSON contenant "path", et optionnellement "format" (ndjson, binary, snapshot) et "threads".
+     * Retourne Réponse JSON avec le nombre de tâches importées, rejetées et le débit (tâches/s).
+     */
+    std::string importTasks(const std::string& jsonData);
+
+    /**
+     * Exporter des tâches
+     * Écrit en flux les tâches (éventuellement filtrées) dans un fichier NDJSON ou binaire ; la sérialisation est
+     * parallèle et la mémoire se limite à un pointeur par tâche exportée.
+     * Avec "background", l'exportation lit une vue figée de l'état dans un processus dupliqué et la réponse
+     * n'attend pas la fin de l'écriture (voir getExportStatus).
+     * jsonData Chaîne JSON contenant "path", et optionnellement "format" (ndjson, binary), "userId", "modifiedSince"
+     * et "background".
+     * allowStdout Autorise le chemin "-" (sortie standard), réservé au mode ligne de commande.
+     * Retourne Réponse JSON avec le nombre de tâches et d'octets écrits (ou le LSN visible par l'exportation lancée).
+     */
+    std::string exportTasks(const std::string& jsonData, bool allowStdout = false);
+
+    /**
+     * Obtenir le statut des exportations
+     * Indique si une exportation en arrière-plan est en cours et décrit la dernière terminée.
+     * Retourne Réponse JSON.
+     */
+    std::string getExportStatus();
+
+    // Snapshots
+
+    /**
+     * Prendre un instantané
+     * Démarre l'écriture en arrière-plan d'un instantané de l'état courant.
+     * Retourne Réponse JSON contenant le LSN couvert par l'instantané.
+     */
+    std::string takeSnapshot();
+
+    /**
+     * Obtenir le statut des instantanés
+     * Indique si un instantané est en cours et décrit le dernier instantané terminé.
+     * Retourne Réponse JSON.
+     */
+    std::string getSnapshotStatus();
+
+    // Query
+
+    /**
+     * Interroger les tâches
+     * Filtre, trie et pagine les tâches de l'utilisateur ; le planificateur choisit l'index le moins coûteux.
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON de la requête (voir TaskQuery::parse).
+     * fields Masque des champs à sérialiser (FIELD_ALL par défaut).
+     * Retourne Réponse JSON avec la page de tâches, "nextCursor" (null sur la dernière page) et "plan".
+     */
+    std::string queryTasks(const std::string& userId, const std::string& jsonData, unsigned fields = FIELD_ALL);
+
+    /**
+     * Tâches les plus urgentes
+     * Renvoie les k premières tâches de l'utilisateur par priorité décroissante puis échéance la plus proche,
+     * lues en tête de l'index d'urgence maintenu (O(k log n), sans tri ni modification de la liste).
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant optionnellement "limit" et "includeCompleted".
+     * fields Masque des champs à sérialiser (FIELD_ALL par défaut).
+     * Retourne Réponse JSON avec les tâches dans "data".
+     */
+    std::string getTopTasks(const std::string& userId, const std::string& jsonData, unsigned fields = FIELD_ALL);
+
+    // Delta sync
+
+    /**
+     * Changements depuis une version
+     * Renvoie les tâches créées ou modifiées et les identifiants des tâches supprimées depuis la version
+     * connue du client, en O(changements).
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant "since" et optionnellement "limit".
+     * fields Masque des champs à sérialiser (FIELD_ALL par défaut).
+     * Retourne Réponse JSON avec "changed", "deleted", "version" et "hasMore", ou "resync" à true si la
+     * version est trop ancienne (ou d'un autre processus) et que le client doit tout relire.
+     */
+    std::string getChangesSince(const std::string& userId, const std::string& jsonData, unsigned fields = FIELD_ALL);
+
+    // Due dates
+
+    /**
+     * Tâches en retard
+     * Renvoie les tâches non terminées de l'utilisateur dont l'échéance est dépassée, de la plus ancienne
+     * à la plus récente, en O(log n + résultat).
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant optionnellement "limit".
+     * fields Masque des champs à sérialiser (FIELD_ALL par défaut).
+     * Retourne Réponse JSON avec les tâches dans "data".
+     */
+    std::string getOverdueTasks(const std::string& userId, const std::string& jsonData, unsigned fields = FIELD_ALL);
+
+    /**
+     * Tâches à échéance proche
+     * Renvoie les tâches non terminées de l'utilisateur dont l'échéance tombe dans les prochaines secondes.
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant "seconds" et optionnellement "limit".
+     * fields Masque des champs à sérialiser (FIELD_ALL par défaut).
+     * Retourne Réponse JSON avec les tâches dans "data".
+     */
+    std::string getDueWithin(const std::string& userId, const std::string& jsonData, unsigned fields = FIELD_ALL);
+
+    /**
+     * Obtenir l'état de l'échéancier
+     * Annonce les échéances atteintes (comme toute requête) ; permet au serveur de réveiller le moteur.
+     * Retourne Réponse JSON avec le nombre de tâches programmées et la prochaine échéance.
+     */
+    std::string getDueStatus();
+
+    // Search
+
+    /**
+     * Rechercher des tâches
+     * Cherche une sous-chaîne (insensible à la casse) dans le titre et la description des tâches de
+     * l'utilisateur, à l'aide de l'index de trigrammes.
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant "query" et optionnellement "limit".
+     * fields Masque des champs à sérialiser (FIELD_ALL par défaut).
+     * Retourne Réponse JSON avec le nombre total de correspondances et les tâches, classées par priorité
+     * décroissante puis par échéance la plus proche.
+     */
+    std::string searchTasks(const std::string& userId, const std::string& jsonData, unsigned fields = FIELD_ALL);
+
+    /**
+     * Compléter un titre
+     * Propose les titres distincts de l'utilisateur qui commencent par le texte saisi.
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant "prefix" et optionnellement "limit".
+     * Retourne Réponse JSON avec les suggestions {"title", "count"} dans l'ordre alphabétique.
+     */
+    std::string autocomplete(const std::string& userId, const std::string& jsonData);
+
+    // Statistics
+
+    /**
+     * Obtenir les statistiques
+     * Lit les compteurs de l'utilisateur, maintenus à chaque mutation, sans parcourir ses tâches.
+     * userId L'identifiant de l'utilisateur.
+     * Retourne Réponse JSON avec le total, la répartition par statut et par priorité, les favoris, les tâches
+     * en retard et les créations par mois.
+     */
+    std::string getStats(const std::string& userId);
+
+    /**
+     * Obtenir les statistiques de la semaine
+     * Lit l'historique quotidien de l'utilisateur pour la semaine courante, du lundi au dimanche.
+     * userId L'identifiant de l'utilisateur.
+     * Retourne Réponse JSON avec, pour chaque jour, les tâches créées et terminées.
+     */
+    std::string getWeekStats(const std::string& userId);
+
+    /**
+     * Obtenir les statistiques d'une plage
+     * Lit l'historique quotidien de l'utilisateur sur une plage de jours, en O(jours).
+     * userId L'identifiant de l'utilisateur.
+     * jsonData Chaîne JSON contenant optionnellement "from" et "to" (horodatages en secondes, "to" vaut
+     * maintenant par défaut et "from" sept jours plus tôt).
+     * Retourne Réponse JSON avec les compteurs de chaque jour et leurs totaux.
+     */
+    std::string getRangeStats(const std::string& userId, const std::string& jsonData);
+
+    // Change data capture
+
+    /**
+     * Obtenir les changements
+     * Relit depuis le journal les mutations validées après un LSN, pour qu'un consommateur rattrape son retard
+     * ou reprenne après une interruption.
+     * jsonData Chaîne JSON contenant "fromLsn" (exclu) et optionnellement "limit".
+     * Retourne Réponse JSON avec les événements ("changes"), "nextLsn" (à passer comme fromLsn suivant) et "lastLsn".
+     */
+    std::string getChanges(const std::string& jsonData);
+
     // Command router
 
     /**
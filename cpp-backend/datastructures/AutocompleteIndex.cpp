@@ -0,0 +1,115 @@
+#include "AutocompleteIndex.h"
+
+/**
+ * Normaliser
+ * title Le titre.
+ * Retourne La clé normalisée.
+ */
+std::string AutocompleteIndex::normalize(const std::string& title) {
+    std::string key;
+    key.reserve(title.size());
+
+    bool pendingSpace = false;
+    for (char c : title) {
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            pendingSpace = !key.empty();
+            continue;
+        }
+        if (pendingSpace) {
+            key += ' ';
+            pendingSpace = false;
+        }
+        key += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+    return key;
+}
+
+/**
+ * Ajouter un titre
+ * Le premier titre d'une clé sert de libellé à la suggestion.
+ */
+void AutocompleteIndex::add(const std::string& userId, const std::string& key, const std::string& title) {
+    Completion& completion = users[userId][key];
+    if (completion.count == 0) completion.title = title;
+    completion.count++;
+}
+
+/**
+ * Retirer un titre
+ * La clé disparaît avec sa dernière tâche, et l'utilisateur avec sa dernière clé.
+ */
+void AutocompleteIndex::remove(const std::string& userId, const std::string& key) {
+    auto userIt = users.find(userId);
+    if (userIt == users.end()) return;
+
+    auto it = userIt->second.find(key);
+    if (it == userIt->second.end()) return;
+    if (--it->second.count == 0) {
+        userIt->second.erase(it);
+        if (userIt->second.empty()) users.erase(userIt);
+    }
+}
+
+/**
+ * Mettre à jour une tâche
+ * taskId L'identifiant de la tâche.
+ * userId Le propriétaire de la tâche.
+ * title Le titre.
+ */
+void AutocompleteIndex::update(const std::string& taskId, const std::string& userId, const std::string& title) {
+    std::string key = normalize(title);
+    if (key.empty()) {
+        erase(taskId);
+        return;
+    }
+
+    auto it = titles.find(taskId);
+    if (it != titles.end()) {
+        if (it->second.userId == userId && it->second.key == key) return;
+        remove(it->second.userId, it->second.key);
+        it->second.userId = userId;
+        it->second.key = key;
+    } else {
+        titles.emplace(taskId, IndexedTitle{userId, key});
+    }
+    add(userId, key, title);
+}
+
+/**
+ * Retirer une tâche
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void AutocompleteIndex::erase(const std::string& taskId) {
+    auto it = titles.find(taskId);
+    if (it == titles.end()) return;
+
+    remove(it->second.userId, it->second.key);
+    titles.erase(it);
+}
+
+/**
+ * Compléter
+ * Parcourt les clés à partir de la borne inférieure du préfixe normalisé et s'arrête à la première clé
+ * qui ne commence plus par lui, ou dès que 'limit' suggestions sont réunies.
+ * userId L'identifiant de l'utilisateur.
+ * prefix Le début du titre saisi.
+ * limit Le nombre maximal de suggestions.
+ * Retourne Les suggestions, dans l'ordre alphabétique des clés.
+ */
+std::vector<Completion> AutocompleteIndex::complete(const std::string& userId, const std::string& prefix, size_t limit) const {
+    std::vector<Completion> completions;
+
+    auto userIt = users.find(userId);
+    if (userIt == users.end() || limit == 0) return completions;
+
+    // Une espace finale est significative pendant la saisie ("rapport " ne propose pas "rapports")
+    std::string key = normalize(prefix);
+    if (!key.empty() && !prefix.empty() && prefix.back() == ' ') key += ' ';
+
+    const std::map<std::string, Completion>& keys = userIt->second;
+    for (auto it = keys.lower_bound(key); it != keys.end() && completions.size() < limit; ++it) {
+        if (it->first.compare(0, key.size(), key) != 0) break;
+        completions.push_back(it->second);
+    }
+    return completions;
+}
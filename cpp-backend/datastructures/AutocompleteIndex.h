@@ -0,0 +1,86 @@
+#ifndef AUTOCOMPLETEINDEX_H
+#define AUTOCOMPLETEINDEX_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+/**
+ * Suggestion d'autocomplétion : un titre distinct et le nombre de tâches qui le portent.
+ */
+struct Completion {
+    std::string title;  // Le titre tel que saisi (celui de la première tâche indexée)
+    size_t count;       // Nombre de tâches de l'utilisateur ayant ce titre normalisé
+
+    /**
+     * Initialise une suggestion.
+     */
+    Completion(const std::string& t = "", size_t c = 0) : title(t), count(c) {}
+};
+
+/**
+ * Index d'autocomplétion des titres, partitionné par utilisateur. Les titres normalisés (minuscules,
+ * espaces réduits) sont rangés dans un arbre ordonné dont chaque clé distincte est stockée une seule
+ * fois ; les complétions d'un préfixe sont les clés contiguës à partir de sa borne inférieure, de sorte
+ * qu'une requête coûte O(log n + k) quel que soit le nombre de titres.
+ */
+class AutocompleteIndex {
+private:
+    /**
+     * Titre indexé d'une tâche.
+     */
+    struct IndexedTitle {
+        std::string userId;
+        std::string key;    // Titre normalisé
+    };
+
+    std::unordered_map<std::string, std::map<std::string, Completion>> users; // Utilisateur -> clé -> suggestion
+    std::unordered_map<std::string, IndexedTitle> titles;                      // Identifiant de tâche -> titre indexé
+
+    /**
+     * Ajouter un titre
+     */
+    void add(const std::string& userId, const std::string& key, const std::string& title);
+
+    /**
+     * Retirer un titre
+     */
+    void remove(const std::string& userId, const std::string& key);
+
+public:
+    /**
+     * Normaliser
+     * Met le titre en minuscules (ASCII), supprime les espaces de début et de fin et réduit les suites
+     * d'espaces à un seul.
+     * title Le titre.
+     * Retourne La clé normalisée.
+     */
+    static std::string normalize(const std::string& title);
+
+    /**
+     * Mettre à jour une tâche
+     * Réindexe le titre de la tâche s'il a changé (sans effet sinon).
+     * taskId L'identifiant de la tâche.
+     * userId Le propriétaire de la tâche.
+     * title Le titre.
+     */
+    void update(const std::string& taskId, const std::string& userId, const std::string& title);
+
+    /**
+     * Retirer une tâche
+     * taskId L'identifiant de la tâche supprimée.
+     */
+    void erase(const std::string& taskId);
+
+    /**
+     * Compléter
+     * userId L'identifiant de l'utilisateur.
+     * prefix Le début du titre saisi.
+     * limit Le nombre maximal de suggestions.
+     * Retourne Les titres distincts commençant par le préfixe, dans l'ordre alphabétique.
+     */
+    std::vector<Completion> complete(const std::string& userId, const std::string& prefix, size_t limit) const;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "DueIndex.h"
+
+/**
+ * Mettre à jour une tâche
+ * task La tâche insérée ou modifiée.
+ */
+void DueIndex::update(const Task& task) {
+    std::string taskId = task.getId();
+    time_t due = task.getDueDate();
+    bool schedule = task.getStatus() != COMPLETED && due != 0 && due > firedUntil;
+
+    auto it = armed.find(taskId);
+    if (it != armed.end()) {
+        if (schedule && it->second == due) return;
+        pending.erase(std::make_pair(it->second, taskId));
+        if (!schedule) {
+            armed.erase(it);
+            return;
+        }
+        it->second = due;
+        pending.emplace(due, std::move(taskId));
+        return;
+    }
+
+    if (!schedule) return;
+    armed.emplace(taskId, due);
+    pending.emplace(due, std::move(taskId));
+}
+
+/**
+ * Retirer une tâche
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void DueIndex::erase(const std::string& taskId) {
+    auto it = armed.find(taskId);
+    if (it == armed.end()) return;
+
+    pending.erase(std::make_pair(it->second, taskId));
+    armed.erase(it);
+}
+
+/**
+ * Avancer
+ * now L'heure courante.
+ * due Reçoit les identifiants des tâches échues.
+ */
+void DueIndex::advance(time_t now, std::vector<std::string>& due) {
+    if (now <= firedUntil) return;
+
+    while (!pending.empty() && pending.begin()->first <= now) {
+        auto first = pending.begin();
+        armed.erase(first->second);
+        due.push_back(first->second);
+        pending.erase(first);
+    }
+    firedUntil = now;
+}
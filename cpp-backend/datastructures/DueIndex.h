@@ -0,0 +1,67 @@
+#ifndef DUEINDEX_H
+#define DUEINDEX_H
+
+#include "../models/Task.h"
+#include <string>
+#include <set>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include <ctime>
+
+/**
+ * Échéancier des tâches non terminées, toutes utilisateurs confondus : un ensemble ordonné par échéance
+ * (tas avec retrait arbitraire) dont la tête donne la prochaine tâche à échoir. Avancer l'échéancier ne
+ * visite que les tâches échues, si bien que détecter les échéances coûte O(log n) par tâche échue au lieu
+ * d'un parcours complet. Une tâche n'est annoncée qu'une fois par échéance : modifier son échéance vers
+ * le futur la réarme, la terminer ou la supprimer la retire.
+ */
+class DueIndex {
+private:
+    std::set<std::pair<time_t, std::string>> pending;  // (échéance, identifiant) des tâches non encore échues
+    std::unordered_map<std::string, time_t> armed;     // Identifiant de tâche -> échéance programmée
+    time_t firedUntil;                                 // Les échéances antérieures ou égales ont été annoncées
+
+public:
+    /**
+     * Initialise un échéancier vide.
+     * now L'heure de départ : les échéances déjà passées ne sont pas annoncées.
+     */
+    explicit DueIndex(time_t now = std::time(nullptr)) : firedUntil(now) {}
+
+    /**
+     * Mettre à jour une tâche
+     * Programme la tâche si elle n'est pas terminée et que son échéance n'a pas encore été annoncée ;
+     * sinon la retire.
+     * task La tâche insérée ou modifiée.
+     */
+    void update(const Task& task);
+
+    /**
+     * Retirer une tâche
+     * taskId L'identifiant de la tâche supprimée.
+     */
+    void erase(const std::string& taskId);
+
+    /**
+     * Avancer
+     * Retire de l'échéancier les tâches échues à l'heure donnée, dans l'ordre des échéances.
+     * now L'heure courante.
+     * due Reçoit les identifiants des tâches échues.
+     */
+    void advance(time_t now, std::vector<std::string>& due);
+
+    /**
+     * Obtenir la taille
+     * Retourne Le nombre de tâches programmées.
+     */
+    size_t getSize() const { return pending.size(); }
+
+    /**
+     * Prochaine échéance
+     * Retourne L'échéance la plus proche parmi les tâches programmées, ou 0 s'il n'y en a aucune.
+     */
+    time_t nextDue() const { return pending.empty() ? 0 : pending.begin()->first; }
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include "MPMCQueue.h"
+#include "../models/QueueEntry.h"
+#include <string>
+#include <utility>
+
+/**
+ * Constructeur
+ * Alloue le tableau circulaire et initialise le numéro de séquence de chaque case à son indice,
+ * ce qui la marque comme libre pour le premier tour d'écriture.
+ * capacity La capacité souhaitée, arrondie à la puissance de deux supérieure (au moins 2).
+ */
+template<typename T>
+MPMCQueue<T>::MPMCQueue(std::size_t capacity) : enqueuePos(0), dequeuePos(0) {
+    std::size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    buffer.reset(new Cell[rounded]);
+    mask = rounded - 1;
+
+    for (std::size_t i = 0; i < rounded; i++) {
+        buffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Essayer d'enfiler
+ * Réserve la position d'écriture par compare-and-swap lorsque la case ciblée est libre pour ce tour,
+ * écrit la donnée puis publie la case en avançant son numéro de séquence.
+ * data L'élément à ajouter.
+ * Retourne true si l'élément a été ajouté, false si la file est pleine.
+ */
+template<typename T>
+bool MPMCQueue<T>::tryEnqueue(const T& data) {
+    Cell* cell;
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &buffer[pos & mask];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->data = data;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Essayer de défiler
+ * Réserve la position de lecture par compare-and-swap lorsque la case ciblée a été publiée,
+ * lit la donnée puis libère la case pour le tour d'écriture suivant.
+ * out Reçoit l'élément retiré.
+ * Retourne true si un élément a été retiré, false si la file est vide.
+ */
+template<typename T>
+bool MPMCQueue<T>::tryDequeue(T& out) {
+    Cell* cell;
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &buffer[pos & mask];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+        if (diff == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    out = std::move(cell->data);
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Enfiler
+ * Ajoute un élément à l'arrière de la file. Lève une exception si la file est pleine.
+ * data L'élément à ajouter.
+ */
+template<typename T>
+void MPMCQueue<T>::enqueue(T data) {
+    if (!tryEnqueue(data)) {
+        throw std::runtime_error("Queue is full");
+    }
+}
+
+/**
+ * Défiler
+ * Retire et retourne l'élément situé à l'avant de la file. Lève une exception si la file est vide.
+ * Retourne L'élément retiré.
+ */
+template<typename T>
+T MPMCQueue<T>::dequeue() {
+    T data;
+    if (!tryDequeue(data)) {
+        throw std::runtime_error("Queue is empty");
+    }
+    return data;
+}
+
+/**
+ * Enfiler plusieurs éléments
+ * Enfile les éléments un à un : chacun est publié dès qu'il est écrit ; lève une exception si la file se remplit.
+ * items Les éléments à ajouter.
+ */
+template<typename T>
+void MPMCQueue<T>::enqueueMany(const std::vector<T>& items) {
+    for (const T& item : items) {
+        enqueue(item);
+    }
+}
+
+/**
+ * Défiler plusieurs éléments
+ * Défile sans bloquer jusqu'à 'count' éléments ou jusqu'à ce que la file soit vide.
+ * count Le nombre maximal d'éléments à retirer.
+ * out Reçoit les éléments retirés, dans l'ordre de sortie.
+ * Retourne Le nombre d'éléments retirés.
+ */
+template<typename T>
+int MPMCQueue<T>::dequeueMany(int count, std::vector<T>& out) {
+    int removed = 0;
+    T data;
+    while (removed < count && tryDequeue(data)) {
+        out.push_back(std::move(data));
+        removed++;
+    }
+    return removed;
+}
+
+/**
+ * Obtenir la taille
+ * Calcule la différence entre les positions d'écriture et de lecture.
+ * Retourne La taille de la file.
+ */
+template<typename T>
+int MPMCQueue<T>::getSize() const {
+    std::size_t tail = enqueuePos.load(std::memory_order_acquire);
+    std::size_t head = dequeuePos.load(std::memory_order_acquire);
+    return tail > head ? static_cast<int>(tail - head) : 0;
+}
+
+/**
+ * Nettoyer
+ * Défile tous les éléments jusqu'à ce que la file soit vide.
+ */
+template<typename T>
+void MPMCQueue<T>::clear() {
+    T discarded;
+    while (tryDequeue(discarded)) {}
+}
+
+// Instanciation explicite des types supportés
+template class MPMCQueue<std::string>;
+template class MPMCQueue<int>;
+template class MPMCQueue<QueueEntry>;
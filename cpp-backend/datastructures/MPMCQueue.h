@@ -0,0 +1,121 @@
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Taille supposée d'une ligne de cache, utilisée pour éviter le faux partage entre threads.
+ */
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * Implémentation d'une File bornée sans verrou, multi-producteurs et multi-consommateurs (MPMC),
+ * sur un tableau circulaire préalloué. Chaque case porte un numéro de séquence qui indique si elle est
+ * prête à être écrite ou lue ; les indices de tête et de queue et chaque case sont alignés sur une ligne
+ * de cache. Aucune allocation n'a lieu après la construction.
+ * Reprend de Queue<T> l'enfilement et le défilement (unitaires et par lots), la taille et le nettoyage, avec en
+ * plus des variantes non bloquantes (tryEnqueue/tryDequeue). Il n'y a ni peek ni parcours (ConstIterator) :
+ * sous accès concurrents, l'élément consulté peut être retiré par un autre thread avant d'être lu.
+ */
+template<typename T>
+class MPMCQueue {
+private:
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> buffer;
+    std::size_t mask;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueuePos;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeuePos;
+
+public:
+    /**
+     * Initialise une file vide.
+     * capacity La capacité souhaitée, arrondie à la puissance de deux supérieure.
+     */
+    explicit MPMCQueue(std::size_t capacity = 1024);
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    /**
+     * Essayer d'enfiler
+     * Ajoute un élément à l'arrière de la file sans bloquer.
+     * data L'élément à ajouter.
+     * Retourne true si l'élément a été ajouté, false si la file est pleine.
+     */
+    bool tryEnqueue(const T& data);
+
+    /**
+     * Essayer de défiler
+     * Retire l'élément situé à l'avant de la file sans bloquer.
+     * out Reçoit l'élément retiré.
+     * Retourne true si un élément a été retiré, false si la file est vide.
+     */
+    bool tryDequeue(T& out);
+
+    /**
+     * Enfiler
+     * Ajoute un élément à l'arrière de la file. Lève une exception si la file est pleine.
+     * data L'élément à ajouter.
+     */
+    void enqueue(T data);
+
+    /**
+     * Défiler
+     * Retire et retourne l'élément situé à l'avant de la file. Lève une exception si la file est vide.
+     * Retourne L'élément retiré.
+     */
+    T dequeue();
+
+    /**
+     * Enfiler plusieurs éléments
+     * Ajoute les éléments à l'arrière de la file dans l'ordre donné. Lève une exception si la file se remplit ;
+     * les éléments déjà ajoutés y restent.
+     * items Les éléments à ajouter.
+     */
+    void enqueueMany(const std::vector<T>& items);
+
+    /**
+     * Défiler plusieurs éléments
+     * Retire au plus 'count' éléments de l'avant de la file et les ajoute à 'out' ; s'arrête dès que la file est vide.
+     * count Le nombre maximal d'éléments à retirer.
+     * out Reçoit les éléments retirés, dans l'ordre de sortie.
+     * Retourne Le nombre d'éléments retirés.
+     */
+    int dequeueMany(int count, std::vector<T>& out);
+
+    /**
+     * Est vide
+     * Vérifie si la file ne contient aucun élément (valeur indicative en présence d'accès concurrents).
+     * Retourne Vrai si la file est vide, Faux sinon.
+     */
+    bool isEmpty() const { return getSize() == 0; }
+
+    /**
+     * Obtenir la taille
+     * Retourne le nombre d'éléments dans la file (valeur indicative en présence d'accès concurrents).
+     * Retourne La taille de la file.
+     */
+    int getSize() const;
+
+    /**
+     * Obtenir la capacité
+     * Retourne Le nombre maximal d'éléments que la file peut contenir.
+     */
+    std::size_t getCapacity() const { return mask + 1; }
+
+    /**
+     * Nettoyer
+     * Retire tous les éléments de la file.
+     */
+    void clear();
+};
+
+#endif
@@ -0,0 +1,168 @@
+#include "PersistentTaskVector.h"
+#include <bitset>
+
+/**
+ * Rang d'un bit
+ * Retourne Le nombre de bits occupés avant 'bit', c'est-à-dire l'indice de sa case dans le nœud.
+ */
+static size_t rankOf(uint32_t bitmap, uint32_t bit) {
+    return std::bitset<32>(bitmap & (bit - 1)).count();
+}
+
+/**
+ * Écrire dans un sous-arbre
+ * node Le nœud (nullptr pour un sous-arbre vide).
+ * level Le décalage du niveau du nœud.
+ * index La position.
+ * task La tâche.
+ * added Reçoit true si la case était vide.
+ * Retourne Le nouveau nœud.
+ */
+std::shared_ptr<const PersistentTaskVector::Node> PersistentTaskVector::setIn(
+        const std::shared_ptr<const Node>& node, unsigned level, uint64_t index, const Task* task, bool& added) {
+    std::shared_ptr<Node> copy = node ? std::make_shared<Node>(*node) : std::make_shared<Node>();
+    uint32_t bit = 1u << ((index >> level) & MASK);
+    size_t rank = rankOf(copy->bitmap, bit);
+    bool present = (copy->bitmap & bit) != 0;
+
+    if (level == 0) {
+        if (present) {
+            copy->items[rank] = task;
+        } else {
+            copy->items.insert(copy->items.begin() + rank, task);
+            added = true;
+        }
+    } else {
+        std::shared_ptr<const Node> child = present ? copy->children[rank] : nullptr;
+        std::shared_ptr<const Node> updated = setIn(child, level - BITS, index, task, added);
+        if (present) {
+            copy->children[rank] = std::move(updated);
+        } else {
+            copy->children.insert(copy->children.begin() + rank, std::move(updated));
+        }
+    }
+
+    copy->bitmap |= bit;
+    return copy;
+}
+
+/**
+ * Effacer dans un sous-arbre
+ * node Le nœud (nullptr pour un sous-arbre vide).
+ * level Le décalage du niveau du nœud.
+ * index La position.
+ * removed Reçoit true si la case était occupée.
+ * Retourne Le nouveau nœud (le même si rien n'a changé, nullptr s'il devient vide).
+ */
+std::shared_ptr<const PersistentTaskVector::Node> PersistentTaskVector::eraseIn(
+        const std::shared_ptr<const Node>& node, unsigned level, uint64_t index, bool& removed) {
+    if (!node) return node;
+    uint32_t bit = 1u << ((index >> level) & MASK);
+    if (!(node->bitmap & bit)) return node;
+    size_t rank = rankOf(node->bitmap, bit);
+
+    std::shared_ptr<const Node> updated;
+    if (level > 0) {
+        updated = eraseIn(node->children[rank], level - BITS, index, removed);
+        if (!removed) return node;
+    }
+    removed = true;
+
+    std::shared_ptr<Node> copy = std::make_shared<Node>(*node);
+    if (level == 0) {
+        copy->items.erase(copy->items.begin() + rank);
+    } else if (updated) {
+        copy->children[rank] = std::move(updated);
+        return copy;
+    } else {
+        copy->children.erase(copy->children.begin() + rank);
+    }
+
+    copy->bitmap &= ~bit;
+    if (copy->bitmap == 0) return nullptr;
+    return copy;
+}
+
+/**
+ * Parcourir un sous-arbre
+ * node Le nœud.
+ * level Le décalage du niveau du nœud.
+ * visit La fonction appelée pour chaque tâche.
+ */
+void PersistentTaskVector::visitNode(const Node& node, unsigned level, const std::function<void(const Task&)>& visit) {
+    if (level == 0) {
+        for (const Task* task : node.items) visit(*task);
+        return;
+    }
+    for (const std::shared_ptr<const Node>& child : node.children) {
+        visitNode(*child, level - BITS, visit);
+    }
+}
+
+/**
+ * Écrire
+ * Ajoute des niveaux au-dessus de la racine tant que la position dépasse la capacité, puis recopie le
+ * chemin jusqu'à la case.
+ * position La position.
+ * task La tâche.
+ * Retourne Le nouveau vecteur.
+ */
+PersistentTaskVector PersistentTaskVector::set(uint64_t position, const Task* task) const {
+    std::shared_ptr<const Node> top = root;
+    unsigned level = root ? shift : 0;
+
+    while (level + BITS < 64 && (position >> (level + BITS)) != 0) {
+        if (top) {
+            std::shared_ptr<Node> parent = std::make_shared<Node>();
+            parent->bitmap = 1;
+            parent->children.push_back(std::move(top));
+            top = std::move(parent);
+        }
+        level += BITS;
+    }
+
+    bool added = false;
+    top = setIn(top, level, position, task, added);
+    return PersistentTaskVector(std::move(top), level, added ? count + 1 : count);
+}
+
+/**
+ * Effacer
+ * position La position.
+ * Retourne Le nouveau vecteur (qui partage la racine de celui-ci si la case était déjà vide).
+ */
+PersistentTaskVector PersistentTaskVector::erase(uint64_t position) const {
+    if (!root || (shift + BITS < 64 && (position >> (shift + BITS)) != 0)) return *this;
+
+    bool removed = false;
+    std::shared_ptr<const Node> top = eraseIn(root, shift, position, removed);
+    if (!removed) return *this;
+    if (!top) return PersistentTaskVector();
+    return PersistentTaskVector(std::move(top), shift, count - 1);
+}
+
+/**
+ * Lire
+ * position La position.
+ * Retourne La tâche, ou nullptr si la case est vide.
+ */
+const Task* PersistentTaskVector::get(uint64_t position) const {
+    if (!root || (shift + BITS < 64 && (position >> (shift + BITS)) != 0)) return nullptr;
+
+    const Node* node = root.get();
+    for (unsigned level = shift;; level -= BITS) {
+        uint32_t bit = 1u << ((position >> level) & MASK);
+        if (!(node->bitmap & bit)) return nullptr;
+        size_t rank = rankOf(node->bitmap, bit);
+        if (level == 0) return node->items[rank];
+        node = node->children[rank].get();
+    }
+}
+
+/**
+ * Parcourir
+ * visit La fonction appelée pour chaque tâche, dans l'ordre des positions.
+ */
+void PersistentTaskVector::forEach(const std::function<void(const Task&)>& visit) const {
+    if (root) visitNode(*root, shift, visit);
+}
@@ -0,0 +1,111 @@
+#ifndef PERSISTENTTASKVECTOR_H
+#define PERSISTENTTASKVECTOR_H
+
+#include "../models/Task.h"
+#include <memory>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Vecteur persistant de tâches : trie à 32 branches indexé par position, dont les nœuds ne stockent que
+ * les cases occupées (masque de bits, comme un HAMT). Les nœuds sont immuables et partagés : une écriture
+ * recopie seulement le chemin de la racine à la feuille (O(log32 n)) et rend un nouveau vecteur, l'ancien
+ * restant intact. Copier un vecteur est donc un instantané en O(1) ; les nœuds qui ne sont plus référencés
+ * par aucune version sont libérés automatiquement.
+ * Les positions retirées laissent un trou élagué : le parcours suit l'ordre croissant des positions.
+ */
+class PersistentTaskVector {
+private:
+    static const unsigned BITS = 5;
+    static const unsigned MASK = (1u << BITS) - 1;
+
+    /**
+     * Nœud immuable. Une feuille (niveau 0) porte des tâches, un nœud interne des enfants, dans l'ordre
+     * des bits de 'bitmap'.
+     */
+    struct Node {
+        uint32_t bitmap = 0;
+        std::vector<std::shared_ptr<const Node>> children;
+        std::vector<const Task*> items;
+    };
+
+    std::shared_ptr<const Node> root;
+    unsigned shift;  // Décalage du niveau de la racine (0 : la racine est une feuille)
+    size_t count;
+
+    PersistentTaskVector(std::shared_ptr<const Node> root, unsigned shift, size_t count)
+        : root(std::move(root)), shift(shift), count(count) {}
+
+    /**
+     * Écrire dans un sous-arbre
+     * Recopie le nœud et, récursivement, le chemin jusqu'à la case 'index'.
+     * added Reçoit true si la case était vide.
+     * Retourne Le nouveau nœud.
+     */
+    static std::shared_ptr<const Node> setIn(const std::shared_ptr<const Node>& node, unsigned level,
+                                             uint64_t index, const Task* task, bool& added);
+
+    /**
+     * Effacer dans un sous-arbre
+     * removed Reçoit true si la case était occupée.
+     * Retourne Le nouveau nœud (le même si rien n'a changé, nullptr s'il devient vide).
+     */
+    static std::shared_ptr<const Node> eraseIn(const std::shared_ptr<const Node>& node, unsigned level,
+                                               uint64_t index, bool& removed);
+
+    /**
+     * Parcourir un sous-arbre dans l'ordre des positions.
+     */
+    static void visitNode(const Node& node, unsigned level, const std::function<void(const Task&)>& visit);
+
+public:
+    /**
+     * Initialise un vecteur vide.
+     */
+    PersistentTaskVector() : shift(0), count(0) {}
+
+    /**
+     * Écrire
+     * position La position (quelconque, les trous sont permis).
+     * task La tâche à placer à cette position.
+     * Retourne Le nouveau vecteur ; celui-ci est inchangé.
+     */
+    PersistentTaskVector set(uint64_t position, const Task* task) const;
+
+    /**
+     * Effacer
+     * position La position à vider.
+     * Retourne Le nouveau vecteur ; celui-ci est inchangé.
+     */
+    PersistentTaskVector erase(uint64_t position) const;
+
+    /**
+     * Lire
+     * position La position.
+     * Retourne La tâche à cette position, ou nullptr si la case est vide.
+     */
+    const Task* get(uint64_t position) const;
+
+    /**
+     * Parcourir
+     * Appelle 'visit' sur chaque tâche, dans l'ordre croissant des positions.
+     * visit La fonction appelée pour chaque tâche.
+     */
+    void forEach(const std::function<void(const Task&)>& visit) const;
+
+    /**
+     * Obtenir la taille
+     * Retourne Le nombre de cases occupées.
+     */
+    size_t size() const { return count; }
+
+    /**
+     * Est vide
+     * Retourne Vrai si aucune case n'est occupée.
+     */
+    bool isEmpty() const { return count == 0; }
+};
+
+#endif
@@ -0,0 +1,178 @@
+#include "PriorityQueue.h"
+#include <utility>
+#include <queue>
+
+/**
+ * Comparer deux entrées
+ * Applique la politique d'ordonnancement. Pour AGING_POLICY, le score effectif
+ * priorité + attente / agingSeconds est équivalent à la clé fixe priorité * agingSeconds - enqueuedAt,
+ * ce qui permet de garder un tas valide sans jamais le réordonner avec le temps.
+ * Les égalités sont départagées par l'ordre d'arrivée.
+ */
+bool PriorityQueue::before(const QueueEntry& a, const QueueEntry& b) const {
+    switch (policy) {
+        case PRIORITY_POLICY:
+            if (a.priority != b.priority) return a.priority > b.priority;
+            break;
+
+        case DEADLINE_POLICY: {
+            // Une tâche sans échéance (0) passe après toutes les tâches datées
+            bool aDated = a.dueDate != 0;
+            bool bDated = b.dueDate != 0;
+            if (aDated != bDated) return aDated;
+            if (a.dueDate != b.dueDate) return a.dueDate < b.dueDate;
+            if (a.priority != b.priority) return a.priority > b.priority;
+            break;
+        }
+
+        case AGING_POLICY: {
+            long long aKey = static_cast<long long>(a.priority) * agingSeconds - static_cast<long long>(a.enqueuedAt);
+            long long bKey = static_cast<long long>(b.priority) * agingSeconds - static_cast<long long>(b.enqueuedAt);
+            if (aKey != bKey) return aKey > bKey;
+            break;
+        }
+
+        default:
+            break;
+    }
+    return a.sequence < b.sequence;
+}
+
+/**
+ * Remonter un élément
+ * Échange l'élément avec son parent tant qu'il doit sortir avant lui.
+ * index L'indice de l'élément à remonter.
+ */
+void PriorityQueue::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!before(heap[index], heap[parent])) break;
+        std::swap(heap[index], heap[parent]);
+        index = parent;
+    }
+}
+
+/**
+ * Descendre un élément
+ * Échange l'élément avec son meilleur enfant tant que celui-ci doit sortir avant lui.
+ * index L'indice de l'élément à descendre.
+ */
+void PriorityQueue::siftDown(size_t index) {
+    size_t count = heap.size();
+    while (true) {
+        size_t best = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+
+        if (left < count && before(heap[left], heap[best])) best = left;
+        if (right < count && before(heap[right], heap[best])) best = right;
+        if (best == index) break;
+
+        std::swap(heap[index], heap[best]);
+        index = best;
+    }
+}
+
+/**
+ * Insérer
+ * Ajoute l'entrée à la fin du tableau puis la remonte à sa place.
+ * entry L'entrée à ajouter.
+ */
+void PriorityQueue::push(const QueueEntry& entry) {
+    heap.push_back(entry);
+    siftUp(heap.size() - 1);
+}
+
+/**
+ * Insérer plusieurs entrées
+ * Ajoute les entrées à la fin du tableau. Lorsque le lot dépasse la taille actuelle du tas,
+ * une reconstruction complète (Floyd) est moins coûteuse que les remontées individuelles.
+ * items Les entrées à ajouter.
+ */
+void PriorityQueue::pushMany(const std::vector<QueueEntry>& items) {
+    size_t previous = heap.size();
+    heap.insert(heap.end(), items.begin(), items.end());
+
+    if (items.size() > previous) {
+        for (size_t i = heap.size() / 2; i-- > 0;) {
+            siftDown(i);
+        }
+    } else {
+        for (size_t i = previous; i < heap.size(); i++) {
+            siftUp(i);
+        }
+    }
+}
+
+/**
+ * Retirer
+ * Remplace la racine par le dernier élément puis le fait descendre. Lève une exception si le tas est vide.
+ * Retourne L'entrée prioritaire.
+ */
+QueueEntry PriorityQueue::pop() {
+    if (isEmpty()) {
+        throw std::runtime_error("Priority queue is empty");
+    }
+
+    QueueEntry top = std::move(heap.front());
+    heap.front() = std::move(heap.back());
+    heap.pop_back();
+
+    if (!heap.empty()) {
+        siftDown(0);
+    }
+    return top;
+}
+
+/**
+ * Regarder le sommet
+ * Retourne l'entrée prioritaire sans la retirer. Lève une exception si le tas est vide.
+ * Retourne L'entrée située à la racine du tas.
+ */
+const QueueEntry& PriorityQueue::peek() const {
+    if (isEmpty()) {
+        throw std::runtime_error("Priority queue is empty");
+    }
+    return heap.front();
+}
+
+/**
+ * Parcourir dans l'ordre
+ * Maintient une frontière (petit tas d'indices) initialisée avec la racine : l'indice extrait est le
+ * prochain dans l'ordre de sortie, et ses deux enfants rejoignent la frontière. La frontière ne dépasse
+ * jamais k + 1 indices pour k entrées visitées.
+ * visit La fonction appelée pour chaque entrée ; retourner false interrompt le parcours.
+ */
+void PriorityQueue::forEachInOrder(const std::function<bool(const QueueEntry&)>& visit) const {
+    if (heap.empty()) return;
+
+    auto after = [this](size_t a, size_t b) { return before(heap[b], heap[a]); };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(after)> frontier(after);
+    frontier.push(0);
+
+    while (!frontier.empty()) {
+        size_t index = frontier.top();
+        frontier.pop();
+
+        if (!visit(heap[index])) return;
+
+        size_t left = 2 * index + 1;
+        if (left < heap.size()) frontier.push(left);
+        if (left + 1 < heap.size()) frontier.push(left + 1);
+    }
+}
+
+/**
+ * Changer la politique
+ * Met à jour la politique puis reconstruit le tas de bas en haut (méthode de Floyd, O(n)).
+ * p La nouvelle politique.
+ * aging Le nombre de secondes d'attente équivalant à un niveau de priorité.
+ */
+void PriorityQueue::setPolicy(SchedulingPolicy p, int aging) {
+    policy = p;
+    agingSeconds = aging > 0 ? aging : 1;
+
+    for (size_t i = heap.size() / 2; i-- > 0;) {
+        siftDown(i);
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+#include "../models/QueueEntry.h"
+#include <vector>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * Implémentation d'une file de priorité (tas binaire) d'entrées de file de traitement.
+ * L'ordre est déterminé par la politique d'ordonnancement : l'insertion et le retrait coûtent O(log n),
+ * la consultation du prochain élément O(1).
+ */
+class PriorityQueue {
+private:
+    std::vector<QueueEntry> heap;
+    SchedulingPolicy policy;
+    int agingSeconds;
+
+    /**
+     * Comparer deux entrées
+     * Indique si l'entrée a doit sortir avant l'entrée b selon la politique courante.
+     */
+    bool before(const QueueEntry& a, const QueueEntry& b) const;
+
+    /**
+     * Remonter un élément
+     * Fait remonter l'élément à l'indice donné jusqu'à ce que la propriété de tas soit respectée.
+     */
+    void siftUp(size_t index);
+
+    /**
+     * Descendre un élément
+     * Fait descendre l'élément à l'indice donné jusqu'à ce que la propriété de tas soit respectée.
+     */
+    void siftDown(size_t index);
+
+public:
+    /**
+     * Initialise un tas vide.
+     * p La politique d'ordonnancement.
+     * aging Le nombre de secondes d'attente équivalant à un niveau de priorité (politique AGING_POLICY).
+     */
+    PriorityQueue(SchedulingPolicy p = PRIORITY_POLICY, int aging = 3600)
+        : policy(p), agingSeconds(aging > 0 ? aging : 1) {}
+
+    /**
+     * Insérer
+     * Ajoute une entrée dans le tas.
+     * entry L'entrée à ajouter.
+     */
+    void push(const QueueEntry& entry);
+
+    /**
+     * Insérer plusieurs entrées
+     * Ajoute un lot d'entrées. Si le lot est grand par rapport au tas, celui-ci est reconstruit en O(n + k)
+     * au lieu de k insertions en O(log n).
+     * items Les entrées à ajouter.
+     */
+    void pushMany(const std::vector<QueueEntry>& items);
+
+    /**
+     * Retirer
+     * Retire et retourne l'entrée prioritaire. Lève une exception si le tas est vide.
+     * Retourne L'entrée retirée.
+     */
+    QueueEntry pop();
+
+    /**
+     * Regarder le sommet (Peek)
+     * Retourne l'entrée prioritaire sans la retirer. Lève une exception si le tas est vide.
+     * Retourne L'entrée prioritaire.
+     */
+    const QueueEntry& peek() const;
+
+    /**
+     * Changer la politique
+     * Modifie la politique d'ordonnancement et reconstruit le tas en O(n).
+     * p La nouvelle politique.
+     * aging Le nombre de secondes d'attente équivalant à un niveau de priorité.
+     */
+    void setPolicy(SchedulingPolicy p, int aging);
+
+    /**
+     * Parcourir dans l'ordre
+     * Visite les entrées dans leur ordre de sortie sans modifier ni copier le tas. Visiter les k premières
+     * entrées coûte O(k log k). Le parcours s'arrête dès que 'visit' retourne false.
+     * visit La fonction appelée pour chaque entrée.
+     */
+    void forEachInOrder(const std::function<bool(const QueueEntry&)>& visit) const;
+
+    /**
+     * Obtenir les entrées
+     * Retourne le tableau sous-jacent du tas (ordre de tas, non trié).
+     */
+    const std::vector<QueueEntry>& entries() const { return heap; }
+
+    /**
+     * Est vide
+     * Retourne Vrai si le tas ne contient aucune entrée, Faux sinon.
+     */
+    bool isEmpty() const { return heap.empty(); }
+
+    /**
+     * Obtenir la taille
+     * Retourne Le nombre d'entrées dans le tas.
+     */
+    int getSize() const { return static_cast<int>(heap.size()); }
+
+    /**
+     * Nettoyer
+     * Supprime toutes les entrées du tas.
+     */
+    void clear() { heap.clear(); }
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "Queue.h"
+#include "../models/QueueEntry.h"
 
 /**
  * Destructeur
@@ -53,6 +54,59 @@ T Queue<T>::dequeue() {
     return data;
 }
 
+/**
+ * Enfiler plusieurs éléments
+ * Construit d'abord la chaîne des nouveaux nœuds, puis la raccorde à l'arrière de la file
+ * et met à jour la taille une seule fois.
+ * items Les éléments à ajouter.
+ */
+template<typename T>
+void Queue<T>::enqueueMany(const std::vector<T>& items) {
+    if (items.empty()) return;
+
+    Node* first = new Node(items[0]);
+    Node* last = first;
+    for (size_t i = 1; i < items.size(); i++) {
+        last->next = new Node(items[i]);
+        last = last->next;
+    }
+
+    if (isEmpty()) {
+        front = first;
+    } else {
+        rear->next = first;
+    }
+    rear = last;
+    size += static_cast<int>(items.size());
+}
+
+/**
+ * Défiler plusieurs éléments
+ * Détache au plus 'count' nœuds de l'avant de la file en un seul parcours.
+ * count Le nombre maximal d'éléments à retirer.
+ * out Reçoit les éléments retirés, dans l'ordre de sortie.
+ * Retourne Le nombre d'éléments retirés.
+ */
+template<typename T>
+int Queue<T>::dequeueMany(int count, std::vector<T>& out) {
+    int removed = 0;
+
+    while (front && removed < count) {
+        Node* temp = front;
+        out.push_back(temp->data);
+        front = front->next;
+        delete temp;
+        removed++;
+    }
+
+    if (!front) {
+        rear = nullptr;
+    }
+    size -= removed;
+
+    return removed;
+}
+
 /**
  * Regarder l'avant
  * Retourne l'élément situé à l'avant (front) de la file sans le retirer. Lève une exception si la file est vide.
@@ -79,4 +133,5 @@ void Queue<T>::clear() {
 
 // Instanciation explicite des types supportés
 template class Queue<std::string>;
-template class Queue<int>;
\ No newline at end of file
+template class Queue<int>;
+template class Queue<QueueEntry>;
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define QUEUE_H
 
 #include <string>
+#include <vector>
 #include <stdexcept>
 
 /**
@@ -25,6 +26,27 @@ private:
     int size;
 
 public:
+    /**
+     * Itérateur en lecture seule parcourant la file de l'avant vers l'arrière, sans la copier.
+     */
+    class ConstIterator {
+    private:
+        const Node* current;
+
+    public:
+        /**
+         * Initialise l'itérateur sur un nœud donné.
+         * node Le nœud de départ (nullptr pour la fin).
+         */
+        explicit ConstIterator(const Node* node) : current(node) {}
+
+        const T& operator*() const { return current->data; }
+        const T* operator->() const { return &current->data; }
+        ConstIterator& operator++() { current = current->next; return *this; }
+        bool operator!=(const ConstIterator& other) const { return current != other.current; }
+        bool operator==(const ConstIterator& other) const { return current == other.current; }
+    };
+
     /**
      * Initialise la file vide.
      */
@@ -49,6 +71,22 @@ public:
      */
     T dequeue();
     
+    /**
+     * Enfiler plusieurs éléments
+     * Ajoute les éléments à l'arrière de la file dans l'ordre donné, en un seul raccordement.
+     * items Les éléments à ajouter.
+     */
+    void enqueueMany(const std::vector<T>& items);
+
+    /**
+     * Défiler plusieurs éléments
+     * Retire au plus 'count' éléments de l'avant de la file et les ajoute à 'out'.
+     * count Le nombre maximal d'éléments à retirer.
+     * out Reçoit les éléments retirés, dans l'ordre de sortie.
+     * Retourne Le nombre d'éléments retirés.
+     */
+    int dequeueMany(int count, std::vector<T>& out);
+
     /**
      * Regarder l'avant (Peek)
      * Retourne l'élément situé à l'avant de la file sans le retirer.
@@ -70,6 +108,24 @@ public:
      */
     int getSize() const { return size; }
     
+    /**
+     * Début du parcours
+     * Retourne Un itérateur sur l'élément situé à l'avant de la file.
+     */
+    ConstIterator begin() const { return ConstIterator(front); }
+
+    /**
+     * Fin du parcours
+     * Retourne Un itérateur marquant la fin de la file.
+     */
+    ConstIterator end() const { return ConstIterator(nullptr); }
+
+    /**
+     * Dernier élément
+     * Retourne Un itérateur sur l'élément situé à l'arrière de la file (la fin si elle est vide).
+     */
+    ConstIterator last() const { return ConstIterator(rear); }
+
     /**
      * Supprime tous les éléments de la file et libère la mémoire.
      */
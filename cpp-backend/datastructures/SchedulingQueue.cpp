@@ -0,0 +1,250 @@
+#include "SchedulingQueue.h"
+#include <algorithm>
+#include <vector>
+
+/**
+ * Enfiler
+ * Construit une entrée à partir de la tâche et l'ajoute à la structure correspondant à la politique courante.
+ * task La tâche à mettre en file.
+ * Retourne L'entrée créée.
+ */
+QueueEntry SchedulingQueue::enqueue(const Task& task) {
+    QueueEntry entry(task.getId(), task.getPriority(), task.getDueDate(), std::time(nullptr), nextSequence++);
+    insert(entry);
+    return entry;
+}
+
+/**
+ * Enfiler plusieurs tâches
+ * Construit toutes les entrées avec la même heure de mise en file, puis les transmet en un seul lot
+ * à la File ou au tas.
+ * tasks Les tâches à mettre en file.
+ * Retourne Les entrées créées.
+ */
+std::vector<QueueEntry> SchedulingQueue::enqueueMany(const std::vector<Task*>& tasks) {
+    std::vector<QueueEntry> entries;
+    entries.reserve(tasks.size());
+
+    time_t now = std::time(nullptr);
+    for (const Task* task : tasks) {
+        entries.emplace_back(task->getId(), task->getPriority(), task->getDueDate(), now, nextSequence++);
+    }
+
+    if (policy == FIFO_POLICY) {
+        // Les nouveaux nœuds suivent l'ancien arrière de la File
+        Queue<QueueEntry>::ConstIterator node = fifo.last();
+        fifo.enqueueMany(entries);
+        node = node == fifo.end() ? fifo.begin() : ++node;
+        for (const QueueEntry& entry : entries) {
+            locators.insert_or_assign(entry.sequence, Locator{fifoTickets++, node});
+            queuedTasks[entry.taskId]++;
+            ++node;
+        }
+    } else {
+        scheduled.pushMany(entries);
+        for (const QueueEntry& entry : entries) {
+            locators.insert_or_assign(entry.sequence, Locator{0, fifo.end()});
+            queuedTasks[entry.taskId]++;
+        }
+    }
+    return entries;
+}
+
+/**
+ * Remettre en file
+ * Réinsère l'entrée telle quelle dans la structure correspondant à la politique courante.
+ * entry L'entrée à réinsérer.
+ */
+void SchedulingQueue::requeue(const QueueEntry& entry) {
+    insert(entry);
+}
+
+/**
+ * Insérer
+ * En mode FIFO, l'entrée reçoit le rang d'arrivée suivant et son nœud (le nouvel arrière de la File) est
+ * retenu ; dans un tas, où les entrées se déplacent, seule sa présence est retenue.
+ * entry L'entrée à insérer.
+ */
+void SchedulingQueue::insert(const QueueEntry& entry) {
+    if (policy == FIFO_POLICY) {
+        fifo.enqueue(entry);
+        locators.insert_or_assign(entry.sequence, Locator{fifoTickets++, fifo.last()});
+    } else {
+        scheduled.push(entry);
+        locators.insert_or_assign(entry.sequence, Locator{0, fifo.end()});
+    }
+    queuedTasks[entry.taskId]++;
+}
+
+/**
+ * Oublier
+ * En mode FIFO, l'entrée sort par l'avant : le compteur de sorties avance, ce qui décale d'autant la
+ * position des entrées restantes.
+ * entry L'entrée retirée.
+ */
+void SchedulingQueue::forget(const QueueEntry& entry) {
+    locators.erase(entry.sequence);
+    auto count = queuedTasks.find(entry.taskId);
+    if (count != queuedTasks.end() && --count->second == 0) {
+        queuedTasks.erase(count);
+    }
+    if (policy == FIFO_POLICY) {
+        fifoDequeued++;
+    }
+}
+
+/**
+ * Défiler
+ * Retire la prochaine entrée de la file FIFO ou du tas selon la politique courante.
+ * Retourne L'entrée retirée.
+ */
+QueueEntry SchedulingQueue::dequeue() {
+    QueueEntry entry = policy == FIFO_POLICY ? fifo.dequeue() : scheduled.pop();
+    forget(entry);
+    return entry;
+}
+
+/**
+ * Restaurer une entrée
+ * Réinsère l'entrée puis avance le compteur d'arrivée au-delà de son numéro.
+ * entry L'entrée à restaurer.
+ */
+void SchedulingQueue::restore(const QueueEntry& entry) {
+    requeue(entry);
+    if (entry.sequence >= nextSequence) {
+        nextSequence = entry.sequence + 1;
+    }
+}
+
+/**
+ * Défiler plusieurs entrées
+ * Retire les entrées en un seul lot depuis la File, ou successivement depuis le tas.
+ * count Le nombre maximal d'entrées à retirer.
+ * out Reçoit les entrées retirées, dans l'ordre de sortie.
+ * Retourne Le nombre d'entrées retirées.
+ */
+int SchedulingQueue::dequeueMany(int count, std::vector<QueueEntry>& out) {
+    size_t first = out.size();
+    int removed = 0;
+
+    if (policy == FIFO_POLICY) {
+        removed = fifo.dequeueMany(count, out);
+    } else {
+        while (removed < count && !scheduled.isEmpty()) {
+            out.push_back(scheduled.pop());
+            removed++;
+        }
+    }
+
+    for (size_t i = first; i < out.size(); i++) {
+        forget(out[i]);
+    }
+    return removed;
+}
+
+/**
+ * Regarder l'avant
+ * Retourne la prochaine entrée sans la retirer.
+ * Retourne L'entrée suivante.
+ */
+QueueEntry SchedulingQueue::peek() const {
+    if (policy == FIFO_POLICY) {
+        return fifo.peek();
+    }
+    return scheduled.peek();
+}
+
+/**
+ * Parcourir dans l'ordre
+ * En mode FIFO, suit les nœuds de la File de l'avant vers l'arrière ; sinon délègue au parcours ordonné du tas.
+ * visit La fonction appelée pour chaque entrée ; retourner false interrompt le parcours.
+ */
+void SchedulingQueue::forEachInOrder(const std::function<bool(const QueueEntry&)>& visit) const {
+    if (policy == FIFO_POLICY) {
+        for (const QueueEntry& entry : fifo) {
+            if (!visit(entry)) return;
+        }
+        return;
+    }
+    scheduled.forEachInOrder(visit);
+}
+
+/**
+ * Parcourir après une entrée
+ * En mode FIFO, le repère donne directement le nœud de l'entrée et sa position (rang d'arrivée moins
+ * le nombre de sorties) ; seules les entrées visitées sont parcourues. Dans un tas, l'ordre de sortie
+ * n'existe qu'au parcours : celui-ci repart de l'avant jusqu'à l'entrée repère.
+ * sequence Le numéro d'ordre de l'entrée repère.
+ * visit La fonction appelée pour chaque entrée suivante ; retourner false interrompt le parcours.
+ * Retourne La position de l'entrée repère, ou -1 si elle n'est plus dans la file.
+ */
+int SchedulingQueue::forEachAfter(long long sequence, const std::function<bool(const QueueEntry&)>& visit) const {
+    auto found = locators.find(sequence);
+    if (found == locators.end()) return -1;
+
+    if (policy == FIFO_POLICY) {
+        Queue<QueueEntry>::ConstIterator node = found->second.node;
+        for (++node; node != fifo.end(); ++node) {
+            if (!visit(*node)) break;
+        }
+        return static_cast<int>(found->second.ticket - fifoDequeued + 1);
+    }
+
+    int position = 0;
+    int anchor = -1;
+    scheduled.forEachInOrder([&](const QueueEntry& entry) {
+        if (anchor >= 0) return visit(entry);
+        position++;
+        if (entry.sequence == sequence) anchor = position;
+        return true;
+    });
+    return anchor;
+}
+
+/**
+ * Changer la politique
+ * Si l'on reste sur un mode à tas, le tas est simplement reconstruit. Sinon les entrées sont transférées :
+ * vers le tas en O(n log n), ou vers la File dans leur ordre d'arrivée d'origine.
+ * p La nouvelle politique.
+ * aging Le nombre de secondes d'attente équivalant à un niveau de priorité.
+ */
+void SchedulingQueue::setPolicy(SchedulingPolicy p, int aging) {
+    agingSeconds = aging > 0 ? aging : 1;
+
+    if (p == FIFO_POLICY) {
+        if (policy != FIFO_POLICY) {
+            std::vector<QueueEntry> pending = scheduled.entries();
+            scheduled.clear();
+            std::sort(pending.begin(), pending.end(), [](const QueueEntry& a, const QueueEntry& b) {
+                return a.sequence < b.sequence;
+            });
+            for (const QueueEntry& entry : pending) {
+                fifo.enqueue(entry);
+                locators.insert_or_assign(entry.sequence, Locator{fifoTickets++, fifo.last()});
+            }
+        }
+        policy = p;
+        return;
+    }
+
+    scheduled.setPolicy(p, agingSeconds);
+    while (!fifo.isEmpty()) {
+        QueueEntry entry = fifo.dequeue();
+        scheduled.push(entry);
+        locators.insert_or_assign(entry.sequence, Locator{0, fifo.end()});
+        fifoDequeued++;
+    }
+    policy = p;
+}
+
+/**
+ * Nettoyer
+ * Vide la File, le tas et les repères.
+ */
+void SchedulingQueue::clear() {
+    fifo.clear();
+    scheduled.clear();
+    locators.clear();
+    queuedTasks.clear();
+    fifoDequeued = fifoTickets;
+}
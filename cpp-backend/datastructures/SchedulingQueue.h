@@ -0,0 +1,191 @@
+#ifndef SCHEDULINGQUEUE_H
+#define SCHEDULINGQUEUE_H
+
+#include "../models/QueueEntry.h"
+#include "Queue.h"
+#include "PriorityQueue.h"
+#include <string>
+#include <unordered_map>
+
+/**
+ * File de traitement d'un utilisateur avec une politique d'ordonnancement configurable.
+ * En mode FIFO, les entrées sont stockées dans une File (O(1)) ; pour les autres politiques,
+ * elles sont stockées dans un tas binaire (O(log n)).
+ * Chaque entrée présente est repérée par son numéro d'ordre, ce qui permet de reprendre un parcours
+ * après elle (curseur de pagination) et de savoir si une tâche est déjà en file.
+ */
+class SchedulingQueue {
+private:
+    /**
+     * Repère d'une entrée présente. En mode FIFO : son rang d'arrivée dans la File et son nœud.
+     */
+    struct Locator {
+        long long ticket;
+        Queue<QueueEntry>::ConstIterator node;
+    };
+
+    SchedulingPolicy policy;
+    int agingSeconds;
+    long long nextSequence;
+    Queue<QueueEntry> fifo;
+    PriorityQueue scheduled;
+
+    std::unordered_map<long long, Locator> locators;   // Entrées présentes, par numéro d'ordre
+    std::unordered_map<std::string, int> queuedTasks; // Nombre d'entrées présentes par tâche
+    long long fifoTickets;  // Entrées placées à l'arrière de la File depuis sa création
+    long long fifoDequeued; // Entrées retirées de l'avant de la File depuis sa création
+
+    /**
+     * Insérer
+     * Place une entrée dans la structure de la politique courante et la repère.
+     * entry L'entrée à insérer.
+     */
+    void insert(const QueueEntry& entry);
+
+    /**
+     * Oublier
+     * Retire le repère d'une entrée qui vient de sortir de la file.
+     * entry L'entrée retirée.
+     */
+    void forget(const QueueEntry& entry);
+
+public:
+    /**
+     * Initialise une file vide en mode FIFO.
+     */
+    SchedulingQueue() : policy(FIFO_POLICY), agingSeconds(3600), nextSequence(0), fifoTickets(0), fifoDequeued(0) {}
+
+    /**
+     * Enfiler
+     * Ajoute une tâche à la file en figeant sa priorité et son échéance.
+     * task La tâche à mettre en file.
+     * Retourne L'entrée créée.
+     */
+    QueueEntry enqueue(const Task& task);
+
+    /**
+     * Enfiler plusieurs tâches
+     * Ajoute un lot de tâches dans l'ordre donné, avec des numéros d'arrivée consécutifs.
+     * tasks Les tâches à mettre en file.
+     * Retourne Les entrées créées, dans l'ordre des tâches.
+     */
+    std::vector<QueueEntry> enqueueMany(const std::vector<Task*>& tasks);
+
+    /**
+     * Remettre en file
+     * Réinsère une entrée précédemment retirée en conservant sa priorité, son échéance et son numéro d'arrivée.
+     * En mode FIFO l'entrée est placée à l'arrière de la file ; pour les autres politiques elle retrouve sa place.
+     * entry L'entrée à réinsérer.
+     */
+    void requeue(const QueueEntry& entry);
+
+    /**
+     * Restaurer une entrée
+     * Réinsère une entrée relue depuis un stockage durable et garantit que les prochains numéros d'arrivée
+     * lui seront supérieurs.
+     * entry L'entrée à restaurer.
+     */
+    void restore(const QueueEntry& entry);
+
+    /**
+     * Défiler
+     * Retire et retourne la prochaine entrée selon la politique courante. Lève une exception si la file est vide.
+     * Retourne L'entrée retirée.
+     */
+    QueueEntry dequeue();
+
+    /**
+     * Défiler plusieurs entrées
+     * Retire au plus 'count' entrées selon la politique courante.
+     * count Le nombre maximal d'entrées à retirer.
+     * out Reçoit les entrées retirées, dans l'ordre de sortie.
+     * Retourne Le nombre d'entrées retirées.
+     */
+    int dequeueMany(int count, std::vector<QueueEntry>& out);
+
+    /**
+     * Regarder l'avant (Peek)
+     * Retourne la prochaine entrée sans la retirer. Lève une exception si la file est vide.
+     * Retourne L'entrée suivante.
+     */
+    QueueEntry peek() const;
+
+    /**
+     * Parcourir dans l'ordre
+     * Visite les entrées dans l'ordre où elles seront retirées, sans copier la file.
+     * Le parcours s'arrête dès que 'visit' retourne false.
+     * visit La fonction appelée pour chaque entrée.
+     */
+    void forEachInOrder(const std::function<bool(const QueueEntry&)>& visit) const;
+
+    /**
+     * Parcourir après une entrée
+     * Visite, dans l'ordre de sortie, les entrées qui suivent l'entrée de numéro 'sequence'. En mode FIFO,
+     * l'entrée est retrouvée en O(1) ; pour les autres politiques, le parcours ordonné repart de l'avant.
+     * Le parcours s'arrête dès que 'visit' retourne false.
+     * sequence Le numéro d'ordre de l'entrée repère.
+     * visit La fonction appelée pour chaque entrée suivante.
+     * Retourne La position (à partir de 1) de l'entrée repère, ou -1 si elle n'est plus dans la file.
+     */
+    int forEachAfter(long long sequence, const std::function<bool(const QueueEntry&)>& visit) const;
+
+    /**
+     * Contient la tâche
+     * taskId L'identifiant de la tâche.
+     * Retourne Vrai si une entrée de cette tâche est dans la file, Faux sinon.
+     */
+    bool containsTask(const std::string& taskId) const { return queuedTasks.count(taskId) != 0; }
+
+    /**
+     * Changer la politique
+     * Modifie la politique d'ordonnancement et transfère les entrées existantes vers la structure adaptée.
+     * p La nouvelle politique.
+     * aging Le nombre de secondes d'attente équivalant à un niveau de priorité (AGING_POLICY).
+     */
+    void setPolicy(SchedulingPolicy p, int aging);
+
+    /**
+     * Obtenir la politique
+     * Retourne La politique d'ordonnancement courante.
+     */
+    SchedulingPolicy getPolicy() const { return policy; }
+
+    /**
+     * Obtenir le paramètre de vieillissement
+     * Retourne Le nombre de secondes d'attente équivalant à un niveau de priorité.
+     */
+    int getAgingSeconds() const { return agingSeconds; }
+
+    /**
+     * Obtenir le prochain numéro d'ordre
+     * Retourne Le numéro d'ordre qui sera attribué à la prochaine entrée (sauvegardé dans les instantanés).
+     */
+    long long getNextSequence() const { return nextSequence; }
+
+    /**
+     * Définir le prochain numéro d'ordre
+     * Utilisé au chargement d'un instantané ; la valeur n'est jamais diminuée.
+     * sequence Le prochain numéro d'ordre.
+     */
+    void setNextSequence(long long sequence) { if (sequence > nextSequence) nextSequence = sequence; }
+
+    /**
+     * Est vide
+     * Retourne Vrai si la file est vide, Faux sinon.
+     */
+    bool isEmpty() const { return policy == FIFO_POLICY ? fifo.isEmpty() : scheduled.isEmpty(); }
+
+    /**
+     * Obtenir la taille
+     * Retourne Le nombre d'entrées dans la file.
+     */
+    int getSize() const { return policy == FIFO_POLICY ? fifo.getSize() : scheduled.getSize(); }
+
+    /**
+     * Nettoyer
+     * Supprime toutes les entrées de la file.
+     */
+    void clear();
+};
+
+#endif
@@ -0,0 +1,241 @@
+#include "SegmentedQueue.h"
+#include "../models/QueueEntry.h"
+#include <string>
+#include <utility>
+
+/**
+ * Constructeur
+ * Crée le premier segment, partagé par la tête et la queue.
+ */
+template<typename T>
+SegmentedQueue<T>::SegmentedQueue() : size(0), activeOperations(0), retired(nullptr) {
+    Segment* first = new Segment();
+    headSegment.store(first);
+    tailSegment.store(first);
+}
+
+/**
+ * Destructeur
+ * Libère la chaîne de segments à partir de la tête, puis les segments en attente de libération.
+ * Suppose qu'aucun autre thread n'utilise plus la file.
+ */
+template<typename T>
+SegmentedQueue<T>::~SegmentedQueue() {
+    Segment* segment = headSegment.load();
+    while (segment) {
+        Segment* next = segment->next.load();
+        delete segment;
+        segment = next;
+    }
+
+    segment = retired.load();
+    while (segment) {
+        Segment* next = segment->retiredNext;
+        delete segment;
+        segment = next;
+    }
+}
+
+/**
+ * Retirer un segment
+ * Empile le segment dans la liste des segments retirés (pile sans verrou).
+ * segment Le segment détaché de la tête.
+ */
+template<typename T>
+void SegmentedQueue<T>::retire(Segment* segment) {
+    Segment* top = retired.load();
+    do {
+        segment->retiredNext = top;
+    } while (!retired.compare_exchange_weak(top, segment));
+}
+
+/**
+ * Quitter une opération
+ * Un segment n'est retiré qu'après que la tête et la queue l'ont dépassé : une opération commencée ensuite
+ * ne peut plus l'atteindre. Si, après avoir récupéré la liste des segments retirés, l'opération courante est
+ * la seule active, aucune opération antérieure au retrait ne peut encore y accéder et la liste est libérée.
+ * Sinon elle est remise en attente.
+ */
+template<typename T>
+void SegmentedQueue<T>::leaveOperation() {
+    if (retired.load() != nullptr) {
+        Segment* list = retired.exchange(nullptr);
+
+        if (activeOperations.load() == 1) {
+            while (list) {
+                Segment* next = list->retiredNext;
+                delete list;
+                list = next;
+            }
+        } else {
+            while (list) {
+                Segment* next = list->retiredNext;
+                retire(list);
+                list = next;
+            }
+        }
+    }
+
+    activeOperations.fetch_sub(1);
+}
+
+/**
+ * Enfiler
+ * Réserve une case du segment de queue par fetch-and-add, y écrit la donnée puis la publie (EMPTY -> READY).
+ * Si un consommateur a invalidé la case entre-temps (TAKEN), une autre case est réservée.
+ * Lorsque le segment est plein, un nouveau segment est chaîné et la queue est avancée.
+ * data L'élément à ajouter.
+ */
+template<typename T>
+void SegmentedQueue<T>::enqueue(T data) {
+    OperationGuard guard(*this);
+
+    while (true) {
+        Segment* tail = tailSegment.load();
+        std::size_t index = tail->enqueueIndex.fetch_add(1);
+
+        if (index < SEGMENT_SIZE) {
+            Cell& cell = tail->cells[index];
+            cell.data = data;
+
+            int expected = EMPTY;
+            if (cell.state.compare_exchange_strong(expected, READY)) {
+                size.fetch_add(1);
+                return;
+            }
+            continue;
+        }
+
+        if (tail != tailSegment.load()) continue;
+
+        Segment* next = tail->next.load();
+        if (!next) {
+            Segment* fresh = new Segment();
+            Segment* expected = nullptr;
+            if (tail->next.compare_exchange_strong(expected, fresh)) {
+                next = fresh;
+            } else {
+                delete fresh;
+                next = expected;
+            }
+        }
+        tailSegment.compare_exchange_strong(tail, next);
+    }
+}
+
+/**
+ * Essayer de défiler
+ * Réserve une case du segment de tête par fetch-and-add. Si la case a été publiée, sa donnée est lue ;
+ * sinon la case est invalidée (EMPTY -> TAKEN) pour que le producteur en retard en choisisse une autre.
+ * Lorsque le segment de tête est épuisé, la tête avance vers le segment suivant et l'ancien est retiré.
+ * out Reçoit l'élément retiré.
+ * Retourne true si un élément a été retiré, false si la file est vide.
+ */
+template<typename T>
+bool SegmentedQueue<T>::tryDequeue(T& out) {
+    OperationGuard guard(*this);
+
+    while (true) {
+        Segment* head = headSegment.load();
+
+        if (head->dequeueIndex.load() >= head->enqueueIndex.load() && head->next.load() == nullptr) {
+            return false;
+        }
+
+        std::size_t index = head->dequeueIndex.fetch_add(1);
+
+        if (index >= SEGMENT_SIZE) {
+            Segment* next = head->next.load();
+            if (!next) return false;
+
+            // La queue ne doit jamais pointer vers un segment retiré
+            Segment* tail = head;
+            tailSegment.compare_exchange_strong(tail, next);
+
+            if (headSegment.compare_exchange_strong(head, next)) {
+                retire(head);
+            }
+            continue;
+        }
+
+        Cell& cell = head->cells[index];
+        int expected = EMPTY;
+        if (cell.state.compare_exchange_strong(expected, TAKEN)) {
+            continue;
+        }
+
+        out = std::move(cell.data);
+        size.fetch_sub(1);
+        return true;
+    }
+}
+
+/**
+ * Défiler
+ * Retire et retourne l'élément situé à l'avant de la file. Lève une exception si la file est vide.
+ * Retourne L'élément retiré.
+ */
+template<typename T>
+T SegmentedQueue<T>::dequeue() {
+    T data;
+    if (!tryDequeue(data)) {
+        throw std::runtime_error("Queue is empty");
+    }
+    return data;
+}
+
+/**
+ * Enfiler plusieurs éléments
+ * Enfile les éléments un à un : chacun est publié dès qu'il est écrit.
+ * items Les éléments à ajouter.
+ */
+template<typename T>
+void SegmentedQueue<T>::enqueueMany(const std::vector<T>& items) {
+    for (const T& item : items) {
+        enqueue(item);
+    }
+}
+
+/**
+ * Défiler plusieurs éléments
+ * Défile sans bloquer jusqu'à 'count' éléments ou jusqu'à ce que la file soit vide.
+ * count Le nombre maximal d'éléments à retirer.
+ * out Reçoit les éléments retirés, dans l'ordre de sortie.
+ * Retourne Le nombre d'éléments retirés.
+ */
+template<typename T>
+int SegmentedQueue<T>::dequeueMany(int count, std::vector<T>& out) {
+    int removed = 0;
+    T data;
+    while (removed < count && tryDequeue(data)) {
+        out.push_back(std::move(data));
+        removed++;
+    }
+    return removed;
+}
+
+/**
+ * Obtenir la taille
+ * Retourne le compteur d'éléments publiés et non encore retirés.
+ * Retourne La taille de la file.
+ */
+template<typename T>
+int SegmentedQueue<T>::getSize() const {
+    long current = size.load();
+    return current > 0 ? static_cast<int>(current) : 0;
+}
+
+/**
+ * Nettoyer
+ * Défile tous les éléments jusqu'à ce que la file soit vide.
+ */
+template<typename T>
+void SegmentedQueue<T>::clear() {
+    T discarded;
+    while (tryDequeue(discarded)) {}
+}
+
+// Instanciation explicite des types supportés
+template class SegmentedQueue<std::string>;
+template class SegmentedQueue<int>;
+template class SegmentedQueue<QueueEntry>;
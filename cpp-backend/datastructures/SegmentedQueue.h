@@ -0,0 +1,148 @@
+#ifndef SEGMENTEDQUEUE_H
+#define SEGMENTEDQUEUE_H
+
+#include "MPMCQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Implémentation d'une File non bornée sans verrou, multi-producteurs et multi-consommateurs,
+ * formée d'une liste chaînée de segments (tableaux de SEGMENT_SIZE cases). Les positions sont réservées
+ * par fetch-and-add ; une allocation n'a lieu qu'une fois par segment et non à chaque enfilement.
+ * Les segments vidés sont libérés dès qu'aucune opération n'est en cours (état de repos).
+ * Reprend de Queue<T> l'enfilement et le défilement (unitaires et par lots), la taille et le nettoyage, avec en
+ * plus tryDequeue. Comme pour MPMCQueue, il n'y a ni peek ni parcours (ConstIterator).
+ */
+template<typename T>
+class SegmentedQueue {
+private:
+    static const std::size_t SEGMENT_SIZE = 1024;
+
+    enum CellState { EMPTY, READY, TAKEN };
+
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<int> state;
+        T data;
+
+        /**
+         * Initialise une case libre.
+         */
+        Cell() : state(EMPTY) {}
+    };
+
+    struct Segment {
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueueIndex;
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeueIndex;
+        alignas(CACHE_LINE_SIZE) std::atomic<Segment*> next;
+        Segment* retiredNext; // Chaînage dans la liste des segments en attente de libération
+        Cell cells[SEGMENT_SIZE];
+
+        /**
+         * Initialise un segment vide.
+         */
+        Segment() : enqueueIndex(0), dequeueIndex(0), next(nullptr), retiredNext(nullptr) {}
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<Segment*> headSegment;
+    alignas(CACHE_LINE_SIZE) std::atomic<Segment*> tailSegment;
+    alignas(CACHE_LINE_SIZE) std::atomic<long> size;
+    alignas(CACHE_LINE_SIZE) std::atomic<int> activeOperations;
+    std::atomic<Segment*> retired;
+
+    /**
+     * Marque le début et la fin d'une opération pour la libération différée des segments.
+     */
+    struct OperationGuard {
+        SegmentedQueue& queue;
+        explicit OperationGuard(SegmentedQueue& q) : queue(q) { queue.activeOperations.fetch_add(1); }
+        ~OperationGuard() { queue.leaveOperation(); }
+    };
+
+    /**
+     * Retirer un segment
+     * Ajoute un segment détaché de la tête à la liste des segments en attente de libération.
+     */
+    void retire(Segment* segment);
+
+    /**
+     * Quitter une opération
+     * Si l'opération courante est la seule active, libère les segments retirés auparavant.
+     */
+    void leaveOperation();
+
+public:
+    /**
+     * Initialise une file vide composée d'un seul segment.
+     */
+    SegmentedQueue();
+
+    /**
+     * Libère tous les segments, y compris ceux en attente de libération.
+     */
+    ~SegmentedQueue();
+
+    SegmentedQueue(const SegmentedQueue&) = delete;
+    SegmentedQueue& operator=(const SegmentedQueue&) = delete;
+
+    /**
+     * Enfiler
+     * Ajoute un élément à l'arrière de la file. Ne peut pas échouer (hors manque de mémoire).
+     * data L'élément à ajouter.
+     */
+    void enqueue(T data);
+
+    /**
+     * Essayer de défiler
+     * Retire l'élément situé à l'avant de la file sans bloquer.
+     * out Reçoit l'élément retiré.
+     * Retourne true si un élément a été retiré, false si la file est vide.
+     */
+    bool tryDequeue(T& out);
+
+    /**
+     * Défiler
+     * Retire et retourne l'élément situé à l'avant de la file. Lève une exception si la file est vide.
+     * Retourne L'élément retiré.
+     */
+    T dequeue();
+
+    /**
+     * Enfiler plusieurs éléments
+     * Ajoute les éléments à l'arrière de la file dans l'ordre donné.
+     * items Les éléments à ajouter.
+     */
+    void enqueueMany(const std::vector<T>& items);
+
+    /**
+     * Défiler plusieurs éléments
+     * Retire au plus 'count' éléments de l'avant de la file et les ajoute à 'out' ; s'arrête dès que la file est vide.
+     * count Le nombre maximal d'éléments à retirer.
+     * out Reçoit les éléments retirés, dans l'ordre de sortie.
+     * Retourne Le nombre d'éléments retirés.
+     */
+    int dequeueMany(int count, std::vector<T>& out);
+
+    /**
+     * Est vide
+     * Vérifie si la file ne contient aucun élément (valeur indicative en présence d'accès concurrents).
+     * Retourne Vrai si la file est vide, Faux sinon.
+     */
+    bool isEmpty() const { return getSize() == 0; }
+
+    /**
+     * Obtenir la taille
+     * Retourne le nombre d'éléments dans la file (valeur indicative en présence d'accès concurrents).
+     * Retourne La taille de la file.
+     */
+    int getSize() const;
+
+    /**
+     * Nettoyer
+     * Retire tous les éléments de la file.
+     */
+    void clear();
+};
+
+#endif
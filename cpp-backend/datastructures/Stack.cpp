@@ -57,6 +57,20 @@ Operation Stack::peek() const {
     return top->data;
 }
 
+/**
+ * Obtenir les éléments
+ * Parcourt la pile du sommet vers le fond puis inverse le résultat.
+ * Retourne Les opérations, du fond vers le sommet.
+ */
+std::vector<Operation> Stack::toVector() const {
+    std::vector<Operation> items;
+    items.reserve(size);
+    for (StackNode* current = top; current; current = current->next) {
+        items.push_back(current->data);
+    }
+    return std::vector<Operation>(items.rbegin(), items.rend());
+}
+
 /**
  * Vérification de vide (est_vide)
  * Vérifie si la pile ne contient aucun élément.
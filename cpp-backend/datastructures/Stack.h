@@ -2,6 +2,7 @@
 #define STACK_H
 
 #include "../models/Operation.h"
+#include <vector>
 
 /**
  * 
@@ -72,6 +73,12 @@ public:
      */
     void clear();
     
+    /**
+     * Obtenir les éléments
+     * Retourne une copie des éléments de la pile, du plus ancien (fond) au plus récent (sommet).
+     */
+    std::vector<Operation> toVector() const;
+
     /**
      * Obtenir la taille
      * Retourne le nombre d'éléments dans la pile.
@@ -0,0 +1,140 @@
+#include "SyncLog.h"
+#include <chrono>
+#include <algorithm>
+
+/**
+ * Initialise un journal vide dont les versions partent de l'horloge courante en microsecondes.
+ */
+SyncLog::SyncLog()
+    : baseVersion(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count())) {}
+
+/**
+ * Obtenir l'état d'un utilisateur
+ * userId L'identifiant de l'utilisateur.
+ * Retourne L'état de synchronisation de l'utilisateur.
+ */
+SyncLog::UserSync& SyncLog::getUser(const std::string& userId) {
+    auto it = users.find(userId);
+    if (it == users.end()) {
+        UserSync sync;
+        sync.version = baseVersion;
+        sync.floor = baseVersion;
+        it = users.emplace(userId, std::move(sync)).first;
+    }
+    return it->second;
+}
+
+/**
+ * Enregistrer une modification
+ * Une tâche qui change d'utilisateur est retirée de l'ancien comme une suppression.
+ * taskId L'identifiant de la tâche.
+ * userId L'identifiant de son utilisateur.
+ */
+void SyncLog::touch(const std::string& taskId, const std::string& userId) {
+    auto it = tasks.find(taskId);
+    if (it != tasks.end() && it->second.userId != userId) {
+        remove(taskId);
+        it = tasks.end();
+    }
+
+    UserSync& sync = getUser(userId);
+    uint64_t version = ++sync.version;
+
+    if (it == tasks.end()) {
+        tasks.emplace(taskId, TrackedTask{userId, version});
+    } else {
+        sync.changed.erase(it->second.version);
+        it->second.version = version;
+    }
+    sync.changed.emplace(version, taskId);
+}
+
+/**
+ * Enregistrer une suppression
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void SyncLog::remove(const std::string& taskId) {
+    auto it = tasks.find(taskId);
+    if (it == tasks.end()) return;
+
+    UserSync& sync = getUser(it->second.userId);
+    sync.changed.erase(it->second.version);
+    sync.tombstones.emplace_back(++sync.version, taskId);
+    if (sync.tombstones.size() > MAX_TOMBSTONES) {
+        sync.floor = sync.tombstones.front().first;
+        sync.tombstones.pop_front();
+    }
+    tasks.erase(it);
+}
+
+/**
+ * Obtenir la version d'un utilisateur
+ * userId L'identifiant de l'utilisateur.
+ * Retourne La version courante (la version de base si l'utilisateur n'a aucune mutation).
+ */
+uint64_t SyncLog::getVersion(const std::string& userId) const {
+    auto it = users.find(userId);
+    return it == users.end() ? baseVersion : it->second.version;
+}
+
+/**
+ * Obtenir la version d'une tâche
+ * taskId L'identifiant de la tâche.
+ * Retourne La version de sa dernière modification, ou 0.
+ */
+uint64_t SyncLog::getTaskVersion(const std::string& taskId) const {
+    auto it = tasks.find(taskId);
+    return it == tasks.end() ? 0 : it->second.version;
+}
+
+/**
+ * Lister les changements
+ * Fusionne les modifications (table ordonnée) et les suppressions (file croissante) à partir de 'since'.
+ * userId L'identifiant de l'utilisateur.
+ * since La version connue du client.
+ * limit Le nombre maximal de changements visités.
+ * visitChanged Appelée pour chaque tâche créée ou modifiée.
+ * visitDeleted Appelée pour chaque tâche supprimée.
+ * nextVersion Reçoit la version à laquelle reprendre.
+ * hasMore Reçoit true s'il reste des changements.
+ * Retourne false si le client doit tout relire.
+ */
+bool SyncLog::changesSince(const std::string& userId, uint64_t since, size_t limit,
+                           const std::function<void(const std::string&)>& visitChanged,
+                           const std::function<void(const std::string&)>& visitDeleted,
+                           uint64_t& nextVersion, bool& hasMore) const {
+    hasMore = false;
+    auto userIt = users.find(userId);
+    uint64_t floor = userIt == users.end() ? baseVersion : userIt->second.floor;
+    uint64_t version = userIt == users.end() ? baseVersion : userIt->second.version;
+    nextVersion = version;
+    if (since < floor || since > version) return false;
+    if (userIt == users.end()) return true;
+
+    const UserSync& sync = userIt->second;
+    auto changed = sync.changed.upper_bound(since);
+    auto deleted = std::upper_bound(sync.tombstones.begin(), sync.tombstones.end(), since,
+        [](uint64_t value, const std::pair<uint64_t, std::string>& tombstone) { return value < tombstone.first; });
+
+    size_t visited = 0;
+    while (changed != sync.changed.end() || deleted != sync.tombstones.end()) {
+        if (visited == limit) {
+            hasMore = true;
+            return true;
+        }
+
+        if (deleted == sync.tombstones.end() || (changed != sync.changed.end() && changed->first < deleted->first)) {
+            nextVersion = changed->first;
+            visitChanged(changed->second);
+            ++changed;
+        } else {
+            nextVersion = deleted->first;
+            visitDeleted(deleted->second);
+            ++deleted;
+        }
+        visited++;
+    }
+    nextVersion = version;
+    return true;
+}
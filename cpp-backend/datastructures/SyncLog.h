@@ -0,0 +1,110 @@
+#ifndef SYNCLOG_H
+#define SYNCLOG_H
+
+#include <string>
+#include <map>
+#include <deque>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * Journal de synchronisation différentielle : un compteur de version monotone par utilisateur, la version
+ * de dernière modification de chaque tâche, et les suppressions récentes (pierres tombales, en nombre
+ * borné). Un client qui connaît la version V ne relit que ce qui a changé depuis, en O(changements).
+ *
+ * Les versions partent de l'horloge du démarrage en microsecondes : une version délivrée avant un
+ * redémarrage est donc inférieure au plancher du nouveau processus et le client est invité à tout relire,
+ * sans qu'une ancienne version puisse jamais être réattribuée.
+ */
+class SyncLog {
+public:
+    static const size_t MAX_TOMBSTONES = 4096; // Suppressions conservées par utilisateur
+
+private:
+    /**
+     * État de synchronisation d'un utilisateur.
+     */
+    struct UserSync {
+        uint64_t version;                                   // Version courante (dernière mutation)
+        uint64_t floor;                                     // Les versions antérieures ne peuvent plus être servies
+        std::map<uint64_t, std::string> changed;            // Version de dernière modification -> tâche existante
+        std::deque<std::pair<uint64_t, std::string>> tombstones; // (version, identifiant) des suppressions, croissantes
+    };
+
+    /**
+     * Tâche suivie.
+     */
+    struct TrackedTask {
+        std::string userId;
+        uint64_t version;
+    };
+
+    uint64_t baseVersion; // Plancher commun (horloge du démarrage)
+    std::unordered_map<std::string, UserSync> users;
+    std::unordered_map<std::string, TrackedTask> tasks;
+
+    /**
+     * Obtenir l'état d'un utilisateur
+     * Le crée au besoin, avec la version et le plancher de base.
+     */
+    UserSync& getUser(const std::string& userId);
+
+public:
+    /**
+     * Initialise un journal vide dont les versions partent de l'horloge courante en microsecondes.
+     */
+    SyncLog();
+
+    /**
+     * Enregistrer une modification
+     * Incrémente la version de l'utilisateur et l'attribue à la tâche créée ou modifiée.
+     * taskId L'identifiant de la tâche.
+     * userId L'identifiant de son utilisateur.
+     */
+    void touch(const std::string& taskId, const std::string& userId);
+
+    /**
+     * Enregistrer une suppression
+     * Incrémente la version de l'utilisateur et ajoute une pierre tombale ; la plus ancienne est oubliée
+     * au-delà de MAX_TOMBSTONES (le plancher de l'utilisateur avance alors).
+     * taskId L'identifiant de la tâche supprimée.
+     */
+    void remove(const std::string& taskId);
+
+    /**
+     * Obtenir la version d'un utilisateur
+     * userId L'identifiant de l'utilisateur.
+     * Retourne La version de la dernière mutation de ses tâches.
+     */
+    uint64_t getVersion(const std::string& userId) const;
+
+    /**
+     * Obtenir la version d'une tâche
+     * taskId L'identifiant de la tâche.
+     * Retourne La version de sa dernière modification, ou 0 si elle n'est pas suivie.
+     */
+    uint64_t getTaskVersion(const std::string& taskId) const;
+
+    /**
+     * Lister les changements
+     * Visite dans l'ordre des versions les tâches modifiées et les tâches supprimées après 'since', jusqu'à
+     * 'limit' changements. Une tâche modifiée plusieurs fois n'apparaît qu'une fois, à sa dernière version.
+     * userId L'identifiant de l'utilisateur.
+     * since La version connue du client.
+     * limit Le nombre maximal de changements visités.
+     * visitChanged Appelée avec l'identifiant de chaque tâche créée ou modifiée.
+     * visitDeleted Appelée avec l'identifiant de chaque tâche supprimée.
+     * nextVersion Reçoit la version à laquelle reprendre (la version courante si tout a été visité).
+     * hasMore Reçoit true s'il reste des changements au-delà de la limite.
+     * Retourne false si 'since' est antérieure au plancher ou postérieure à la version courante : le client
+     * doit alors tout relire.
+     */
+    bool changesSince(const std::string& userId, uint64_t since, size_t limit,
+                      const std::function<void(const std::string&)>& visitChanged,
+                      const std::function<void(const std::string&)>& visitDeleted,
+                      uint64_t& nextVersion, bool& hasMore) const;
+};
+
+#endif
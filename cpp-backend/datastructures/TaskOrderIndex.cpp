@@ -0,0 +1,164 @@
+#include "TaskOrderIndex.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/**
+ * Valeur de tri
+ * task La tâche.
+ * field Le champ de tri.
+ * Retourne La valeur de la tâche pour ce champ (une tâche sans échéance reçoit la plus grande valeur).
+ */
+long long TaskOrderIndex::sortValue(const Task& task, SortField field) {
+    switch (field) {
+        case SORT_CREATED_AT: return static_cast<long long>(task.getCreatedAt());
+        case SORT_UPDATED_AT: return static_cast<long long>(task.getUpdatedAt());
+        case SORT_DUE_DATE:
+            return task.getDueDate() == 0 ? std::numeric_limits<long long>::max() : static_cast<long long>(task.getDueDate());
+        case SORT_PRIORITY: return static_cast<long long>(task.getPriority());
+        case SORT_URGENCY: {
+            // Rang de priorité (0 pour HIGH) dans les bits de poids fort, échéance bornée dans les 41 bits de poids faible
+            const long long dueBits = 1LL << 41;
+            long long rank = HIGH - std::min(std::max(static_cast<int>(task.getPriority()), static_cast<int>(LOW)), static_cast<int>(HIGH));
+            long long due = task.getDueDate() == 0 ? dueBits - 1
+                          : std::min(std::max(static_cast<long long>(task.getDueDate()), 0LL), dueBits - 2);
+            return rank * dueBits + due;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Ajouter ou retirer les positions d'une tâche
+ * Une tâche dont le statut est hors énumération n'est pas indexée.
+ * taskId L'identifiant de la tâche.
+ * entry Les valeurs indexées.
+ * insert true pour ajouter, false pour retirer.
+ */
+void TaskOrderIndex::apply(const std::string& taskId, const IndexedTask& entry, bool insert) {
+    if (entry.status < TO_DO || entry.status > COMPLETED) return;
+
+    UserOrder& order = users[entry.userId];
+    for (int field = 0; field < SORT_FIELD_COUNT; field++) {
+        OrderKey key{entry.values[field], taskId};
+        if (insert) order.keys[entry.status][field].insert(std::move(key));
+        else order.keys[entry.status][field].erase(key);
+    }
+
+    if (insert) {
+        order.size++;
+    } else if (--order.size == 0) {
+        users.erase(entry.userId);
+    }
+}
+
+/**
+ * Mettre à jour une tâche
+ * task La tâche insérée ou modifiée.
+ */
+void TaskOrderIndex::update(const Task& task) {
+    IndexedTask entry;
+    entry.userId = task.getUserId();
+    entry.status = task.getStatus();
+    for (int field = 0; field < SORT_FIELD_COUNT; field++) {
+        entry.values[field] = sortValue(task, static_cast<SortField>(field));
+    }
+
+    std::string taskId = task.getId();
+    auto it = tasks.find(taskId);
+    if (it == tasks.end()) {
+        apply(taskId, entry, true);
+        tasks.emplace(std::move(taskId), std::move(entry));
+        return;
+    }
+
+    IndexedTask& previous = it->second;
+    if (previous.userId == entry.userId && previous.status == entry.status) {
+        // Seuls les champs dont la valeur a changé sont déplacés
+        if (entry.status < TO_DO || entry.status > COMPLETED) return;
+        UserOrder& order = users[entry.userId];
+        for (int field = 0; field < SORT_FIELD_COUNT; field++) {
+            if (previous.values[field] == entry.values[field]) continue;
+            std::set<OrderKey>& keys = order.keys[entry.status][field];
+            keys.erase(OrderKey{previous.values[field], taskId});
+            keys.insert(OrderKey{entry.values[field], taskId});
+            previous.values[field] = entry.values[field];
+        }
+        return;
+    }
+
+    apply(taskId, previous, false);
+    apply(taskId, entry, true);
+    previous = std::move(entry);
+}
+
+/**
+ * Retirer une tâche
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void TaskOrderIndex::erase(const std::string& taskId) {
+    auto it = tasks.find(taskId);
+    if (it == tasks.end()) return;
+
+    apply(taskId, it->second, false);
+    tasks.erase(it);
+}
+
+/**
+ * Parcourir
+ * Fusion à k voies (au plus une par statut) : à chaque pas, la plus petite (ou la plus grande) position
+ * parmi les partitions est visitée puis sa partition avance.
+ * userId L'identifiant de l'utilisateur.
+ * statusMask Les statuts à parcourir.
+ * field Le champ de tri.
+ * descending true pour l'ordre décroissant.
+ * from La position de départ, ou nullptr.
+ * exclusive true pour exclure la position de départ.
+ * visit La fonction appelée pour chaque position.
+ */
+void TaskOrderIndex::scan(const std::string& userId, unsigned statusMask, SortField field, bool descending,
+                          const OrderKey* from, bool exclusive, const std::function<bool(const OrderKey&)>& visit) const {
+    auto userIt = users.find(userId);
+    if (userIt == users.end()) return;
+
+    struct Cursor {
+        const std::set<OrderKey>* keys;
+        std::set<OrderKey>::const_iterator position; // Prochaine position (en ordre décroissant : juste après)
+    };
+
+    std::vector<Cursor> cursors;
+    for (int status = 0; status < STATUS_COUNT; status++) {
+        if (!(statusMask & (1u << status))) continue;
+        const std::set<OrderKey>& keys = userIt->second.keys[status][field];
+        if (keys.empty()) continue;
+
+        std::set<OrderKey>::const_iterator position;
+        if (!from) {
+            position = descending ? keys.end() : keys.begin();
+        } else if (descending) {
+            position = exclusive ? keys.lower_bound(*from) : keys.upper_bound(*from);
+        } else {
+            position = exclusive ? keys.upper_bound(*from) : keys.lower_bound(*from);
+        }
+        cursors.push_back(Cursor{&keys, position});
+    }
+
+    while (true) {
+        Cursor* best = nullptr;
+        for (Cursor& cursor : cursors) {
+            if (descending) {
+                if (cursor.position == cursor.keys->begin()) continue;
+                if (!best || *std::prev(best->position) < *std::prev(cursor.position)) best = &cursor;
+            } else {
+                if (cursor.position == cursor.keys->end()) continue;
+                if (!best || *cursor.position < *best->position) best = &cursor;
+            }
+        }
+        if (!best) return;
+
+        const OrderKey& key = descending ? *std::prev(best->position) : *best->position;
+        if (descending) --best->position;
+        else ++best->position;
+        if (!visit(key)) return;
+    }
+}
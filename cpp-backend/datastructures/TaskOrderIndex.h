@@ -0,0 +1,111 @@
+#ifndef TASKORDERINDEX_H
+#define TASKORDERINDEX_H
+
+#include "../models/Task.h"
+#include <string>
+#include <set>
+#include <unordered_map>
+#include <functional>
+
+/**
+ * Champ de tri d'un index ordonné.
+ */
+enum SortField {
+    SORT_CREATED_AT,  // Date de création
+    SORT_UPDATED_AT,  // Date de modification
+    SORT_DUE_DATE,    // Échéance (les tâches sans échéance viennent après toutes les autres)
+    SORT_PRIORITY,    // Priorité
+    SORT_URGENCY      // Urgence : priorité décroissante puis échéance la plus proche (sans échéance en dernier)
+};
+
+static const int SORT_FIELD_COUNT = 5;
+static const int STATUS_COUNT = 4;
+
+/**
+ * Position dans un index ordonné : la valeur du champ de tri, puis l'identifiant de la tâche pour
+ * départager les égalités (l'ordre est total, ce qui rend les curseurs stables).
+ */
+struct OrderKey {
+    long long value;
+    std::string taskId;
+
+    /**
+     * Comparer deux positions
+     */
+    bool operator<(const OrderKey& other) const {
+        return value != other.value ? value < other.value : taskId < other.taskId;
+    }
+};
+
+/**
+ * Index ordonnés des tâches de chaque utilisateur, un par champ de tri et par statut. Une requête qui
+ * filtre sur le statut ne parcourt que les partitions demandées, fusionnées dans l'ordre du tri ; le
+ * parcours reprend directement à une position donnée (curseur ou borne d'intervalle) et s'arrête dès
+ * que l'appelant a assez de résultats, si bien qu'une page coûte O(log n + éléments visités).
+ */
+class TaskOrderIndex {
+private:
+    /**
+     * Index d'un utilisateur.
+     */
+    struct UserOrder {
+        std::set<OrderKey> keys[STATUS_COUNT][SORT_FIELD_COUNT];
+        size_t size = 0;
+    };
+
+    /**
+     * Tâche indexée.
+     */
+    struct IndexedTask {
+        std::string userId;
+        Status status;
+        long long values[SORT_FIELD_COUNT];
+    };
+
+    std::unordered_map<std::string, UserOrder> users;
+    std::unordered_map<std::string, IndexedTask> tasks; // Identifiant de tâche -> valeurs indexées
+
+    /**
+     * Ajouter ou retirer les positions d'une tâche
+     */
+    void apply(const std::string& taskId, const IndexedTask& entry, bool insert);
+
+public:
+    /**
+     * Valeur de tri
+     * task La tâche.
+     * field Le champ de tri.
+     * Retourne La valeur de la tâche pour ce champ.
+     */
+    static long long sortValue(const Task& task, SortField field);
+
+    /**
+     * Mettre à jour une tâche
+     * Déplace les positions de la tâche dont la valeur ou le statut a changé.
+     * task La tâche insérée ou modifiée.
+     */
+    void update(const Task& task);
+
+    /**
+     * Retirer une tâche
+     * taskId L'identifiant de la tâche supprimée.
+     */
+    void erase(const std::string& taskId);
+
+    /**
+     * Parcourir
+     * Visite dans l'ordre du tri les tâches de l'utilisateur dont le statut fait partie du masque, à partir
+     * d'une position donnée.
+     * userId L'identifiant de l'utilisateur.
+     * statusMask Les statuts à parcourir (bit 1 << statut).
+     * field Le champ de tri.
+     * descending true pour l'ordre décroissant.
+     * from La position de départ, ou nullptr pour partir du début (de la fin en ordre décroissant).
+     * exclusive true pour exclure la position de départ elle-même.
+     * visit La fonction appelée pour chaque position ; le parcours s'arrête lorsqu'elle retourne false.
+     */
+    void scan(const std::string& userId, unsigned statusMask, SortField field, bool descending,
+              const OrderKey* from, bool exclusive, const std::function<bool(const OrderKey&)>& visit) const;
+};
+
+#endif
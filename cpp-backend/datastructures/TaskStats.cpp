@@ -0,0 +1,213 @@
+#include "TaskStats.h"
+#include <cstdio>
+
+/**
+ * Convertir une date civile en numéro de jour
+ * Algorithme de H. Hinnant (calendrier grégorien proleptique).
+ * Retourne Le nombre de jours depuis le 1er janvier 1970.
+ */
+static int daysFromCivil(int year, int month, int dayOfMonth) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + dayOfMonth - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * Convertir un numéro de jour en date civile
+ * day Le nombre de jours depuis le 1er janvier 1970.
+ * year, month, dayOfMonth Reçoivent la date (mois de 1 à 12).
+ */
+static void civilFromDays(int day, int& year, int& month, int& dayOfMonth) {
+    day += 719468;
+    int era = (day >= 0 ? day : day - 146096) / 146097;
+    int dayOfEra = day - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int monthIndex = (5 * dayOfYear + 2) / 153;
+    dayOfMonth = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+/**
+ * Numéro de jour
+ * t L'horodatage.
+ * Retourne Le nombre de jours écoulés depuis le 1er janvier 1970, en heure locale.
+ */
+int TaskStats::dayKey(time_t t) {
+    struct tm local;
+#ifdef _WIN32
+    localtime_s(&local, &t);
+#else
+    localtime_r(&t, &local);
+#endif
+    return daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+/**
+ * Date d'un jour
+ * day Le numéro du jour.
+ * Retourne La date au format "AAAA-MM-JJ".
+ */
+std::string TaskStats::dayString(int day) {
+    int year, month, dayOfMonth;
+    civilFromDays(day, year, month, dayOfMonth);
+    char text[16];
+    std::snprintf(text, sizeof(text), "%04d-%02d-%02d", year, month, dayOfMonth);
+    return text;
+}
+
+/**
+ * Clé de mois
+ * t L'horodatage.
+ * Retourne année * 12 + mois (0 à 11) en heure locale.
+ */
+int TaskStats::monthKey(time_t t) {
+    int year, month, dayOfMonth;
+    civilFromDays(dayKey(t), year, month, dayOfMonth);
+    return year * 12 + month - 1;
+}
+
+/**
+ * Obtenir une journée
+ * day Le numéro du jour.
+ * Retourne Les compteurs du jour (vides s'il n'est pas dans l'historique).
+ */
+DayBucket UserTaskStats::getDay(int day) const {
+    if (days.empty()) return DayBucket(day);
+    const DayBucket& bucket = days[static_cast<size_t>(((day % TaskStats::HISTORY_DAYS) + TaskStats::HISTORY_DAYS) % TaskStats::HISTORY_DAYS)];
+    return bucket.day == day ? bucket : DayBucket(day);
+}
+
+/**
+ * Compter dans une journée
+ * Chaque case du tableau circulaire mémorise le jour qu'elle compte : une case qui porte un autre jour
+ * est soit plus récente (le jour demandé est sorti de l'historique, il est ignoré), soit plus ancienne
+ * (elle est recyclée pour le jour demandé). Un retrait suit la même règle que l'ajout correspondant.
+ * stats Les compteurs de l'utilisateur.
+ * day Le numéro du jour.
+ * completed true pour le compteur des tâches terminées, false pour celui des créations.
+ * sign +1 pour l'ajouter, -1 pour le retirer.
+ */
+void TaskStats::countDay(UserTaskStats& stats, int day, bool completed, int sign) {
+    if (stats.days.empty()) {
+        stats.days.resize(HISTORY_DAYS, DayBucket(0));
+        for (int i = 0; i < HISTORY_DAYS; i++) stats.days[i].day = -1 - i; // Aucun jour réel
+    }
+
+    DayBucket& bucket = stats.days[static_cast<size_t>(((day % HISTORY_DAYS) + HISTORY_DAYS) % HISTORY_DAYS)];
+    if (bucket.day != day) {
+        if (bucket.day > day || sign < 0) return;
+        bucket = DayBucket(day);
+    }
+    (completed ? bucket.completed : bucket.created) += sign;
+}
+
+/**
+ * Ajouter ou retirer une contribution
+ * Une échéance est comptée en retard si elle précède la limite de bascule de l'utilisateur, sinon elle
+ * est rangée dans les échéances à venir : le retrait suit la même règle que l'ajout.
+ * entry La contribution.
+ * sign +1 pour l'ajouter, -1 pour la retirer.
+ */
+void TaskStats::apply(const CountedTask& entry, int sign) {
+    UserTaskStats& stats = users[entry.userId];
+
+    stats.total += sign;
+    // Une valeur hors énumération (non validée à la création) n'est comptée que dans le total
+    if (entry.status >= TO_DO && entry.status <= COMPLETED) stats.byStatus[entry.status] += sign;
+    if (entry.priority >= LOW && entry.priority <= HIGH) stats.byPriority[entry.priority - LOW] += sign;
+    if (entry.favorite) stats.favorites += sign;
+
+    if (entry.dueDate != 0 && entry.status != COMPLETED) {
+        if (entry.dueDate < stats.overdueBoundary) {
+            stats.overdue += sign;
+        } else if (sign > 0) {
+            stats.upcoming.insert(entry.dueDate);
+        } else {
+            stats.upcoming.erase(stats.upcoming.find(entry.dueDate));
+        }
+    }
+
+    int createdDay = dayKey(entry.createdAt);
+    int year, month, dayOfMonth;
+    civilFromDays(createdDay, year, month, dayOfMonth);
+    int monthIndex = year * 12 + month - 1;
+    size_t& created = stats.createdByMonth[monthIndex];
+    created += sign;
+    if (created == 0) stats.createdByMonth.erase(monthIndex);
+
+    countDay(stats, createdDay, false, sign);
+    if (entry.completedAt != 0) {
+        countDay(stats, dayKey(entry.completedAt), true, sign);
+    }
+
+    if (stats.total == 0) {
+        users.erase(entry.userId);
+    }
+}
+
+/**
+ * Mettre à jour une tâche
+ * La plupart des modifications (titre, description, étiquettes) ne changent aucun compteur : la
+ * contribution n'est alors pas recalculée. Le jour d'achèvement est la date d'achèvement portée par la
+ * tâche : il survit aux modifications ultérieures, au rejeu du journal, aux instantanés et aux imports.
+ * Une tâche terminée dont la date est inconnue compte parmi les tâches terminées, dans aucun jour.
+ * task La tâche créée ou modifiée.
+ */
+void TaskStats::update(const Task& task) {
+    CountedTask entry{task.getUserId(), task.getStatus(), task.getPriority(), task.getIsFavorite(),
+                      task.getDueDate(), task.getCreatedAt(), task.getCompletedAt()};
+
+    auto it = counted.find(task.getId());
+    if (it == counted.end()) {
+        apply(entry, 1);
+        counted.emplace(task.getId(), std::move(entry));
+        return;
+    }
+
+    CountedTask& previous = it->second;
+    if (previous.userId == entry.userId && previous.status == entry.status && previous.priority == entry.priority &&
+        previous.favorite == entry.favorite && previous.dueDate == entry.dueDate && previous.createdAt == entry.createdAt &&
+        previous.completedAt == entry.completedAt) {
+        return;
+    }
+
+    apply(previous, -1);
+    apply(entry, 1);
+    previous = std::move(entry);
+}
+
+/**
+ * Retirer une tâche
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void TaskStats::erase(const std::string& taskId) {
+    auto it = counted.find(taskId);
+    if (it == counted.end()) return;
+
+    apply(it->second, -1);
+    counted.erase(it);
+}
+
+/**
+ * Obtenir les compteurs d'un utilisateur
+ * userId L'identifiant de l'utilisateur.
+ * now L'heure courante.
+ * Retourne Les compteurs, ou nullptr si l'utilisateur n'a aucune tâche.
+ */
+const UserTaskStats* TaskStats::get(const std::string& userId, time_t now) {
+    auto it = users.find(userId);
+    if (it == users.end()) return nullptr;
+
+    UserTaskStats& stats = it->second;
+    while (!stats.upcoming.empty() && *stats.upcoming.begin() < now) {
+        stats.upcoming.erase(stats.upcoming.begin());
+        stats.overdue++;
+    }
+    if (now > stats.overdueBoundary) stats.overdueBoundary = now;
+    return &stats;
+}
@@ -0,0 +1,156 @@
+#ifndef TASKSTATS_H
+#define TASKSTATS_H
+
+#include "../models/Task.h"
+#include <string>
+#include <unordered_map>
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdint>
+#include <ctime>
+
+/**
+ * Compteurs d'une journée (heure locale).
+ */
+struct DayBucket {
+    int day;             // Numéro du jour (jours depuis le 1er janvier 1970)
+    uint32_t created;    // Tâches créées ce jour-là
+    uint32_t completed;  // Tâches terminées ce jour-là
+
+    /**
+     * Initialise une journée vide.
+     */
+    DayBucket(int d = 0) : day(d), created(0), completed(0) {}
+};
+
+/**
+ * Compteurs d'un utilisateur, tenus à jour à chaque mutation.
+ */
+struct UserTaskStats {
+    size_t total;
+    size_t byStatus[4];                  // Indexé par Status
+    size_t byPriority[3];                // Indexé par Priority - LOW
+    size_t favorites;
+    size_t overdue;                      // Tâches non terminées dont l'échéance est dépassée
+    std::multiset<time_t> upcoming;      // Échéances non encore dépassées des tâches non terminées
+    time_t overdueBoundary;              // Les échéances antérieures sont comptées dans 'overdue'
+    std::map<int, size_t> createdByMonth; // Créations par mois (année * 12 + mois, heure locale)
+    std::vector<DayBucket> days;         // Tableau circulaire des HISTORY_DAYS derniers jours (alloué au premier ajout)
+
+    /**
+     * Initialise des compteurs à zéro.
+     */
+    UserTaskStats() : total(0), byStatus{0, 0, 0, 0}, byPriority{0, 0, 0}, favorites(0), overdue(0), overdueBoundary(0) {}
+
+    /**
+     * Obtenir une journée
+     * day Le numéro du jour.
+     * Retourne Les compteurs du jour (vides si le jour n'est plus, ou pas encore, dans l'historique).
+     */
+    DayBucket getDay(int day) const;
+};
+
+/**
+ * Statistiques par utilisateur maintenues de façon incrémentale : chaque création, modification ou
+ * suppression retire l'ancienne contribution de la tâche puis ajoute la nouvelle, de sorte qu'une
+ * lecture ne parcourt jamais les tâches. Seules les tâches en retard dépendent de l'heure : les
+ * échéances à venir sont rangées dans un ensemble trié et basculent dans le compteur de retard
+ * lorsque l'heure les dépasse (O(log n) amorti par tâche). Les créations et les achèvements sont aussi
+ * comptés par jour dans un tableau circulaire de taille fixe, qu'une plage de jours lit en O(jours).
+ */
+class TaskStats {
+private:
+    /**
+     * Contribution comptée pour une tâche.
+     */
+    struct CountedTask {
+        std::string userId;
+        Status status;
+        Priority priority;
+        bool favorite;
+        time_t dueDate;
+        time_t createdAt;
+        time_t completedAt; // 0 si la tâche n'est pas terminée
+    };
+
+    std::unordered_map<std::string, UserTaskStats> users;
+    std::unordered_map<std::string, CountedTask> counted; // Indexé par identifiant de tâche
+
+    /**
+     * Ajouter ou retirer une contribution
+     * entry La contribution.
+     * sign +1 pour l'ajouter, -1 pour la retirer.
+     */
+    void apply(const CountedTask& entry, int sign);
+
+    /**
+     * Compter dans une journée
+     * Un jour plus ancien que l'historique est ignoré ; un jour plus récent recycle la case qu'il occupe.
+     * stats Les compteurs de l'utilisateur.
+     * day Le numéro du jour.
+     * completed true pour le compteur des tâches terminées, false pour celui des créations.
+     * sign +1 pour l'ajouter, -1 pour le retirer.
+     */
+    static void countDay(UserTaskStats& stats, int day, bool completed, int sign);
+
+public:
+    /**
+     * Mettre à jour une tâche
+     * Remplace la contribution précédente de la tâche (s'il y en a une) par son état courant.
+     * task La tâche créée ou modifiée.
+     */
+    void update(const Task& task);
+
+    /**
+     * Retirer une tâche
+     * taskId L'identifiant de la tâche supprimée.
+     */
+    void erase(const std::string& taskId);
+
+    /**
+     * Obtenir les compteurs d'un utilisateur
+     * Fait d'abord basculer dans le compteur de retard les échéances dépassées à l'heure donnée.
+     * userId L'identifiant de l'utilisateur.
+     * now L'heure courante.
+     * Retourne Les compteurs, ou nullptr si l'utilisateur n'a aucune tâche.
+     */
+    const UserTaskStats* get(const std::string& userId, time_t now);
+
+    /**
+     * Obtenir le nombre total de tâches comptées
+     */
+    size_t getTaskCount() const { return counted.size(); }
+
+    static const int HISTORY_DAYS = 400; // Jours conservés par l'historique quotidien
+
+    /**
+     * Numéro de jour
+     * t L'horodatage.
+     * Retourne Le nombre de jours écoulés depuis le 1er janvier 1970, en heure locale.
+     */
+    static int dayKey(time_t t);
+
+    /**
+     * Date d'un jour
+     * day Le numéro du jour.
+     * Retourne La date au format "AAAA-MM-JJ".
+     */
+    static std::string dayString(int day);
+
+    /**
+     * Jour de la semaine
+     * day Le numéro du jour.
+     * Retourne 0 pour lundi, ..., 6 pour dimanche.
+     */
+    static int weekday(int day) { return ((day % 7) + 10) % 7; }
+
+    /**
+     * Clé de mois
+     * t L'horodatage.
+     * Retourne année * 12 + mois (0 à 11) en heure locale.
+     */
+    static int monthKey(time_t t);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "TimerWheel.h"
+#include <string>
+
+/**
+ * Programmer
+ * Range le minuteur dans la case de son échéance. Une échéance antérieure à la position courante
+ * est rangée dans la case suivante pour expirer au prochain avancement.
+ * payload La donnée associée au minuteur.
+ * deadline L'échéance (horodatage en secondes).
+ */
+template<typename T>
+void TimerWheel<T>::schedule(const T& payload, time_t deadline) {
+    time_t tick = deadline > currentTick ? deadline : currentTick + 1;
+    slots[slotFor(tick)].emplace_back(payload, deadline);
+    size++;
+}
+
+/**
+ * Avancer
+ * Visite chaque case écoulée depuis le dernier avancement (au plus un tour complet). Les minuteurs dont
+ * l'échéance est atteinte sont retirés ; ceux programmés plus d'un tour en avance restent dans leur case.
+ * now L'heure courante.
+ * expired Reçoit les données des minuteurs échus.
+ */
+template<typename T>
+void TimerWheel<T>::advance(time_t now, std::vector<T>& expired) {
+    if (now <= currentTick) return;
+
+    time_t elapsed = now - currentTick;
+    time_t steps = elapsed < static_cast<time_t>(slots.size()) ? elapsed : static_cast<time_t>(slots.size());
+
+    for (time_t i = 1; i <= steps; i++) {
+        std::vector<Timer>& slot = slots[slotFor(currentTick + i)];
+        size_t kept = 0;
+
+        for (size_t j = 0; j < slot.size(); j++) {
+            if (slot[j].deadline <= now) {
+                expired.push_back(slot[j].payload);
+                size--;
+            } else {
+                if (kept != j) slot[kept] = slot[j];
+                kept++;
+            }
+        }
+        slot.erase(slot.begin() + kept, slot.end());
+    }
+
+    currentTick = now;
+}
+
+// Instanciation explicite des types supportés
+template class TimerWheel<long long>;
+template class TimerWheel<std::string>;
@@ -0,0 +1,76 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <vector>
+#include <ctime>
+
+/**
+ * Implémentation d'une roue temporelle (hashed timer wheel) à granularité d'une seconde.
+ * Chaque échéance est rangée dans la case (échéance mod nombre de cases) ; avancer la roue ne visite
+ * que les cases écoulées, ce qui rend l'ajout O(1) et l'expiration O(1) amorti par minuteur.
+ * L'annulation est paresseuse : l'appelant ignore les minuteurs expirés devenus obsolètes.
+ */
+template<typename T>
+class TimerWheel {
+private:
+    struct Timer {
+        T payload;
+        time_t deadline;
+
+        /**
+         * Constructeur de minuteur
+         * p La donnée associée au minuteur.
+         * d L'échéance du minuteur.
+         */
+        Timer(const T& p, time_t d) : payload(p), deadline(d) {}
+    };
+
+    std::vector<std::vector<Timer>> slots;
+    time_t currentTick; // Dernière seconde traitée
+    int size;
+
+    /**
+     * Obtenir la case
+     * Retourne l'indice de la case correspondant à une seconde donnée.
+     */
+    size_t slotFor(time_t tick) const { return static_cast<size_t>(tick) % slots.size(); }
+
+public:
+    /**
+     * Initialise une roue vide.
+     * slotCount Le nombre de cases (secondes couvertes par un tour de roue).
+     * now L'heure de départ de la roue.
+     */
+    TimerWheel(int slotCount = 512, time_t now = std::time(nullptr))
+        : slots(slotCount > 0 ? slotCount : 1), currentTick(now), size(0) {}
+
+    /**
+     * Programmer
+     * Ajoute un minuteur qui expirera à l'échéance donnée. Une échéance déjà passée expirera au prochain avancement.
+     * payload La donnée associée au minuteur.
+     * deadline L'échéance (horodatage en secondes).
+     */
+    void schedule(const T& payload, time_t deadline);
+
+    /**
+     * Avancer
+     * Fait tourner la roue jusqu'à l'heure donnée et ajoute à 'expired' la donnée de chaque minuteur échu.
+     * now L'heure courante.
+     * expired Reçoit les données des minuteurs échus.
+     */
+    void advance(time_t now, std::vector<T>& expired);
+
+    /**
+     * Obtenir la taille
+     * Retourne Le nombre de minuteurs programmés (y compris ceux annulés paresseusement).
+     */
+    int getSize() const { return size; }
+
+    /**
+     * Est vide
+     * Retourne Vrai si aucun minuteur n'est programmé, Faux sinon.
+     */
+    bool isEmpty() const { return size == 0; }
+};
+
+#endif
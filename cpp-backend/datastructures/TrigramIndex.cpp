@@ -0,0 +1,199 @@
+#include "TrigramIndex.h"
+#include <algorithm>
+
+/**
+ * Extraire les trigrammes
+ * Chaque trigramme est codé sur 24 bits (trois octets consécutifs).
+ * text Le texte normalisé.
+ * Retourne Les trigrammes distincts du texte, triés.
+ */
+static std::vector<uint32_t> trigramsOf(const std::string& text) {
+    std::vector<uint32_t> trigrams;
+    if (text.size() < 3) return trigrams;
+
+    trigrams.reserve(text.size() - 2);
+    for (size_t i = 0; i + 2 < text.size(); i++) {
+        trigrams.push_back((static_cast<uint32_t>(static_cast<unsigned char>(text[i])) << 16) |
+                           (static_cast<uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8) |
+                           static_cast<uint32_t>(static_cast<unsigned char>(text[i + 2])));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+/**
+ * Insérer dans une liste triée
+ * Les numéros de documents récents étant les plus grands, l'insertion se fait le plus souvent en fin de liste.
+ */
+static void insertSorted(std::vector<uint32_t>& list, uint32_t value) {
+    if (list.empty() || list.back() < value) {
+        list.push_back(value);
+        return;
+    }
+    auto it = std::lower_bound(list.begin(), list.end(), value);
+    if (it == list.end() || *it != value) list.insert(it, value);
+}
+
+/**
+ * Retirer d'une liste triée
+ */
+static void eraseSorted(std::vector<uint32_t>& list, uint32_t value) {
+    auto it = std::lower_bound(list.begin(), list.end(), value);
+    if (it != list.end() && *it == value) list.erase(it);
+}
+
+/**
+ * Normaliser
+ * text Le texte.
+ * Retourne Le texte en minuscules (ASCII).
+ */
+std::string TrigramIndex::normalize(const std::string& text) {
+    std::string normalized(text);
+    for (char& c : normalized) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return normalized;
+}
+
+/**
+ * Ajouter les listes d'un document
+ */
+void TrigramIndex::addPostings(UserIndex& index, uint32_t documentId, const std::string& text) {
+    for (uint32_t trigram : trigramsOf(text)) {
+        insertSorted(index.postings[trigram], documentId);
+    }
+    insertSorted(index.documents, documentId);
+}
+
+/**
+ * Retirer les listes d'un document
+ * Les listes devenues vides sont supprimées.
+ */
+void TrigramIndex::removePostings(UserIndex& index, uint32_t documentId, const std::string& text) {
+    for (uint32_t trigram : trigramsOf(text)) {
+        auto it = index.postings.find(trigram);
+        if (it == index.postings.end()) continue;
+        eraseSorted(it->second, documentId);
+        if (it->second.empty()) index.postings.erase(it);
+    }
+    eraseSorted(index.documents, documentId);
+}
+
+/**
+ * Mettre à jour une tâche
+ * taskId L'identifiant de la tâche.
+ * userId Le propriétaire de la tâche.
+ * title Le titre.
+ * description La description.
+ */
+void TrigramIndex::update(const std::string& taskId, const std::string& userId, const std::string& title, const std::string& description) {
+    std::string text = normalize(title);
+    text += '\n';
+    text += normalize(description);
+
+    auto it = documentIds.find(taskId);
+    if (it != documentIds.end()) {
+        Document& document = documents[it->second];
+        if (document.userId == userId && document.text == text) return;
+
+        UserIndex& previous = users[document.userId];
+        removePostings(previous, it->second, document.text);
+        if (previous.documents.empty()) users.erase(document.userId);
+
+        document.userId = userId;
+        document.text = std::move(text);
+        addPostings(users[userId], it->second, document.text);
+        return;
+    }
+
+    uint32_t documentId;
+    if (!freeIds.empty()) {
+        documentId = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        documentId = static_cast<uint32_t>(documents.size());
+        documents.emplace_back();
+    }
+
+    Document& document = documents[documentId];
+    document.taskId = taskId;
+    document.userId = userId;
+    document.text = std::move(text);
+    documentIds.emplace(taskId, documentId);
+    addPostings(users[userId], documentId, document.text);
+}
+
+/**
+ * Retirer une tâche
+ * Le numéro du document est libéré pour être réutilisé.
+ * taskId L'identifiant de la tâche supprimée.
+ */
+void TrigramIndex::erase(const std::string& taskId) {
+    auto it = documentIds.find(taskId);
+    if (it == documentIds.end()) return;
+
+    uint32_t documentId = it->second;
+    Document& document = documents[documentId];
+    UserIndex& index = users[document.userId];
+    removePostings(index, documentId, document.text);
+    if (index.documents.empty()) users.erase(document.userId);
+
+    document = Document();
+    freeIds.push_back(documentId);
+    documentIds.erase(it);
+}
+
+/**
+ * Rechercher
+ * Les listes des trigrammes de la requête sont intersectées de la plus courte à la plus longue ; chaque
+ * intersection avance dans la liste la plus longue par recherche dichotomique, sans la parcourir en entier.
+ * userId L'identifiant de l'utilisateur.
+ * query Le texte recherché.
+ * Retourne Les identifiants des tâches dont le titre ou la description contient la requête.
+ */
+std::vector<std::string> TrigramIndex::search(const std::string& userId, const std::string& query) const {
+    std::vector<std::string> matches;
+
+    auto userIt = users.find(userId);
+    std::string needle = normalize(query);
+    if (userIt == users.end() || needle.empty()) return matches;
+    const UserIndex& index = userIt->second;
+
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> trigrams = trigramsOf(needle);
+    if (trigrams.empty()) {
+        candidates = index.documents;
+    } else {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (uint32_t trigram : trigrams) {
+            auto it = index.postings.find(trigram);
+            if (it == index.postings.end()) return matches;
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) {
+            return a->size() < b->size();
+        });
+
+        candidates = *lists[0];
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); i++) {
+            const std::vector<uint32_t>& list = *lists[i];
+            auto from = list.begin();
+            size_t kept = 0;
+            for (uint32_t id : candidates) {
+                from = std::lower_bound(from, list.end(), id);
+                if (from == list.end()) break;
+                if (*from == id) candidates[kept++] = id;
+            }
+            candidates.resize(kept);
+        }
+    }
+
+    for (uint32_t id : candidates) {
+        const Document& document = documents[id];
+        if (document.text.find(needle) != std::string::npos) {
+            matches.push_back(document.taskId);
+        }
+    }
+    return matches;
+}
@@ -0,0 +1,88 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * Index de recherche par sous-chaîne (insensible à la casse) sur le titre et la description des tâches,
+ * partitionné par utilisateur. Chaque document est découpé en trigrammes (suites de 3 octets du texte
+ * normalisé) ; la liste des documents d'un trigramme est triée, ce qui permet d'intersecter les listes
+ * des trigrammes de la requête en commençant par la plus courte. Les candidats sont ensuite vérifiés
+ * sur le texte, les trigrammes ne garantissant pas la contiguïté.
+ */
+class TrigramIndex {
+private:
+    /**
+     * Document indexé.
+     */
+    struct Document {
+        std::string taskId;  // Vide si l'emplacement est libre
+        std::string userId;
+        std::string text;    // Titre et description normalisés, séparés par une fin de ligne
+    };
+
+    /**
+     * Index d'un utilisateur.
+     */
+    struct UserIndex {
+        std::unordered_map<uint32_t, std::vector<uint32_t>> postings; // Trigramme -> documents triés
+        std::vector<uint32_t> documents;                               // Tous ses documents, triés
+    };
+
+    std::vector<Document> documents;                      // Indexé par numéro de document
+    std::vector<uint32_t> freeIds;                        // Numéros de documents réutilisables
+    std::unordered_map<std::string, uint32_t> documentIds; // Identifiant de tâche -> numéro de document
+    std::unordered_map<std::string, UserIndex> users;
+
+    /**
+     * Ajouter les listes d'un document
+     * Insère le document dans les listes de chacun de ses trigrammes.
+     */
+    void addPostings(UserIndex& index, uint32_t documentId, const std::string& text);
+
+    /**
+     * Retirer les listes d'un document
+     * Retire le document des listes de chacun de ses trigrammes.
+     */
+    void removePostings(UserIndex& index, uint32_t documentId, const std::string& text);
+
+public:
+    /**
+     * Normaliser
+     * Met le texte en minuscules (ASCII ; les autres octets sont conservés tels quels).
+     * text Le texte.
+     * Retourne Le texte normalisé.
+     */
+    static std::string normalize(const std::string& text);
+
+    /**
+     * Mettre à jour une tâche
+     * Réindexe la tâche si son titre ou sa description a changé (sans effet sinon).
+     * taskId L'identifiant de la tâche.
+     * userId Le propriétaire de la tâche.
+     * title Le titre.
+     * description La description.
+     */
+    void update(const std::string& taskId, const std::string& userId, const std::string& title, const std::string& description);
+
+    /**
+     * Retirer une tâche
+     * taskId L'identifiant de la tâche supprimée.
+     */
+    void erase(const std::string& taskId);
+
+    /**
+     * Rechercher
+     * Une requête de moins de trois caractères n'a pas de trigramme : les documents de l'utilisateur sont
+     * alors parcourus.
+     * userId L'identifiant de l'utilisateur.
+     * query Le texte recherché (sous-chaîne du titre ou de la description).
+     * Retourne Les identifiants des tâches correspondantes.
+     */
+    std::vector<std::string> search(const std::string& userId, const std::string& query) const;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#include "UserTaskIndex.h"
+
+/**
+ * Mettre à jour
+ * Une tâche déjà indexée pour le même utilisateur ne change de case que si son adresse a changé.
+ * task La tâche.
+ */
+void UserTaskIndex::update(const Task& task) {
+    Collection& owner = users[task.getUserId()];
+
+    auto it = entries.find(task.getId());
+    if (it != entries.end()) {
+        Entry& entry = it->second;
+        if (entry.owner == &owner) {
+            if (entry.task != &task) {
+                owner.tasks = owner.tasks.set(entry.position, &task);
+                entry.task = &task;
+            }
+            return;
+        }
+        entry.owner->tasks = entry.owner->tasks.erase(entry.position);
+        entry = Entry{&owner, owner.nextPosition, &task};
+    } else {
+        entries.emplace(task.getId(), Entry{&owner, owner.nextPosition, &task});
+    }
+
+    owner.tasks = owner.tasks.set(owner.nextPosition++, &task);
+}
+
+/**
+ * Retirer
+ * taskId L'identifiant de la tâche.
+ */
+void UserTaskIndex::erase(const std::string& taskId) {
+    auto it = entries.find(taskId);
+    if (it == entries.end()) return;
+
+    Collection* owner = it->second.owner;
+    owner->tasks = owner->tasks.erase(it->second.position);
+    entries.erase(it);
+}
+
+/**
+ * Obtenir une vue
+ * userId L'identifiant de l'utilisateur.
+ * Retourne Le vecteur persistant de l'utilisateur (vide s'il n'a aucune tâche).
+ */
+PersistentTaskVector UserTaskIndex::snapshot(const std::string& userId) const {
+    auto it = users.find(userId);
+    return it == users.end() ? PersistentTaskVector() : it->second.tasks;
+}
+
+/**
+ * Obtenir le nombre de tâches d'un utilisateur
+ * userId L'identifiant de l'utilisateur.
+ * Retourne Le nombre de tâches.
+ */
+size_t UserTaskIndex::getSize(const std::string& userId) const {
+    auto it = users.find(userId);
+    return it == users.end() ? 0 : it->second.tasks.size();
+}
@@ -0,0 +1,67 @@
+#ifndef USERTASKINDEX_H
+#define USERTASKINDEX_H
+
+#include "PersistentTaskVector.h"
+#include "../models/Task.h"
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * Collection des tâches de chaque utilisateur, dans l'ordre de leur première indexation (celui de la liste).
+ * Chaque collection est un vecteur persistant : obtenir une vue est O(1) et la vue reste cohérente quelles
+ * que soient les insertions et suppressions qui suivent, sans copie ni verrou. Une insertion ou une
+ * suppression recopie un chemin en O(log32 n) ; la modification d'une tâche déjà indexée ne coûte rien.
+ * Les tâches ne sont pas copiées : une vue fige l'appartenance, les tâches restent celles de la liste.
+ */
+class UserTaskIndex {
+private:
+    /**
+     * Collection d'un utilisateur.
+     */
+    struct Collection {
+        PersistentTaskVector tasks;
+        uint64_t nextPosition = 0; // Position de la prochaine tâche ajoutée (jamais réattribuée)
+    };
+
+    /**
+     * Tâche indexée.
+     */
+    struct Entry {
+        Collection* owner; // Collection de son utilisateur (les éléments d'unordered_map ne sont jamais déplacés)
+        uint64_t position;
+        const Task* task;
+    };
+
+    std::unordered_map<std::string, Collection> users;
+    std::unordered_map<std::string, Entry> entries;
+
+public:
+    /**
+     * Mettre à jour
+     * Ajoute la tâche en fin de collection de son utilisateur, ou la déplace si son utilisateur a changé.
+     * task La tâche, telle que stockée dans la liste (son adresse est conservée).
+     */
+    void update(const Task& task);
+
+    /**
+     * Retirer
+     * taskId L'identifiant de la tâche supprimée.
+     */
+    void erase(const std::string& taskId);
+
+    /**
+     * Obtenir une vue
+     * userId L'identifiant de l'utilisateur.
+     * Retourne Les tâches de l'utilisateur, figées à cet instant (O(1)).
+     */
+    PersistentTaskVector snapshot(const std::string& userId) const;
+
+    /**
+     * Obtenir le nombre de tâches d'un utilisateur
+     * userId L'identifiant de l'utilisateur.
+     */
+    size_t getSize(const std::string& userId) const;
+};
+
+#endif
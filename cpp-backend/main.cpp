@@ -1,16 +1,151 @@
 #include <iostream>
 #include <string>
 #include "controllers/TaskController.h"
+#include <nlohmann/json.hpp>
 
 /**
  * Point d'entrée de l'application. Elle initialise le contrôleur de tâches et entre dans 
  * une boucle de lecture/écriture pour traiter les requêtes entrantes via l'entrée standard (stdin). 
  * Elle sert de couche d'interface console simple pour le TaskController.
+ *
+ * Options :
+ *   --wal <fichier>               Active le journal d'écriture anticipée et rejoue son contenu au démarrage.
+ *   --fsync <always|off|N>        Politique de synchronisation du journal (défaut : always ; N en millisecondes).
+ *   --snapshot <fichier>          Charge l'instantané au démarrage et active l'action "snapshot".
+ *   --snapshot-interval <N>       Prend un instantané en arrière-plan toutes les N secondes (avec --snapshot).
+ *   --checkpoint-bytes <N>        Point de contrôle dès que le segment actif du journal dépasse N octets (avec --snapshot).
+ *   --checkpoint-rate <N>         Limite l'écriture des instantanés à N octets par seconde (défaut : illimité).
+ *   --threads <N>                 Threads des traitements en masse : importation, exportation, reconstruction des index
+ *                                 (défaut : nombre de cœurs).
+ *   --cdc <fichier|fd:N>          Publie chaque mutation validée (une ligne JSON par événement) ; nécessite --wal.
+ *   --due-events <fichier|fd:N>   Publie un événement "task.due" lorsque l'échéance d'une tâche non terminée est atteinte.
+ *   --import <fichier>            Importe les tâches d'un vidage (NDJSON, binaire ou instantané) avant de lire les requêtes.
+ *   --export <fichier|->          Exporte les tâches (après restauration et importation) puis quitte sans lire de requêtes.
+ *   --export-format <ndjson|binary>, --export-user <id>, --export-since <horodatage>
+ *                                 Format et filtres de l'exportation.
  * 
  * Retourne 0 si le programme se termine correctement.
  */
-int main() {
+int main(int argc, char* argv[]) {
     TaskController controller;
+    std::string walPath;
+    FsyncPolicy fsyncPolicy = FSYNC_ALWAYS;
+    int fsyncIntervalMs = 0;
+    std::string snapshotPath;
+    int snapshotIntervalSeconds = 0;
+    long long checkpointBytes = 0;
+    long long checkpointRate = 0;
+    std::string changeFeedTarget;
+    std::string dueFeedTarget;
+    std::string importPath;
+    bool exportMode = false;
+    nlohmann::json exportRequest;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--wal" && i + 1 < argc) {
+            walPath = argv[++i];
+        } else if (arg == "--fsync" && i + 1 < argc) {
+            if (!WriteAheadLog::parseFsyncPolicy(argv[++i], fsyncPolicy, fsyncIntervalMs)) {
+                std::cerr << "Invalid --fsync value (expected always, off or milliseconds)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshotPath = argv[++i];
+        } else if (arg == "--snapshot-interval" && i + 1 < argc) {
+            try {
+                snapshotIntervalSeconds = std::stoi(argv[++i]);
+            } catch (...) {
+                snapshotIntervalSeconds = -1;
+            }
+            if (snapshotIntervalSeconds < 0) {
+                std::cerr << "Invalid --snapshot-interval value (expected seconds)" << std::endl;
+                return 1;
+            }
+        } else if ((arg == "--checkpoint-bytes" || arg == "--checkpoint-rate") && i + 1 < argc) {
+            long long value = -1;
+            try {
+                value = std::stoll(argv[++i]);
+            } catch (...) {}
+            if (value < 0) {
+                std::cerr << "Invalid " << arg << " value (expected bytes)" << std::endl;
+                return 1;
+            }
+            (arg == "--checkpoint-bytes" ? checkpointBytes : checkpointRate) = value;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            int threads = 0;
+            try {
+                threads = std::stoi(argv[++i]);
+            } catch (...) {}
+            if (threads < 1) {
+                std::cerr << "Invalid --threads value (expected a positive count)" << std::endl;
+                return 1;
+            }
+            controller.setThreadCount(static_cast<size_t>(threads));
+        } else if (arg == "--cdc" && i + 1 < argc) {
+            changeFeedTarget = argv[++i];
+        } else if (arg == "--due-events" && i + 1 < argc) {
+            dueFeedTarget = argv[++i];
+        } else if (arg == "--import" && i + 1 < argc) {
+            importPath = argv[++i];
+        } else if (arg == "--export" && i + 1 < argc) {
+            exportMode = true;
+            exportRequest["path"] = argv[++i];
+        } else if (arg == "--export-format" && i + 1 < argc) {
+            exportRequest["format"] = argv[++i];
+        } else if (arg == "--export-user" && i + 1 < argc) {
+            exportRequest["userId"] = argv[++i];
+        } else if (arg == "--export-since" && i + 1 < argc) {
+            try {
+                exportRequest["modifiedSince"] = std::stoll(argv[++i]);
+            } catch (...) {
+                std::cerr << "Invalid --export-since value (expected a timestamp)" << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    // L'instantané est chargé d'abord : le journal ne rejoue ensuite que les enregistrements postérieurs
+    try {
+        if (!snapshotPath.empty()) {
+            controller.openSnapshots(snapshotPath, snapshotIntervalSeconds);
+            controller.setCheckpointPolicy(checkpointBytes, checkpointRate);
+        }
+        if (!walPath.empty()) {
+            controller.openWriteAheadLog(walPath, fsyncPolicy, fsyncIntervalMs);
+        }
+        if (!changeFeedTarget.empty()) {
+            controller.openChangeFeed(changeFeedTarget);
+        }
+        if (!dueFeedTarget.empty()) {
+            controller.openDueFeed(dueFeedTarget);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    // Le rapport d'importation va sur stderr : stdout est réservé aux réponses
+    if (!importPath.empty()) {
+        nlohmann::json request;
+        request["path"] = importPath;
+        std::string report = controller.importTasks(request.dump());
+        std::cerr << report << std::endl;
+        if (!nlohmann::json::parse(report).value("success", false)) {
+            return 1;
+        }
+    }
+
+    if (exportMode) {
+        std::string report = controller.exportTasks(exportRequest.dump(), true);
+        std::cerr << report << std::endl;
+        return nlohmann::json::parse(report).value("success", false) ? 0 : 1;
+    }
+
     std::string line;
     
     while (std::getline(std::cin, line)) {
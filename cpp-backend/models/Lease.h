@@ -0,0 +1,39 @@
+#ifndef LEASE_H
+#define LEASE_H
+
+#include "QueueEntry.h"
+#include <string>
+#include <ctime>
+#include <cstdint>
+
+/**
+ * Structure représentant le bail (lease) accordé à un consommateur lorsqu'il retire une tâche de la file.
+ * Tant que le bail est actif, la tâche est IN_PROGRESS ; s'il n'est ni acquitté ni rendu avant son
+ * échéance, la tâche est remise en file automatiquement.
+ */
+struct Lease {
+    long long leaseId;       // L'identifiant unique du bail.
+    std::string userId;      // Le propriétaire de la file dont la tâche a été retirée.
+    QueueEntry entry;        // L'entrée retirée de la file, remise telle quelle en cas d'échec.
+    Status previousStatus;   // Le statut de la tâche avant le retrait, restauré en cas d'échec.
+    time_t expiresAt;        // L'échéance du bail.
+    uint64_t taskVersion;    // La version de la tâche une fois louée ; 0 pour un bail rechargé (les versions ne sont pas persistées).
+
+    /**
+     * Initialise un bail vide.
+     */
+    Lease() : leaseId(0), previousStatus(TO_DO), expiresAt(0), taskVersion(0) {}
+
+    /**
+     * Initialise un bail pour une entrée retirée de la file.
+     * id L'identifiant du bail.
+     * uid L'identifiant de l'utilisateur.
+     * e L'entrée retirée.
+     * prev Le statut de la tâche avant le retrait.
+     * expires L'échéance du bail.
+     */
+    Lease(long long id, std::string uid, const QueueEntry& e, Status prev, time_t expires)
+        : leaseId(id), userId(uid), entry(e), previousStatus(prev), expiresAt(expires), taskVersion(0) {}
+};
+
+#endif
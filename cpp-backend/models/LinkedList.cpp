@@ -12,7 +12,8 @@ TaskLinkedList::~TaskLinkedList() {
 
 /**
  * Insertion d'une tâche
- * Ajoute une nouvelle tâche à la fin de la liste chaînée simple.
+ * Ajoute une nouvelle tâche à la fin de la liste chaînée simple, en O(1) grâce au pointeur de queue,
+ * et l'enregistre dans l'index si aucune tâche ne porte déjà cet identifiant.
  */
 void TaskLinkedList::insert(Task* task) {
     if (!task) return;
@@ -22,12 +23,12 @@ void TaskLinkedList::insert(Task* task) {
     if (!head) {
         head = task;
     } else {
-        Task* current = head;
-        while (current->next) {
-            current = current->next;
-        }
-        current->next = task;
+        tail->next = task;
     }
+    tail = task;
+    size++;
+
+    index.emplace(task->getId(), task);
 }
 
 /**
@@ -38,49 +39,64 @@ void TaskLinkedList::insert(Task* task) {
  */
 bool TaskLinkedList::remove(std::string taskId) {
 
-    if (!head) return false;
-    
-    if (head->getId() == taskId) {
-        Task* temp = head; 
-        head = head->next;
-        delete temp;
-        size--;
-        return true;
-    }
-    
+    if (!head || index.find(taskId) == index.end()) return false;
+
+    Task* prev = nullptr;
     Task* current = head;
 
-    while (current->next) {
-        if (current->next->getId() == taskId) {
+    while (current && current->getId() != taskId) {
+        prev = current;
+        current = current->next;
+    }
+    if (!current) return false;
 
-            Task* temp = current->next; 
-            current->next = temp->next;
-            delete temp;
-            size--;
-            return true;
+    if (prev) {
+        prev->next = current->next;
+    } else {
+        head = current->next;
+    }
+    if (tail == current) {
+        tail = prev;
+    }
+
+    // Si un doublon de cet identifiant existe plus loin, il devient la tâche indexée
+    index.erase(taskId);
+    for (Task* rest = current->next; rest; rest = rest->next) {
+        if (rest->getId() == taskId) {
+            index.emplace(taskId, rest);
+            break;
         }
-        current = current->next;
     }
-    
-    return false;
+
+    delete current;
+    size--;
+    return true;
 }
 
 /**
  * Recherche d'une tâche
- * Recherche une tâche dans la liste chaînée par son Task ID.
+ * Recherche une tâche par son Task ID à l'aide de l'index (O(1)).
  * Task ID L'identifiant de la tâche à rechercher.
  * Retourne Un pointeur vers la tâche trouvée, ou nullptr si elle n'est pas trouvée.
  */
 Task* TaskLinkedList::find(std::string taskId) {
-    Task* current = head;
-    
-    while (current) {
-        if (current->getId() == taskId) {
-            return current;
-        }
-        current = current->next;
+    auto it = index.find(taskId);
+    return it != index.end() ? it->second : nullptr;
+}
+
+/**
+ * Recherche groupée
+ * Résout chaque identifiant à l'aide de l'index.
+ * taskIds Les identifiants des tâches à rechercher.
+ * Retourne Un vecteur aligné sur 'taskIds' (nullptr pour les tâches introuvables).
+ */
+std::vector<Task*> TaskLinkedList::findMany(const std::vector<std::string>& taskIds) {
+    std::vector<Task*> found;
+    found.reserve(taskIds.size());
+    for (const std::string& id : taskIds) {
+        found.push_back(find(id));
     }
-    return nullptr;
+    return found;
 }
 
 /**
@@ -100,6 +116,17 @@ std::vector<Task*> TaskLinkedList::getAll() {
     return tasks;
 }
 
+/**
+ * Parcourir
+ * Parcourt la liste du début à la fin.
+ * visit La fonction appelée pour chaque tâche.
+ */
+void TaskLinkedList::forEach(const std::function<void(const Task&)>& visit) const {
+    for (const Task* current = head; current; current = current->next) {
+        visit(*current);
+    }
+}
+
 /**
  * Filtrer par ID utilisateur
  * Parcourt la liste chaînée et retourne toutes les tâches associées à un ID utilisateur spécifique.
@@ -161,6 +188,8 @@ void TaskLinkedList::sortByPriority() {
             }
         }
     } while (swapped);
+
+    resetTail();
 }
 
 /**
@@ -204,6 +233,8 @@ void TaskLinkedList::sortByDueDate() {
             }
         }
     } while (swapped);
+
+    resetTail();
 }
 
 /**
@@ -235,5 +266,18 @@ void TaskLinkedList::clear() {
         head = head->next;
         delete temp; 
     }
+    tail = nullptr;
     size = 0;
+    index.clear();
+}
+
+/**
+ * Reconstruire la queue
+ * Parcourt la liste jusqu'au dernier nœud pour mettre à jour le pointeur de queue.
+ */
+void TaskLinkedList::resetTail() {
+    tail = head;
+    while (tail && tail->next) {
+        tail = tail->next;
+    }
 }
\ No newline at end of file
@@ -4,18 +4,29 @@
 #include "Task.h"
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <functional>
 
 /**
  * Implémentation d'une structure de liste chaînée simple pour gérer une collection d'objets Task. 
  * Elle permet l'insertion, la suppression, la recherche, et le tri des tâches.
+ * Un index par identifiant et un pointeur de queue rendent la recherche et l'insertion O(1).
  */
 class TaskLinkedList {
 private:
     Task* head;
+    Task* tail;
     int size;
+    std::unordered_map<std::string, Task*> index; // Première tâche portant chaque identifiant
+
+    /**
+     * Reconstruire la queue
+     * Recalcule le pointeur de queue après une réorganisation des nœuds (tri).
+     */
+    void resetTail();
 
 public:
-    TaskLinkedList() : head(nullptr), size(0) {}
+    TaskLinkedList() : head(nullptr), tail(nullptr), size(0) {}
     
     /**
      * Gère la libération de la mémoire de tous les nœuds de la liste.
@@ -44,6 +55,14 @@ public:
      * Retourne Pointeur vers la Task trouvée, ou nullptr si elle n'existe pas.
      */
     Task* find(std::string taskId);
+
+    /**
+     * Recherche groupée
+     * Localise plusieurs tâches à l'aide de l'index.
+     * taskIds Les identifiants des tâches à rechercher.
+     * Retourne Un vecteur de même taille que 'taskIds', contenant le pointeur de chaque tâche ou nullptr si elle n'existe pas.
+     */
+    std::vector<Task*> findMany(const std::vector<std::string>& taskIds);
     
     /**
      * Obtenir toutes les tâches
@@ -51,6 +70,13 @@ public:
      * Retourne Un vecteur de pointeurs vers toutes les tâches.
      */
     std::vector<Task*> getAll();
+
+    /**
+     * Parcourir
+     * Appelle 'visit' sur chaque tâche, dans l'ordre de la liste, sans construire de vecteur intermédiaire.
+     * visit La fonction appelée pour chaque tâche.
+     */
+    void forEach(const std::function<void(const Task&)>& visit) const;
     
     /**
      * Filtrer par utilisateur
@@ -86,6 +112,13 @@ public:
      * Retourne La taille de la liste.
      */
     int getSize() const { return size; }
+
+    /**
+     * Réserver
+     * Prépare l'index pour 'count' tâches afin d'éviter les redimensionnements lors d'un chargement massif.
+     * count Le nombre de tâches attendu.
+     */
+    void reserve(size_t count) { index.reserve(count); }
     
     /**
      * Est vide
@@ -0,0 +1,74 @@
+#ifndef QUEUEENTRY_H
+#define QUEUEENTRY_H
+
+#include "Task.h"
+#include <string>
+#include <ctime>
+
+/**
+ * Définit la politique utilisée pour choisir la prochaine tâche à traiter dans une file.
+ */
+enum SchedulingPolicy {
+    FIFO_POLICY,       // Premier arrivé, premier servi (comportement historique)
+    PRIORITY_POLICY,   // Priorité décroissante, puis ordre d'arrivée
+    DEADLINE_POLICY,   // Date d'échéance la plus proche d'abord (sans échéance en dernier)
+    AGING_POLICY       // Priorité pondérée par l'ancienneté dans la file
+};
+
+/**
+ * Élément stocké dans une file de traitement. La priorité et l'échéance sont figées au moment
+ * de la mise en file afin que l'ordre de la file reste stable même si la tâche est modifiée ensuite.
+ */
+struct QueueEntry {
+    std::string taskId;   // L'identifiant de la tâche en file.
+    Priority priority;    // La priorité de la tâche au moment de la mise en file.
+    time_t dueDate;       // L'échéance de la tâche au moment de la mise en file (0 si aucune).
+    time_t enqueuedAt;    // Le moment de la mise en file.
+    long long sequence;   // Numéro d'ordre d'arrivée, utilisé pour départager les égalités.
+
+    /**
+     * Initialise une entrée vide.
+     */
+    QueueEntry() : priority(MEDIUM), dueDate(0), enqueuedAt(0), sequence(0) {}
+
+    /**
+     * Initialise une entrée à partir des informations d'une tâche.
+     * id L'identifiant de la tâche.
+     * p La priorité de la tâche.
+     * due L'échéance de la tâche.
+     * at Le moment de la mise en file.
+     * seq Le numéro d'ordre d'arrivée.
+     */
+    QueueEntry(std::string id, Priority p, time_t due, time_t at, long long seq)
+        : taskId(id), priority(p), dueDate(due), enqueuedAt(at), sequence(seq) {}
+};
+
+/**
+ * Convertit une politique d'ordonnancement en son nom utilisé dans les requêtes JSON.
+ * policy La politique à convertir.
+ * Retourne Le nom de la politique ("fifo", "priority", "deadline" ou "aging").
+ */
+inline std::string policyToString(SchedulingPolicy policy) {
+    switch (policy) {
+        case PRIORITY_POLICY: return "priority";
+        case DEADLINE_POLICY: return "deadline";
+        case AGING_POLICY:    return "aging";
+        default:              return "fifo";
+    }
+}
+
+/**
+ * Convertit un nom de politique en valeur de l'énumération SchedulingPolicy.
+ * name Le nom de la politique.
+ * policy Reçoit la politique correspondante.
+ * Retourne true si le nom est reconnu, false sinon.
+ */
+inline bool policyFromString(const std::string& name, SchedulingPolicy& policy) {
+    if (name == "fifo")     { policy = FIFO_POLICY;     return true; }
+    if (name == "priority") { policy = PRIORITY_POLICY; return true; }
+    if (name == "deadline") { policy = DEADLINE_POLICY; return true; }
+    if (name == "aging")    { policy = AGING_POLICY;    return true; }
+    return false;
+}
+
+#endif
@@ -1,16 +1,35 @@
 #include "Task.h"
 #include <nlohmann/json.hpp>
 #include <sstream>
+#include <stdexcept>
+#include <atomic>
+#include <chrono>
 
 using json = nlohmann::json;
 
+/**
+ * Prochaine version de tâche, partagée par toutes les tâches (les importations décodent en parallèle).
+ * Elle part de l'horloge du démarrage en microsecondes : une version délivrée avant un redémarrage n'est
+ * jamais réattribuée.
+ */
+static std::atomic<uint64_t> nextVersion(static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count()));
+
+/**
+ * Obtenir une nouvelle version
+ * Retourne Une version strictement supérieure à toutes celles déjà attribuées.
+ */
+static uint64_t newVersion() {
+    return nextVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 /**
  * Initialise une tâche avec des valeurs de base, en définissant la date de création à l'heure actuelle et l'état à PENDING.
  */
 Task::Task() 
     : id(""), title(""), description(""), priority(MEDIUM), status(PENDING),
-      tags(), isFavorite(false), createdAt(std::time(nullptr)), dueDate(0), 
-      userId(""), next(nullptr)
+      tags(), isFavorite(false), createdAt(std::time(nullptr)), updatedAt(createdAt), dueDate(0), 
+      completedAt(0), userId(""), version(newVersion()), next(nullptr)
 {
 }
 
@@ -24,8 +43,8 @@ Task::Task()
  */
 Task::Task(std::string tid, std::string ttitle, std::string desc, Priority pri, std::string tUserId) 
     : id(tid), title(ttitle), description(desc), priority(pri), status(PENDING),
-      tags(), isFavorite(false), createdAt(std::time(nullptr)), dueDate(0),
-      userId(tUserId), next(nullptr)
+      tags(), isFavorite(false), createdAt(std::time(nullptr)), updatedAt(createdAt), dueDate(0),
+      completedAt(0), userId(tUserId), version(newVersion()), next(nullptr)
 {
 }
 
@@ -77,80 +96,176 @@ bool Task::getIsFavorite() const { return isFavorite; }
  */
 time_t Task::getCreatedAt() const { return createdAt; }
 
+/**
+ * Obtenir la date de modification
+ * Retourne L'horodatage de la dernière modification.
+ */
+time_t Task::getUpdatedAt() const { return updatedAt; }
+
 /**
  * Obtenir la date d'échéance
  * Retourne L'horodatage de la date d'échéance.
  */
 time_t Task::getDueDate() const { return dueDate; }
 
+/**
+ * Obtenir la date d'achèvement
+ * Retourne L'horodatage du passage à COMPLETED (0 si la tâche n'est pas terminée ou si cette date est inconnue).
+ */
+time_t Task::getCompletedAt() const { return completedAt; }
+
 /**
  * Obtenir l'identifiant utilisateur
  * Retourne L'identifiant de l'utilisateur.
  */
 std::string Task::getUserId() const { return userId; }
 
+/**
+ * Obtenir la version
+ * Retourne La version de la tâche.
+ */
+uint64_t Task::getVersion() const { return version; }
+
+/**
+ * Marquer une modification
+ * Appelé par chaque mutateur : la date de modification et la version suivent toute écriture.
+ */
+void Task::touch() {
+    updatedAt = std::time(nullptr);
+    version = newVersion();
+}
+
 
 /**
  * Définir le titre
  * t Le nouveau titre.
  */
-void Task::setTitle(const std::string& t) { title = t; }
+void Task::setTitle(const std::string& t) { title = t; touch(); }
 
 /**
  * Définir la description
  * d La nouvelle description.
  */
-void Task::setDescription(const std::string& d) { description = d; }
+void Task::setDescription(const std::string& d) { description = d; touch(); }
 
 /**
  * Définir la priorité
  * p Le nouveau niveau de priorité.
  */
-void Task::setPriority(Priority p) { priority = p; }
+void Task::setPriority(Priority p) { priority = p; touch(); }
 
 /**
  * Définir le statut
+ * Une tâche déjà terminée garde sa date d'achèvement.
  * s Le nouveau statut de la tâche.
  */
-void Task::setStatus(Status s) { status = s; }
+void Task::setStatus(Status s) {
+    bool completing = s == COMPLETED && status != COMPLETED;
+    status = s;
+    touch();
+    if (completing) completedAt = updatedAt;
+    else if (s != COMPLETED) completedAt = 0;
+}
 
 /**
  * Définir les étiquettes (tags)
  * t Le vecteur des nouvelles étiquettes.
  */
-void Task::setTags(const std::vector<std::string>& t) { tags = t; }
+void Task::setTags(const std::vector<std::string>& t) { tags = t; touch(); }
 
 /**
  * Définir le statut favori
  * fav Le statut favori (true/false).
  */
-void Task::setIsFavorite(bool fav) { isFavorite = fav; }
+void Task::setIsFavorite(bool fav) { isFavorite = fav; touch(); }
 
 /**
  * Définir la date d'échéance
  * date Le nouvel horodatage de la date d'échéance.
  */
-void Task::setDueDate(time_t date) { dueDate = date; }
+void Task::setDueDate(time_t date) { dueDate = date; touch(); }
+
+/**
+ * Définir la date de création
+ * date L'horodatage de création d'origine.
+ */
+void Task::setCreatedAt(time_t date) { createdAt = date; }
+
+/**
+ * Définir la date de modification
+ * date L'horodatage de la dernière modification d'origine.
+ */
+void Task::setUpdatedAt(time_t date) { updatedAt = date; }
+
+/**
+ * Définir la date d'achèvement
+ * date L'horodatage d'achèvement d'origine, 0 s'il est inconnu (ignoré si la tâche n'est pas terminée).
+ */
+void Task::setCompletedAt(time_t date) {
+    if (status == COMPLETED) completedAt = date;
+}
 
 /**
  * Convertit toutes les propriétés de la tâche en une chaîne JSON.
  * Retourne La chaîne JSON représentant la tâche.
  */
 std::string Task::toJson() const {
+    return toJson(FIELD_ALL);
+}
+
+/**
+ * Convertit les propriétés de la tâche présentes dans le masque en une chaîne JSON.
+ * Les champs omis ne sont ni copiés ni échappés.
+ * fields Masque de champs (combinaison de TaskField).
+ * Retourne La chaîne JSON représentant la projection de la tâche.
+ */
+std::string Task::toJson(unsigned fields) const {
     json j;
     j["id"] = id;
-    j["title"] = title;
-    j["description"] = description;
-    j["priority"] = priority;
-    j["status"] = status;
-    j["isFavorite"] = isFavorite;
-    j["tags"] = tags;
-    j["createdAt"] = createdAt;
-    j["dueDate"] = dueDate;
-    j["userId"] = userId;
+    if (fields & FIELD_TITLE) j["title"] = title;
+    if (fields & FIELD_DESCRIPTION) j["description"] = description;
+    if (fields & FIELD_PRIORITY) j["priority"] = priority;
+    if (fields & FIELD_STATUS) j["status"] = status;
+    if (fields & FIELD_IS_FAVORITE) j["isFavorite"] = isFavorite;
+    if (fields & FIELD_TAGS) j["tags"] = tags;
+    if (fields & FIELD_CREATED_AT) j["createdAt"] = createdAt;
+    if (fields & FIELD_UPDATED_AT) j["updatedAt"] = updatedAt;
+    if (fields & FIELD_DUE_DATE) j["dueDate"] = dueDate;
+    if (fields & FIELD_USER_ID) j["userId"] = userId;
+    if (fields & FIELD_VERSION) j["version"] = version;
+    if (fields & FIELD_COMPLETED_AT) j["completedAt"] = completedAt;
     return j.dump();
 }
 
+/**
+ * Convertit des noms de champs en masque de projection.
+ * names Les noms des champs demandés (mêmes clés que toJson).
+ * Retourne Le masque correspondant ; lève std::invalid_argument pour un nom inconnu.
+ */
+unsigned Task::parseFields(const std::vector<std::string>& names) {
+    static const std::pair<const char*, TaskField> known[] = {
+        {"id", FIELD_ID}, {"title", FIELD_TITLE}, {"description", FIELD_DESCRIPTION},
+        {"priority", FIELD_PRIORITY}, {"status", FIELD_STATUS}, {"isFavorite", FIELD_IS_FAVORITE},
+        {"tags", FIELD_TAGS}, {"createdAt", FIELD_CREATED_AT}, {"updatedAt", FIELD_UPDATED_AT},
+        {"dueDate", FIELD_DUE_DATE}, {"userId", FIELD_USER_ID}, {"version", FIELD_VERSION},
+        {"completedAt", FIELD_COMPLETED_AT}
+    };
+
+    unsigned mask = FIELD_ID;
+    for (const std::string& name : names) {
+        bool found = false;
+        for (const auto& field : known) {
+            if (name == field.first) {
+                mask |= field.second;
+                found = true;
+                break;
+            }
+        }
+        if (!found) throw std::invalid_argument("Unknown field: " + name);
+    }
+    return mask;
+}
+
 /**
  * Met à jour les propriétés de l'objet tâche à partir d'une chaîne JSON.
  * jsonStr La chaîne JSON à parser.
@@ -173,6 +288,8 @@ void Task::fromJson(const std::string& jsonStr) {
         }
         if (j.contains("userId")) userId = j["userId"].get<std::string>();
         if (j.contains("dueDate")) dueDate = j["dueDate"].get<time_t>();
+        if (status != COMPLETED) completedAt = 0;
+        else if (j.contains("completedAt")) completedAt = j["completedAt"].is_null() ? 0 : j["completedAt"].get<time_t>();
         
     } catch (const std::exception& e) {
     }
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <ctime>
+#include <cstdint>
 
 /**
  * Définit le niveau d'importance de la tâche.
@@ -24,6 +25,26 @@ enum Status {
     COMPLETED     // Terminée
 };
 
+/**
+ * Champs sérialisables d'une tâche, combinables en masque de projection (voir Task::toJson(unsigned)).
+ */
+enum TaskField {
+    FIELD_ID          = 1 << 0,
+    FIELD_TITLE       = 1 << 1,
+    FIELD_DESCRIPTION = 1 << 2,
+    FIELD_PRIORITY    = 1 << 3,
+    FIELD_STATUS      = 1 << 4,
+    FIELD_IS_FAVORITE = 1 << 5,
+    FIELD_TAGS        = 1 << 6,
+    FIELD_CREATED_AT  = 1 << 7,
+    FIELD_UPDATED_AT  = 1 << 8,
+    FIELD_DUE_DATE    = 1 << 9,
+    FIELD_USER_ID     = 1 << 10,
+    FIELD_COMPLETED_AT = 1 << 11,
+    FIELD_VERSION     = 1 << 12,
+    FIELD_ALL         = (1 << 13) - 1
+};
+
 /**
  * Classe représentant une seule unité de travail. Elle encapsule toutes les propriétés et 
  * les comportements d'une tâche (titre, statut, priorité, dates, etc.).
@@ -38,8 +59,17 @@ private:
     std::vector<std::string> tags;
     bool isFavorite;
     time_t createdAt; // Date de création
+    time_t updatedAt; // Date de la dernière modification (mise à jour par les mutateurs)
     time_t dueDate;   // Date d'échéance
+    time_t completedAt; // Date du passage à COMPLETED (0 si la tâche n'est pas terminée ou si cette date est inconnue)
     std::string userId;
+    uint64_t version; // Version de la tâche, renouvelée par chaque mutateur (jamais réattribuée, même après un redémarrage)
+
+    /**
+     * Marquer une modification
+     * Met à jour la date de modification et attribue une nouvelle version à la tâche.
+     */
+    void touch();
 
 public:
     Task* next; // Pointeur utilisé pour lier les tâches dans la structure TaskLinkedList.
@@ -107,12 +137,24 @@ public:
      * Retourne L'horodatage de création.
      */
     time_t getCreatedAt() const;
+
+    /**
+     * Obtenir la date de modification
+     * Retourne L'horodatage de la dernière modification.
+     */
+    time_t getUpdatedAt() const;
     
     /**
      * Obtenir la date d'échéance
      * Retourne L'horodatage de la date d'échéance.
      */
     time_t getDueDate() const;
+
+    /**
+     * Obtenir la date d'achèvement
+     * Retourne L'horodatage du passage à COMPLETED, ou 0 si la tâche n'est pas terminée ou si cette date est inconnue.
+     */
+    time_t getCompletedAt() const;
     
     /**
      * Obtenir l'identifiant utilisateur
@@ -120,6 +162,12 @@ public:
      */
     std::string getUserId() const;
 
+    /**
+     * Obtenir la version
+     * Retourne La version de la tâche, qui change à chaque modification (sert d'ETag).
+     */
+    uint64_t getVersion() const;
+
     /**
      * Définir le titre
      * t Le nouveau titre.
@@ -140,6 +188,7 @@ public:
     
     /**
      * Définir le statut
+     * Le passage à COMPLETED date l'achèvement ; tout autre statut l'efface.
      * s Le nouveau statut de la tâche.
      */
     void setStatus(Status s);
@@ -162,6 +211,28 @@ public:
      */
     void setDueDate(time_t date);
 
+    /**
+     * Définir la date de création
+     * Utilisé lors de la restauration d'une tâche depuis un stockage durable.
+     * date L'horodatage de création d'origine.
+     */
+    void setCreatedAt(time_t date);
+
+    /**
+     * Définir la date de modification
+     * Utilisé lors de la restauration d'une tâche depuis un stockage durable, après les autres mutateurs
+     * (qui placent la date de modification à l'heure actuelle).
+     * date L'horodatage de la dernière modification d'origine.
+     */
+    void setUpdatedAt(time_t date);
+
+    /**
+     * Définir la date d'achèvement
+     * Utilisé lors de la restauration d'une tâche terminée depuis un stockage durable, après setStatus.
+     * date L'horodatage d'achèvement d'origine (0 si la source ne le connaît pas).
+     */
+    void setCompletedAt(time_t date);
+
     // Utility
     
     /**
@@ -170,6 +241,22 @@ public:
      * Retourne La chaîne JSON représentant la tâche.
      */
     std::string toJson() const;
+
+    /**
+     * Sérialisation partielle en JSON
+     * Ne produit que les champs du masque ; l'identifiant est toujours inclus.
+     * fields Masque de champs (combinaison de TaskField).
+     * Retourne La chaîne JSON représentant la projection de la tâche.
+     */
+    std::string toJson(unsigned fields) const;
+
+    /**
+     * Construire un masque de projection
+     * Convertit des noms de champs ("title", "dueDate", ...) en masque de TaskField.
+     * names Les noms des champs demandés.
+     * Retourne Le masque correspondant ; lève std::invalid_argument pour un nom inconnu.
+     */
+    static unsigned parseFields(const std::vector<std::string>& names);
     
     /**
      * Désérialisation à partir de JSON (fromJson)
@@ -0,0 +1,241 @@
+#include "BinaryCodec.h"
+#include <vector>
+
+/**
+ * Écrire un octet
+ * value La valeur à écrire.
+ */
+void BinaryWriter::writeU8(uint8_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * Écrire un entier de 32 bits
+ * value La valeur à écrire, en ordre petit-boutiste.
+ */
+void BinaryWriter::writeU32(uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/**
+ * Écrire un entier de 64 bits
+ * value La valeur à écrire, en ordre petit-boutiste.
+ */
+void BinaryWriter::writeU64(uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/**
+ * Écrire une chaîne
+ * value La chaîne à écrire.
+ */
+void BinaryWriter::writeString(const std::string& value) {
+    writeU32(static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+/**
+ * Vérifier la place restante
+ * count Le nombre d'octets nécessaires.
+ */
+void BinaryReader::require(size_t count) const {
+    if (count > size - pos) {
+        throw std::runtime_error("Truncated binary record");
+    }
+}
+
+/**
+ * Lire un octet
+ * Retourne La valeur lue.
+ */
+uint8_t BinaryReader::readU8() {
+    require(1);
+    return static_cast<uint8_t>(data[pos++]);
+}
+
+/**
+ * Lire un entier de 32 bits
+ * Retourne La valeur lue.
+ */
+uint32_t BinaryReader::readU32() {
+    require(4);
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(data[pos++])) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Lire un entier de 64 bits
+ * Retourne La valeur lue.
+ */
+uint64_t BinaryReader::readU64() {
+    require(8);
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos++])) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Lire une chaîne
+ * Retourne La chaîne lue.
+ */
+std::string BinaryReader::readString() {
+    uint32_t length = readU32();
+    require(length);
+    std::string value(data + pos, length);
+    pos += length;
+    return value;
+}
+
+/**
+ * Calcule la somme de contrôle CRC-32 à l'aide d'une table de 256 entrées construite au premier appel.
+ * data Le début de la zone.
+ * length La taille de la zone en octets.
+ * Retourne La somme de contrôle.
+ */
+uint32_t crc32(const char* data, size_t length) {
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * Encode toutes les propriétés d'une tâche au format binaire.
+ * writer L'écrivain de destination.
+ * task La tâche à encoder.
+ */
+void encodeTask(BinaryWriter& writer, const Task& task) {
+    writer.writeString(task.getId());
+    writer.writeString(task.getUserId());
+    writer.writeString(task.getTitle());
+    writer.writeString(task.getDescription());
+    writer.writeU8(static_cast<uint8_t>(task.getPriority()));
+    writer.writeU8(static_cast<uint8_t>(task.getStatus()));
+    writer.writeU8(task.getIsFavorite() ? 1 : 0);
+    writer.writeI64(task.getCreatedAt());
+    writer.writeI64(task.getDueDate());
+
+    std::vector<std::string> tags = task.getTags();
+    writer.writeU32(static_cast<uint32_t>(tags.size()));
+    for (const std::string& tag : tags) {
+        writer.writeString(tag);
+    }
+    writer.writeI64(task.getUpdatedAt());
+    writer.writeI64(task.getCompletedAt());
+}
+
+/**
+ * Décode une tâche encodée par encodeTask.
+ * reader Le lecteur source.
+ * withCompletedAt Faux si l'enregistrement précède la date d'achèvement et n'est pas le dernier champ du contenu.
+ * Retourne Une nouvelle tâche allouée dynamiquement.
+ */
+Task* decodeTask(BinaryReader& reader, bool withCompletedAt) {
+    std::string id = reader.readString();
+    std::string userId = reader.readString();
+    std::string title = reader.readString();
+    std::string description = reader.readString();
+    Priority priority = static_cast<Priority>(reader.readU8());
+    Status status = static_cast<Status>(reader.readU8());
+    bool isFavorite = reader.readU8() != 0;
+    time_t createdAt = static_cast<time_t>(reader.readI64());
+    time_t dueDate = static_cast<time_t>(reader.readI64());
+
+    uint32_t tagCount = reader.readU32();
+    std::vector<std::string> tags;
+    for (uint32_t i = 0; i < tagCount; i++) {
+        tags.push_back(reader.readString());
+    }
+
+    Task* task = new Task(id, title, description, priority, userId);
+    task->setStatus(status);
+    task->setIsFavorite(isFavorite);
+    task->setCreatedAt(createdAt);
+    task->setDueDate(dueDate);
+    task->setTags(tags);
+    // Absente des enregistrements écrits avant son ajout (la tâche est alors le dernier champ du contenu)
+    time_t updatedAt = reader.atEnd() ? createdAt : static_cast<time_t>(reader.readI64());
+    task->setUpdatedAt(updatedAt);
+    // Même règle pour la date d'achèvement : absente, elle reste inconnue (0) plutôt que devinée
+    bool hasCompletedAt = withCompletedAt && !reader.atEnd();
+    task->setCompletedAt(hasCompletedAt ? static_cast<time_t>(reader.readI64()) : 0);
+    return task;
+}
+
+/**
+ * Encode une entrée de file de traitement au format binaire.
+ * writer L'écrivain de destination.
+ * entry L'entrée à encoder.
+ */
+void encodeQueueEntry(BinaryWriter& writer, const QueueEntry& entry) {
+    writer.writeString(entry.taskId);
+    writer.writeU8(static_cast<uint8_t>(entry.priority));
+    writer.writeI64(entry.dueDate);
+    writer.writeI64(entry.enqueuedAt);
+    writer.writeI64(entry.sequence);
+}
+
+/**
+ * Décode une entrée de file encodée par encodeQueueEntry.
+ * reader Le lecteur source.
+ * Retourne L'entrée décodée.
+ */
+QueueEntry decodeQueueEntry(BinaryReader& reader) {
+    QueueEntry entry;
+    entry.taskId = reader.readString();
+    entry.priority = static_cast<Priority>(reader.readU8());
+    entry.dueDate = static_cast<time_t>(reader.readI64());
+    entry.enqueuedAt = static_cast<time_t>(reader.readI64());
+    entry.sequence = reader.readI64();
+    return entry;
+}
+
+/**
+ * Encode un bail au format binaire.
+ * writer L'écrivain de destination.
+ * lease Le bail à encoder.
+ */
+void encodeLease(BinaryWriter& writer, const Lease& lease) {
+    writer.writeI64(lease.leaseId);
+    writer.writeString(lease.userId);
+    encodeQueueEntry(writer, lease.entry);
+    writer.writeU8(static_cast<uint8_t>(lease.previousStatus));
+    writer.writeI64(lease.expiresAt);
+}
+
+/**
+ * Décode un bail encodé par encodeLease.
+ * reader Le lecteur source.
+ * Retourne Le bail décodé.
+ */
+Lease decodeLease(BinaryReader& reader) {
+    Lease lease;
+    lease.leaseId = reader.readI64();
+    lease.userId = reader.readString();
+    lease.entry = decodeQueueEntry(reader);
+    lease.previousStatus = static_cast<Status>(reader.readU8());
+    lease.expiresAt = static_cast<time_t>(reader.readI64());
+    return lease;
+}
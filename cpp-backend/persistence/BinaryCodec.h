@@ -0,0 +1,168 @@
+#ifndef BINARYCODEC_H
+#define BINARYCODEC_H
+
+#include "../models/Task.h"
+#include "../models/QueueEntry.h"
+#include "../models/Lease.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * Écrit des valeurs binaires compactes (petit-boutiste) à la fin d'une chaîne d'octets.
+ * Utilisé pour les enregistrements du journal et les fichiers d'instantané.
+ */
+class BinaryWriter {
+private:
+    std::string& out;
+
+public:
+    /**
+     * Initialise l'écrivain sur un tampon de sortie.
+     * buffer Le tampon auquel les octets sont ajoutés.
+     */
+    explicit BinaryWriter(std::string& buffer) : out(buffer) {}
+
+    /**
+     * Écrire un octet
+     */
+    void writeU8(uint8_t value);
+
+    /**
+     * Écrire un entier non signé de 32 bits
+     */
+    void writeU32(uint32_t value);
+
+    /**
+     * Écrire un entier non signé de 64 bits
+     */
+    void writeU64(uint64_t value);
+
+    /**
+     * Écrire un entier signé de 64 bits (horodatages, numéros d'ordre)
+     */
+    void writeI64(int64_t value) { writeU64(static_cast<uint64_t>(value)); }
+
+    /**
+     * Écrire une chaîne
+     * Écrit la longueur (32 bits) puis les octets de la chaîne.
+     */
+    void writeString(const std::string& value);
+};
+
+/**
+ * Lit des valeurs binaires écrites par BinaryWriter depuis une zone mémoire.
+ * Lève une exception si une lecture dépasse la fin de la zone.
+ */
+class BinaryReader {
+private:
+    const char* data;
+    size_t size;
+    size_t pos;
+
+    /**
+     * Vérifier la place restante
+     * Lève une exception si moins de 'count' octets restent à lire.
+     */
+    void require(size_t count) const;
+
+public:
+    /**
+     * Initialise le lecteur sur une zone mémoire.
+     * d Le début de la zone.
+     * n La taille de la zone en octets.
+     */
+    BinaryReader(const char* d, size_t n) : data(d), size(n), pos(0) {}
+
+    /**
+     * Lire un octet
+     */
+    uint8_t readU8();
+
+    /**
+     * Lire un entier non signé de 32 bits
+     */
+    uint32_t readU32();
+
+    /**
+     * Lire un entier non signé de 64 bits
+     */
+    uint64_t readU64();
+
+    /**
+     * Lire un entier signé de 64 bits
+     */
+    int64_t readI64() { return static_cast<int64_t>(readU64()); }
+
+    /**
+     * Lire une chaîne
+     * Lit la longueur (32 bits) puis les octets de la chaîne.
+     */
+    std::string readString();
+
+    /**
+     * Est à la fin
+     * Retourne Vrai si toute la zone a été lue.
+     */
+    bool atEnd() const { return pos >= size; }
+
+    /**
+     * Obtenir la position
+     * Retourne Le nombre d'octets déjà lus.
+     */
+    size_t position() const { return pos; }
+};
+
+/**
+ * Calcule la somme de contrôle CRC-32 (polynôme IEEE 802.3) d'une zone mémoire.
+ * data Le début de la zone.
+ * length La taille de la zone en octets.
+ * Retourne La somme de contrôle.
+ */
+uint32_t crc32(const char* data, size_t length);
+
+/**
+ * Encode toutes les propriétés d'une tâche au format binaire.
+ * writer L'écrivain de destination.
+ * task La tâche à encoder.
+ */
+void encodeTask(BinaryWriter& writer, const Task& task);
+
+/**
+ * Décode une tâche encodée par encodeTask.
+ * reader Le lecteur source.
+ * withCompletedAt Faux pour les instantanés antérieurs à la date d'achèvement (champ absent au milieu du contenu).
+ * Retourne Une nouvelle tâche allouée dynamiquement (la mémoire appartient à l'appelant).
+ */
+Task* decodeTask(BinaryReader& reader, bool withCompletedAt = true);
+
+/**
+ * Encode une entrée de file de traitement au format binaire.
+ * writer L'écrivain de destination.
+ * entry L'entrée à encoder.
+ */
+void encodeQueueEntry(BinaryWriter& writer, const QueueEntry& entry);
+
+/**
+ * Décode une entrée de file encodée par encodeQueueEntry.
+ * reader Le lecteur source.
+ * Retourne L'entrée décodée.
+ */
+QueueEntry decodeQueueEntry(BinaryReader& reader);
+
+/**
+ * Encode un bail au format binaire.
+ * writer L'écrivain de destination.
+ * lease Le bail à encoder.
+ */
+void encodeLease(BinaryWriter& writer, const Lease& lease);
+
+/**
+ * Décode un bail encodé par encodeLease.
+ * reader Le lecteur source.
+ * Retourne Le bail décodé.
+ */
+Lease decodeLease(BinaryReader& reader);
+
+#endif
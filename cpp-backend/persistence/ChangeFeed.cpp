@@ -0,0 +1,202 @@
+#include "ChangeFeed.h"
+#include "BinaryCodec.h"
+#include <nlohmann/json.hpp>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+using json = nlohmann::json;
+
+/**
+ * Convertir une entrée de file
+ * entry L'entrée à convertir.
+ * Retourne L'objet JSON de l'entrée.
+ */
+static json queueEntryToJson(const QueueEntry& entry) {
+    json j;
+    j["taskId"] = entry.taskId;
+    j["priority"] = entry.priority;
+    j["dueDate"] = entry.dueDate;
+    j["enqueuedAt"] = entry.enqueuedAt;
+    j["sequence"] = entry.sequence;
+    return j;
+}
+
+/**
+ * Convertir un enregistrement en événement
+ * Décode le contenu binaire selon le type de l'enregistrement (mêmes formats que TaskController).
+ * La tâche d'un événement task.put est insérée telle que produite par Task::toJson.
+ * record L'enregistrement validé.
+ * Retourne L'événement sérialisé, ou une chaîne vide pour les enregistrements internes.
+ */
+std::string changeEventToJson(const LogRecord& record) {
+    BinaryReader reader(record.payload.data(), record.payload.size());
+    json event;
+    event["lsn"] = record.lsn;
+
+    switch (record.type) {
+        case TASK_PUT: {
+            Task* task = decodeTask(reader);
+            std::string taskJson = task->toJson();
+            delete task;
+
+            event["type"] = "task.put";
+            std::string out = event.dump();
+            out.pop_back();
+            return out + ",\"task\":" + taskJson + "}";
+        }
+
+        case TASK_DELETE:
+            event["type"] = "task.delete";
+            event["taskId"] = reader.readString();
+            break;
+
+        case QUEUE_ENQUEUE:
+            event["type"] = "queue.enqueue";
+            event["userId"] = reader.readString();
+            event["entry"] = queueEntryToJson(decodeQueueEntry(reader));
+            break;
+
+        case QUEUE_DEQUEUE:
+            event["type"] = "queue.dequeue";
+            event["userId"] = reader.readString();
+            event["count"] = reader.readU32();
+            break;
+
+        case QUEUE_POLICY:
+            event["type"] = "queue.policy";
+            event["userId"] = reader.readString();
+            event["policy"] = policyToString(static_cast<SchedulingPolicy>(reader.readU8()));
+            event["agingSeconds"] = reader.readU32();
+            break;
+
+        case LEASE_GRANT: {
+            Lease lease = decodeLease(reader);
+            event["type"] = "lease.grant";
+            event["leaseId"] = lease.leaseId;
+            event["userId"] = lease.userId;
+            event["entry"] = queueEntryToJson(lease.entry);
+            event["expiresAt"] = lease.expiresAt;
+            break;
+        }
+
+        case LEASE_END:
+            event["type"] = "lease.end";
+            event["leaseId"] = reader.readI64();
+            break;
+
+        case UNDO_PUSH:
+            event["type"] = "undo.push";
+            event["operation"] = json::parse(record.payload);
+            break;
+
+        case UNDO_POP:
+            event["type"] = "undo.pop";
+            break;
+
+        default:
+            return "";
+    }
+    return event.dump();
+}
+
+/**
+ * Ouvrir
+ * destination Un chemin de fichier (créé si besoin, ouvert en ajout) ou "fd:N".
+ */
+void ChangeFeed::open(const std::string& destination) {
+    close();
+
+    if (destination.compare(0, 3, "fd:") == 0) {
+        try {
+            fd = std::stoi(destination.substr(3));
+        } catch (...) {
+            throw std::runtime_error("Invalid change feed descriptor: " + destination);
+        }
+        ownsFd = false;
+    } else {
+        fd = ::open(destination.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_BINARY, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open change feed " + destination + ": " + std::strerror(errno));
+        }
+        ownsFd = true;
+    }
+    target = destination;
+}
+
+/**
+ * Publier
+ * Les événements d'une validation sont concaténés puis écrits en une seule fois (en gérant les écritures
+ * partielles). Un tube plein bloque le moteur jusqu'à ce que le consommateur lise : c'est la contre-pression
+ * voulue pour ne perdre aucun événement.
+ * records Les enregistrements validés.
+ */
+void ChangeFeed::publish(const std::vector<LogRecord>& records) {
+    if (!isOpen()) return;
+
+    std::string out;
+    for (const LogRecord& record : records) {
+        std::string event = changeEventToJson(record);
+        if (event.empty()) continue;
+        out += event;
+        out += '\n';
+    }
+    write(out);
+}
+
+/**
+ * Publier des événements
+ * events Les événements sérialisés.
+ */
+void ChangeFeed::publishEvents(const std::vector<std::string>& events) {
+    if (!isOpen() || events.empty()) return;
+
+    std::string out;
+    for (const std::string& event : events) {
+        out += event;
+        out += '\n';
+    }
+    write(out);
+}
+
+/**
+ * Écrire
+ * Un tube plein bloque le moteur jusqu'à ce que le consommateur lise.
+ * out Les lignes à écrire.
+ */
+void ChangeFeed::write(const std::string& out) {
+    size_t written = 0;
+    while (written < out.size()) {
+        auto count = ::write(fd, out.data() + written, static_cast<unsigned>(out.size() - written));
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Change feed write error (" << target << "): " << std::strerror(errno) << std::endl;
+            return;
+        }
+        written += static_cast<size_t>(count);
+    }
+}
+
+/**
+ * Fermer
+ * Ferme le fichier ; un descripteur hérité est laissé ouvert.
+ */
+void ChangeFeed::close() {
+    if (fd >= 0 && ownsFd) {
+        ::close(fd);
+    }
+    fd = -1;
+    ownsFd = false;
+}
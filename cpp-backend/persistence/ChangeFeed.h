@@ -0,0 +1,85 @@
+#ifndef CHANGEFEED_H
+#define CHANGEFEED_H
+
+#include "WriteAheadLog.h"
+#include <string>
+#include <vector>
+
+/**
+ * Convertit un enregistrement du journal en événement de changement JSON :
+ * {"lsn":N,"type":"task.put","task":{...}}, {"lsn":N,"type":"task.delete","taskId":"..."},
+ * "queue.enqueue", "queue.dequeue", "queue.policy", "lease.grant", "lease.end", "undo.push", "undo.pop".
+ * record L'enregistrement validé.
+ * Retourne L'événement sérialisé, ou une chaîne vide pour les enregistrements internes (CHECKPOINT).
+ */
+std::string changeEventToJson(const LogRecord& record);
+
+/**
+ * Flux de changements (change data capture) : publie chaque mutation validée du journal, une ligne JSON
+ * par événement, vers un fichier en ajout ou un descripteur hérité (tube, socket). Les événements sont
+ * écrits après la validation de la requête qui les a produits, dans l'ordre des LSN, de sorte qu'un
+ * consommateur peut reprendre à partir du dernier LSN qu'il a appliqué.
+ */
+class ChangeFeed {
+private:
+    int fd;
+    bool ownsFd;        // false pour un descripteur hérité
+    std::string target;
+
+    /**
+     * Écrire
+     * Écrit le bloc en entier (en gérant les écritures partielles) ; une erreur est signalée sur stderr.
+     * out Les lignes à écrire.
+     */
+    void write(const std::string& out);
+
+public:
+    /**
+     * Initialise un flux fermé.
+     */
+    ChangeFeed() : fd(-1), ownsFd(false) {}
+
+    /**
+     * Ferme le flux.
+     */
+    ~ChangeFeed() { close(); }
+
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    /**
+     * Ouvrir
+     * Lève une exception si la destination ne peut pas être ouverte.
+     * destination Un chemin de fichier (ouvert en ajout) ou "fd:N" pour un descripteur déjà ouvert.
+     */
+    void open(const std::string& destination);
+
+    /**
+     * Est ouvert
+     * Retourne Vrai si le flux est ouvert, Faux sinon.
+     */
+    bool isOpen() const { return fd >= 0; }
+
+    /**
+     * Publier
+     * Écrit en une fois les événements d'une validation. Une erreur d'écriture est signalée sur stderr sans
+     * interrompre le moteur : les mutations restent dans le journal et peuvent être relues par LSN.
+     * records Les enregistrements validés.
+     */
+    void publish(const std::vector<LogRecord>& records);
+
+    /**
+     * Publier des événements
+     * Écrit en une fois des événements déjà sérialisés (un objet JSON par élément), par exemple les
+     * échéances atteintes, qui ne passent pas par le journal.
+     * events Les événements sérialisés.
+     */
+    void publishEvents(const std::vector<std::string>& events);
+
+    /**
+     * Fermer
+     */
+    void close();
+};
+
+#endif
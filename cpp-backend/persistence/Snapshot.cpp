@@ -0,0 +1,339 @@
+#include "Snapshot.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <io.h>
+#define fsync _commit
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+static const char SNAPSHOT_MAGIC[8] = {'T', 'M', 'S', 'N', 'A', 'P', '0', '1'};
+static const uint32_t SNAPSHOT_VERSION = 3; // 2 : date de modification des tâches, 3 : date d'achèvement
+
+/**
+ * Lever une erreur système
+ * Construit une exception à partir du message et de la valeur courante de errno.
+ */
+static std::runtime_error systemError(const std::string& message) {
+    return std::runtime_error(message + ": " + std::strerror(errno));
+}
+
+/**
+ * Ouvrir
+ * Projette le fichier avec mmap (lecture seule, privée). Sans mmap (Windows), le fichier est lu dans un
+ * tampon alloué.
+ * path Le chemin du fichier.
+ * Retourne false si le fichier n'existe pas, true sinon.
+ */
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int handle = ::open(path.c_str(), O_RDONLY | O_BINARY);
+    if (handle < 0) {
+        if (errno == ENOENT) return false;
+        throw systemError("Cannot open snapshot " + path);
+    }
+
+    struct stat info;
+    if (::fstat(handle, &info) != 0) {
+        ::close(handle);
+        throw systemError("Cannot stat snapshot " + path);
+    }
+    size_t length = static_cast<size_t>(info.st_size);
+
+    if (length == 0) {
+        ::close(handle);
+        data = nullptr;
+        size = 0;
+        mapped = false;
+        return true;
+    }
+
+#ifdef _WIN32
+    char* buffer = new char[length];
+    size_t done = 0;
+    while (done < length) {
+        int count = ::read(handle, buffer + done, static_cast<unsigned>(length - done));
+        if (count <= 0) {
+            delete[] buffer;
+            ::close(handle);
+            throw systemError("Cannot read snapshot " + path);
+        }
+        done += static_cast<size_t>(count);
+    }
+    data = buffer;
+    mapped = false;
+#else
+    void* region = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, handle, 0);
+    if (region == MAP_FAILED) {
+        ::close(handle);
+        throw systemError("Cannot map snapshot " + path);
+    }
+    // Le chargement lit le fichier une seule fois, du début à la fin
+    ::madvise(region, length, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(region);
+    mapped = true;
+#endif
+
+    ::close(handle);
+    size = length;
+    return true;
+}
+
+/**
+ * Fermer
+ * Libère la projection (munmap) ou le tampon de repli.
+ */
+void MappedFile::close() {
+    if (!data) return;
+#ifndef _WIN32
+    if (mapped) {
+        ::munmap(const_cast<char*>(data), size);
+    }
+#endif
+    if (!mapped) {
+        delete[] data;
+    }
+    data = nullptr;
+    size = 0;
+    mapped = false;
+}
+
+static const size_t THROTTLE_CHUNK_SIZE = 1 << 20;
+
+/**
+ * Écrire tout le tampon
+ * Écrit 'length' octets en gérant les écritures partielles. Avec une limite de débit, l'écriture se fait
+ * par blocs de 1 Mio et marque une pause dès qu'elle prend de l'avance sur le débit autorisé, afin de
+ * laisser la bande passante du disque aux synchronisations du journal.
+ * maxBytesPerSecond Le débit maximal (0 pour aucune limite).
+ */
+static void writeAll(int handle, const char* data, size_t length, const std::string& path, uint64_t maxBytesPerSecond) {
+    auto started = std::chrono::steady_clock::now();
+    size_t written = 0;
+
+    while (written < length) {
+        size_t chunk = length - written;
+        if (maxBytesPerSecond > 0 && chunk > THROTTLE_CHUNK_SIZE) chunk = THROTTLE_CHUNK_SIZE;
+
+        auto count = ::write(handle, data + written, static_cast<unsigned>(chunk));
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("Cannot write snapshot " + path);
+        }
+        written += static_cast<size_t>(count);
+
+        if (maxBytesPerSecond > 0) {
+            auto due = started + std::chrono::microseconds(written * 1000000 / maxBytesPerSecond);
+            std::this_thread::sleep_until(due);
+        }
+    }
+}
+
+/**
+ * Écrire un instantané
+ * L'instantané précédent reste intact tant que le nouveau n'est pas entièrement écrit et synchronisé :
+ * une panne pendant l'écriture laisse au pire un fichier temporaire orphelin.
+ * path Le chemin de l'instantané.
+ * lsn Le dernier LSN du journal inclus dans l'instantané.
+ * body Le corps encodé.
+ * maxBytesPerSecond Le débit d'écriture maximal (0 pour aucune limite).
+ */
+void writeSnapshotFile(const std::string& path, uint64_t lsn, const std::string& body, uint64_t maxBytesPerSecond) {
+    std::string header(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    BinaryWriter writer(header);
+    writer.writeU32(SNAPSHOT_VERSION);
+    writer.writeU64(lsn);
+    writer.writeU64(body.size());
+    writer.writeU32(crc32(body.data(), body.size()));
+
+    std::string tempPath = path + ".tmp";
+    int handle = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+    if (handle < 0) {
+        throw systemError("Cannot create snapshot " + tempPath);
+    }
+
+    try {
+        writeAll(handle, header.data(), header.size(), tempPath, 0);
+        writeAll(handle, body.data(), body.size(), tempPath, maxBytesPerSecond);
+        if (fsync(handle) != 0) {
+            throw systemError("Cannot sync snapshot " + tempPath);
+        }
+    } catch (...) {
+        ::close(handle);
+        std::remove(tempPath.c_str());
+        throw;
+    }
+    ::close(handle);
+
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        throw systemError("Cannot rename snapshot " + tempPath);
+    }
+
+#ifndef _WIN32
+    // Synchroniser le répertoire pour rendre le renommage durable
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int dirHandle = ::open(directory.c_str(), O_RDONLY);
+    if (dirHandle >= 0) {
+        ::fsync(dirHandle);
+        ::close(dirHandle);
+    }
+#endif
+}
+
+/**
+ * Lire un en-tête d'instantané
+ * file Le fichier projeté.
+ * Retourne L'en-tête validé.
+ */
+SnapshotHeader readSnapshotHeader(const MappedFile& file) {
+    if (file.getSize() < SNAPSHOT_HEADER_SIZE ||
+        std::memcmp(file.getData(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        throw std::runtime_error("Not a snapshot file");
+    }
+
+    BinaryReader reader(file.getData() + sizeof(SNAPSHOT_MAGIC), SNAPSHOT_HEADER_SIZE - sizeof(SNAPSHOT_MAGIC));
+    SnapshotHeader header;
+    header.version = reader.readU32();
+    header.lsn = reader.readU64();
+    header.bodySize = reader.readU64();
+    header.checksum = reader.readU32();
+
+    // Les instantanés de la version 2 restent lisibles : seule la date d'achèvement y manque
+    if (header.version != SNAPSHOT_VERSION && header.version != 2) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version));
+    }
+    if (header.bodySize != file.getSize() - SNAPSHOT_HEADER_SIZE) {
+        throw std::runtime_error("Snapshot size mismatch");
+    }
+    if (crc32(file.getData() + SNAPSHOT_HEADER_SIZE, header.bodySize) != header.checksum) {
+        throw std::runtime_error("Snapshot checksum mismatch");
+    }
+    return header;
+}
+
+/**
+ * Est un instantané
+ * Lit les premiers octets du fichier et les compare à la signature.
+ * path Le chemin du fichier.
+ * Retourne true si le fichier est un instantané, false sinon.
+ */
+bool isSnapshotFile(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    bool matches = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                   std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+    std::fclose(file);
+    return matches;
+}
+
+/**
+ * Démarrer
+ * Duplique le processus : l'enfant encode l'état (tel qu'au moment de fork, grâce à la copie-sur-écriture
+ * des pages mémoire), écrit l'instantané puis se termine avec _exit, sans exécuter les destructeurs du
+ * parent (le journal, les flux standard, etc. restent la propriété du parent). L'enfant baisse sa priorité
+ * d'ordonnancement pour ne pas concurrencer le traitement des requêtes.
+ * path Le chemin de l'instantané.
+ * snapshotLsn Le dernier LSN du journal inclus dans l'instantané.
+ * encodeBody La fonction qui encode l'état complet.
+ * maxBytesPerSecond Le débit d'écriture maximal (0 pour aucune limite).
+ */
+void BackgroundSnapshot::start(const std::string& path, uint64_t snapshotLsn,
+                               const std::function<void(BinaryWriter&)>& encodeBody, uint64_t maxBytesPerSecond) {
+    if (isRunning()) {
+        throw std::runtime_error("A snapshot is already in progress");
+    }
+
+#ifdef _WIN32
+    std::string body;
+    BinaryWriter writer(body);
+    encodeBody(writer);
+    writeSnapshotFile(path, snapshotLsn, body, 0);
+    lsn = snapshotLsn;
+    child = -1; // Terminé : signalé au prochain appel de poll
+#else
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        throw systemError("Cannot start snapshot process");
+    }
+
+    if (pid == 0) {
+        int status = 0;
+        if (::nice(10) < 0) {
+            // Priorité inchangée : l'instantané reste correct, seulement moins discret
+        }
+        try {
+            std::string body;
+            BinaryWriter writer(body);
+            encodeBody(writer);
+            writeSnapshotFile(path, snapshotLsn, body, maxBytesPerSecond);
+        } catch (const std::exception& e) {
+            std::cerr << "Snapshot error: " << e.what() << std::endl;
+            status = 1;
+        }
+        ::_exit(status);
+    }
+
+    child = pid;
+    lsn = snapshotLsn;
+#endif
+}
+
+/**
+ * Vérifier la fin
+ * Récupère le statut de l'enfant avec waitpid(WNOHANG).
+ * succeeded Reçoit true si l'enfant s'est terminé avec le code 0.
+ * finishedLsn Reçoit le LSN de l'instantané terminé.
+ * Retourne true si un instantané vient de se terminer, false sinon.
+ */
+bool BackgroundSnapshot::poll(bool& succeeded, uint64_t& finishedLsn) {
+    if (!isRunning()) return false;
+
+#ifdef _WIN32
+    succeeded = true;
+#else
+    int status = 0;
+    pid_t result = ::waitpid(static_cast<pid_t>(child), &status, WNOHANG);
+    if (result == 0) return false;
+    if (result < 0 && errno == EINTR) return false;
+    succeeded = result > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+
+    finishedLsn = lsn;
+    child = 0;
+    return true;
+}
+
+/**
+ * Attendre la fin
+ * Bloque sur waitpid jusqu'à la fin de l'enfant.
+ */
+void BackgroundSnapshot::wait() {
+    if (!isRunning()) return;
+#ifndef _WIN32
+    int status = 0;
+    while (::waitpid(static_cast<pid_t>(child), &status, 0) < 0 && errno == EINTR) {}
+#endif
+    child = 0;
+}
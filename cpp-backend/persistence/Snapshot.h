@@ -0,0 +1,150 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "BinaryCodec.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+/**
+ * Fichier projeté en mémoire en lecture seule (mmap). Le contenu est lu directement depuis le cache
+ * de pages du système, sans copie dans un tampon intermédiaire.
+ */
+class MappedFile {
+private:
+    const char* data;
+    size_t size;
+    bool mapped; // true si 'data' provient de mmap, false s'il a été alloué (repli sans mmap)
+
+public:
+    /**
+     * Initialise une projection vide.
+     */
+    MappedFile() : data(nullptr), size(0), mapped(false) {}
+
+    /**
+     * Libère la projection.
+     */
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Ouvrir
+     * Projette le fichier en mémoire. Lève une exception en cas d'erreur d'entrée/sortie.
+     * path Le chemin du fichier.
+     * Retourne false si le fichier n'existe pas, true sinon.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Fermer
+     * Libère la projection.
+     */
+    void close();
+
+    const char* getData() const { return data; }
+    size_t getSize() const { return size; }
+};
+
+/**
+ * En-tête d'un fichier d'instantané, suivi du corps encodé.
+ * Format : [magie "TMSNAP01"][version u32][lsn u64][taille du corps u64][crc du corps u32][corps]
+ */
+struct SnapshotHeader {
+    uint32_t version;  // Version du format du corps.
+    uint64_t lsn;      // Dernier LSN du journal inclus dans l'instantané.
+    uint64_t bodySize; // Taille du corps en octets.
+    uint32_t checksum; // CRC-32 du corps.
+};
+
+/**
+ * Écrire un instantané
+ * Écrit l'en-tête et le corps dans un fichier temporaire, le synchronise sur disque puis le renomme
+ * atomiquement à la place de l'instantané précédent. Lève une exception en cas d'erreur d'entrée/sortie.
+ * path Le chemin de l'instantané.
+ * lsn Le dernier LSN du journal inclus dans l'instantané.
+ * body Le corps encodé.
+ * maxBytesPerSecond Le débit d'écriture maximal (0 pour aucune limite).
+ */
+void writeSnapshotFile(const std::string& path, uint64_t lsn, const std::string& body, uint64_t maxBytesPerSecond = 0);
+
+/**
+ * Lire un en-tête d'instantané
+ * Vérifie la signature, la taille et la somme de contrôle du fichier projeté.
+ * Lève une exception si l'instantané est invalide.
+ * file Le fichier projeté.
+ * Retourne L'en-tête ; le corps commence à SNAPSHOT_HEADER_SIZE octets du début du fichier.
+ */
+SnapshotHeader readSnapshotHeader(const MappedFile& file);
+
+/**
+ * Est un instantané
+ * Indique si un fichier commence par la signature des instantanés.
+ * path Le chemin du fichier.
+ * Retourne true si le fichier est un instantané, false sinon (y compris s'il n'existe pas).
+ */
+bool isSnapshotFile(const std::string& path);
+
+/**
+ * Taille de l'en-tête d'un fichier d'instantané.
+ */
+constexpr size_t SNAPSHOT_HEADER_SIZE = 8 + 4 + 8 + 8 + 4;
+
+/**
+ * Première version du format dont les tâches portent leur date d'achèvement.
+ */
+constexpr uint32_t SNAPSHOT_VERSION_COMPLETED_AT = 3;
+
+/**
+ * Gère l'écriture d'un instantané en arrière-plan. Le processus est dupliqué (fork) : l'enfant dispose
+ * d'une vue copie-sur-écriture de l'état au moment de la duplication, l'encode et l'écrit pendant que le
+ * parent continue à servir les requêtes. Sans fork (Windows), l'instantané est écrit de façon synchrone.
+ */
+class BackgroundSnapshot {
+private:
+    long long child;   // Identifiant du processus enfant (0 si aucun)
+    uint64_t lsn;      // LSN de l'instantané en cours
+
+public:
+    /**
+     * Initialise un gestionnaire inactif.
+     */
+    BackgroundSnapshot() : child(0), lsn(0) {}
+
+    /**
+     * Démarrer
+     * Lance l'écriture d'un instantané. Lève une exception si la duplication échoue.
+     * path Le chemin de l'instantané.
+     * snapshotLsn Le dernier LSN du journal inclus dans l'instantané.
+     * encodeBody La fonction qui encode l'état complet (exécutée dans l'enfant).
+     * maxBytesPerSecond Le débit d'écriture maximal (0 pour aucune limite).
+     */
+    void start(const std::string& path, uint64_t snapshotLsn, const std::function<void(BinaryWriter&)>& encodeBody,
+               uint64_t maxBytesPerSecond = 0);
+
+    /**
+     * Vérifier la fin
+     * Vérifie sans bloquer si l'instantané en cours est terminé.
+     * succeeded Reçoit true si l'instantané a été écrit avec succès.
+     * finishedLsn Reçoit le LSN de l'instantané terminé.
+     * Retourne true si un instantané vient de se terminer, false sinon.
+     */
+    bool poll(bool& succeeded, uint64_t& finishedLsn);
+
+    /**
+     * Attendre la fin
+     * Bloque jusqu'à la fin de l'instantané en cours, s'il y en a un.
+     */
+    void wait();
+
+    /**
+     * Est en cours
+     * Retourne Vrai si un instantané est en cours d'écriture.
+     */
+    bool isRunning() const { return child != 0; }
+};
+
+#endif
@@ -0,0 +1,555 @@
+#include "TaskDump.h"
+#include "BinaryCodec.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+using json = nlohmann::json;
+
+/**
+ * Convertir une ligne en tâche
+ * L'identifiant, l'utilisateur et le titre sont obligatoires ; les autres champs prennent les valeurs par
+ * défaut de createTask. Les dates sont des horodatages en secondes (null pour aucune échéance).
+ * line La ligne JSON.
+ * Retourne Une nouvelle tâche, ou nullptr si la ligne est invalide.
+ */
+Task* parseTaskLine(const std::string& line) {
+    try {
+        json input = json::parse(line);
+        if (!input.is_object()) return nullptr;
+
+        const json& id = input.contains("id") ? input["id"] : input["taskId"];
+        if (!id.is_string() || !input["userId"].is_string() || !input["title"].is_string()) return nullptr;
+
+        int priority = input.value("priority", 2);
+        int status = input.value("status", 0);
+        if (priority < LOW || priority > HIGH || status < TO_DO || status > COMPLETED) return nullptr;
+
+        Task* task = new Task(
+            id.get<std::string>(),
+            input["title"].get<std::string>(),
+            input.value("description", input.value("Description", "")),
+            static_cast<Priority>(priority),
+            input["userId"].get<std::string>()
+        );
+
+        try {
+            task->setStatus(static_cast<Status>(status));
+            task->setIsFavorite(input.value("isFavorite", false));
+            if (input.contains("tags") && input["tags"].is_array()) {
+                task->setTags(input["tags"].get<std::vector<std::string>>());
+            }
+            if (input.contains("dueDate") && !input["dueDate"].is_null()) {
+                task->setDueDate(input["dueDate"].get<time_t>());
+            }
+            if (input.contains("createdAt") && !input["createdAt"].is_null()) {
+                task->setCreatedAt(input["createdAt"].get<time_t>());
+            }
+            if (input.contains("updatedAt") && !input["updatedAt"].is_null()) {
+                task->setUpdatedAt(input["updatedAt"].get<time_t>());
+            }
+            // Sans date d'achèvement (dump MongoDB ancien, export antérieur), l'achèvement reste non daté :
+            // la date d'importation ou de modification le placerait sur un mauvais jour
+            time_t completedAt = 0;
+            if (input.contains("completedAt") && !input["completedAt"].is_null()) {
+                completedAt = input["completedAt"].get<time_t>();
+            }
+            task->setCompletedAt(completedAt);
+        } catch (...) {
+            delete task;
+            return nullptr;
+        }
+        return task;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/**
+ * Analyser un bloc
+ * Convertit chaque ligne non vide du bloc en tâche.
+ * chunk Le bloc de lignes complètes.
+ * tasks Reçoit les tâches valides.
+ * rejected Reçoit le nombre de lignes invalides.
+ */
+static void parseChunk(const std::string& chunk, std::vector<Task*>& tasks, size_t& rejected) {
+    size_t start = 0;
+    while (start < chunk.size()) {
+        size_t end = chunk.find('\n', start);
+        if (end == std::string::npos) end = chunk.size();
+
+        size_t last = end;
+        if (last > start && chunk[last - 1] == '\r') last--;
+
+        if (last > start) {
+            Task* task = parseTaskLine(chunk.substr(start, last - start));
+            if (task) tasks.push_back(task);
+            else rejected++;
+        }
+        start = end + 1;
+    }
+}
+
+/**
+ * Constructeur
+ * path Le chemin du fichier.
+ * executor L'ordonnanceur des analyses.
+ * threads Le nombre de blocs analysés en parallèle (0 pour le nombre de threads de l'ordonnanceur).
+ * bytesPerChunk La taille approximative d'un bloc.
+ */
+NdjsonTaskReader::NdjsonTaskReader(const std::string& path, WorkStealingExecutor& executor, size_t threads,
+                                   size_t bytesPerChunk)
+    : file(std::fopen(path.c_str(), "rb")), executor(executor), threadCount(threads), chunkSize(bytesPerChunk),
+      finished(false) {
+    if (!file) {
+        throw std::runtime_error("Cannot open import file " + path);
+    }
+    if (threadCount == 0) {
+        threadCount = executor.getThreadCount();
+    }
+}
+
+/**
+ * Destructeur
+ */
+NdjsonTaskReader::~NdjsonTaskReader() {
+    std::fclose(file);
+}
+
+/**
+ * Lire un bloc
+ * La fin de la dernière ligne du bloc est conservée dans 'carry' pour le bloc suivant ; en fin de
+ * fichier, la dernière ligne est rendue même sans fin de ligne.
+ * chunk Reçoit le bloc.
+ * Retourne false si le fichier est épuisé.
+ */
+bool NdjsonTaskReader::readChunk(std::string& chunk) {
+    if (finished) return false;
+
+    chunk.swap(carry);
+    carry.clear();
+
+    size_t previous = chunk.size();
+    chunk.resize(previous + chunkSize);
+    size_t count = std::fread(&chunk[previous], 1, chunkSize, file);
+    chunk.resize(previous + count);
+
+    if (count < chunkSize) {
+        if (std::ferror(file)) {
+            throw std::runtime_error("Cannot read import file");
+        }
+        finished = true;
+        return !chunk.empty();
+    }
+
+    size_t lastNewline = chunk.find_last_of('\n');
+    if (lastNewline == std::string::npos) {
+        // Ligne plus longue qu'un bloc : la garder en entier pour le bloc suivant
+        carry.swap(chunk);
+        chunk.clear();
+        return true;
+    }
+
+    carry.assign(chunk, lastNewline + 1, std::string::npos);
+    chunk.resize(lastNewline + 1);
+    return true;
+}
+
+/**
+ * Lire le lot suivant
+ * Lit jusqu'à 'threadCount' blocs, les analyse chacun dans un travail de l'ordonnanceur, puis concatène les résultats
+ * dans l'ordre des blocs.
+ * tasks Reçoit les tâches du lot.
+ * rejected Est incrémenté du nombre de lignes invalides.
+ * Retourne false lorsque le fichier est épuisé.
+ */
+bool NdjsonTaskReader::nextBatch(std::vector<Task*>& tasks, size_t& rejected) {
+    std::vector<std::string> chunks;
+    std::string chunk;
+    while (chunks.size() < threadCount && readChunk(chunk)) {
+        if (!chunk.empty()) chunks.push_back(std::move(chunk));
+        chunk.clear();
+    }
+    if (chunks.empty()) return false;
+
+    std::vector<std::vector<Task*>> parsed(chunks.size());
+    std::vector<size_t> invalid(chunks.size(), 0);
+
+    executor.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            parseChunk(chunks[i], parsed[i], invalid[i]);
+        }
+    });
+
+    for (size_t i = 0; i < chunks.size(); i++) {
+        tasks.insert(tasks.end(), parsed[i].begin(), parsed[i].end());
+        rejected += invalid[i];
+    }
+    return true;
+}
+
+static const char DUMP_MAGIC[8] = {'T', 'M', 'D', 'U', 'M', 'P', '0', '1'};
+static const size_t DUMP_BUFFER_SIZE = 1 << 20;
+static const size_t DUMP_BLOCK_TASKS = 4096; // Tâches sérialisées par travail lors d'une écriture parallèle
+
+/**
+ * Constructeur
+ * path Le chemin du fichier, ou "-" pour la sortie standard.
+ * dumpFormat Le format du vidage.
+ */
+TaskDumpWriter::TaskDumpWriter(const std::string& path, DumpFormat dumpFormat)
+    : out(nullptr), ownsFile(path != "-"), format(dumpFormat), count(0), bytes(0) {
+    out = ownsFile ? std::fopen(path.c_str(), "wb") : stdout;
+    if (!out) {
+        throw std::runtime_error("Cannot create export file " + path);
+    }
+
+    buffer.reserve(DUMP_BUFFER_SIZE + 4096);
+    if (format == BINARY_DUMP) {
+        buffer.append(DUMP_MAGIC, sizeof(DUMP_MAGIC));
+    }
+}
+
+/**
+ * Destructeur
+ */
+TaskDumpWriter::~TaskDumpWriter() {
+    if (out && ownsFile) {
+        std::fclose(out);
+    }
+}
+
+/**
+ * Vider le tampon
+ */
+void TaskDumpWriter::flushBuffer() {
+    if (buffer.empty()) return;
+    if (std::fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size()) {
+        throw std::runtime_error("Cannot write export file");
+    }
+    bytes += buffer.size();
+    buffer.clear();
+}
+
+/**
+ * Sérialiser une tâche
+ * Ajoute l'enregistrement de la tâche (ligne JSON, ou longueur puis tâche encodée) à la fin de 'out'.
+ * out La chaîne de destination.
+ * task La tâche.
+ * format Le format du vidage.
+ */
+static void appendTask(std::string& out, const Task& task, DumpFormat format) {
+    if (format == NDJSON_DUMP) {
+        out += task.toJson();
+        out += '\n';
+    } else {
+        size_t start = out.size();
+        BinaryWriter writer(out);
+        writer.writeU32(0);
+        encodeTask(writer, task);
+
+        uint32_t length = static_cast<uint32_t>(out.size() - start - 4);
+        for (int i = 0; i < 4; i++) {
+            out[start + i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+        }
+    }
+}
+
+/**
+ * Écrire une tâche
+ * task La tâche à écrire.
+ */
+void TaskDumpWriter::write(const Task& task) {
+    appendTask(buffer, task, format);
+
+    count++;
+    if (buffer.size() >= DUMP_BUFFER_SIZE) {
+        flushBuffer();
+    }
+}
+
+/**
+ * Écrire des tâches en parallèle
+ * Chaque tour sérialise jusqu'à quatre blocs de DUMP_BLOCK_TASKS tâches par thread, puis ajoute les blocs
+ * au tampon dans l'ordre.
+ * tasks Les tâches à écrire.
+ * executor L'ordonnanceur (nullptr pour écrire sur le thread courant).
+ */
+void TaskDumpWriter::writeAll(const std::vector<const Task*>& tasks, WorkStealingExecutor* executor) {
+    if (!executor || executor->getThreadCount() == 1) {
+        for (const Task* task : tasks) write(*task);
+        return;
+    }
+
+    std::vector<std::string> blocks(executor->getThreadCount() * 4);
+    size_t roundSize = blocks.size() * DUMP_BLOCK_TASKS;
+
+    for (size_t start = 0; start < tasks.size(); start += roundSize) {
+        size_t end = std::min(tasks.size(), start + roundSize);
+        size_t blockCount = (end - start + DUMP_BLOCK_TASKS - 1) / DUMP_BLOCK_TASKS;
+
+        executor->parallelFor(blockCount, 1, [&](size_t first, size_t last) {
+            for (size_t block = first; block < last; block++) {
+                std::string& out = blocks[block];
+                out.clear();
+                size_t from = start + block * DUMP_BLOCK_TASKS;
+                size_t to = std::min(end, from + DUMP_BLOCK_TASKS);
+                for (size_t i = from; i < to; i++) {
+                    appendTask(out, *tasks[i], format);
+                }
+            }
+        });
+
+        for (size_t block = 0; block < blockCount; block++) {
+            buffer += blocks[block];
+            if (buffer.size() >= DUMP_BUFFER_SIZE) {
+                flushBuffer();
+            }
+        }
+        count += end - start;
+    }
+}
+
+/**
+ * Terminer
+ * Vide le tampon, puis ferme le fichier (ou vide la sortie standard).
+ */
+void TaskDumpWriter::finish() {
+    flushBuffer();
+
+    int result = ownsFile ? std::fclose(out) : std::fflush(out);
+    if (ownsFile) out = nullptr;
+    if (result != 0) {
+        throw std::runtime_error("Cannot write export file");
+    }
+}
+
+/**
+ * Analyser un format de vidage
+ * text "ndjson" ou "binary".
+ * format Reçoit le format.
+ * Retourne true si le texte est reconnu, false sinon.
+ */
+bool parseDumpFormat(const std::string& text, DumpFormat& format) {
+    if (text == "ndjson") { format = NDJSON_DUMP; return true; }
+    if (text == "binary") { format = BINARY_DUMP; return true; }
+    return false;
+}
+
+/**
+ * Est un vidage binaire
+ * path Le chemin du fichier.
+ * Retourne true si le fichier commence par la signature des vidages binaires.
+ */
+bool isBinaryDumpFile(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    char magic[sizeof(DUMP_MAGIC)];
+    bool matches = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                   std::memcmp(magic, DUMP_MAGIC, sizeof(magic)) == 0;
+    std::fclose(file);
+    return matches;
+}
+
+/**
+ * Constructeur
+ * path Le chemin du fichier.
+ */
+BinaryTaskReader::BinaryTaskReader(const std::string& path) : file(std::fopen(path.c_str(), "rb")) {
+    if (!file) {
+        throw std::runtime_error("Cannot open import file " + path);
+    }
+
+    char magic[sizeof(DUMP_MAGIC)];
+    if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        std::memcmp(magic, DUMP_MAGIC, sizeof(magic)) != 0) {
+        std::fclose(file);
+        throw std::runtime_error("Not a binary task dump: " + path);
+    }
+}
+
+/**
+ * Destructeur
+ */
+BinaryTaskReader::~BinaryTaskReader() {
+    std::fclose(file);
+}
+
+/**
+ * Lire la tâche suivante
+ * Retourne Une nouvelle tâche, ou nullptr en fin de fichier.
+ */
+Task* BinaryTaskReader::next() {
+    char lengthBytes[4];
+    size_t got = std::fread(lengthBytes, 1, sizeof(lengthBytes), file);
+    if (got == 0) return nullptr;
+    if (got != sizeof(lengthBytes)) {
+        throw std::runtime_error("Truncated binary task dump");
+    }
+
+    BinaryReader lengthReader(lengthBytes, sizeof(lengthBytes));
+    uint32_t length = lengthReader.readU32();
+
+    record.resize(length);
+    if (length > 0 && std::fread(&record[0], 1, length, file) != length) {
+        throw std::runtime_error("Truncated binary task dump");
+    }
+
+    BinaryReader reader(record.data(), record.size());
+    return decodeTask(reader);
+}
+
+/**
+ * Destructeur
+ */
+BackgroundExport::~BackgroundExport() {
+    wait();
+}
+
+/**
+ * Démarrer
+ * Duplique le processus : l'enfant écrit le vidage à partir de la mémoire telle qu'au moment de fork, envoie
+ * son bilan ("nombre octets", ou "!message" en cas d'échec) dans le tube puis se termine avec _exit, sans
+ * exécuter les destructeurs du parent. L'enfant baisse sa priorité d'ordonnancement pour ne pas concurrencer
+ * le traitement des requêtes.
+ * path Le chemin du fichier.
+ * format Le format du vidage.
+ * exportLsn Le dernier LSN du journal visible par l'exportation.
+ * writeTasks La fonction qui écrit les tâches.
+ */
+void BackgroundExport::start(const std::string& path, DumpFormat format, uint64_t exportLsn,
+                             const std::function<void(TaskDumpWriter&)>& writeTasks) {
+    if (isRunning()) {
+        throw std::runtime_error("An export is already in progress");
+    }
+
+    current = ExportReport();
+    current.path = path;
+    current.lsn = exportLsn;
+    startedAt = std::chrono::steady_clock::now();
+
+#ifdef _WIN32
+    try {
+        TaskDumpWriter dump(path, format);
+        writeTasks(dump);
+        dump.finish();
+        current.succeeded = true;
+        current.count = dump.getCount();
+        current.bytes = dump.getBytes();
+    } catch (const std::exception& e) {
+        current.error = e.what();
+    }
+    child = -1; // Terminé : signalé au prochain appel de poll
+#else
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        throw std::runtime_error(std::string("Cannot start export process: ") + std::strerror(errno));
+    }
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        int error = errno;
+        ::close(fds[0]);
+        ::close(fds[1]);
+        throw std::runtime_error(std::string("Cannot start export process: ") + std::strerror(error));
+    }
+
+    if (pid == 0) {
+        ::close(fds[0]);
+        if (::nice(10) < 0) {
+            // Priorité inchangée : l'exportation reste correcte, seulement moins discrète
+        }
+
+        int status = 0;
+        std::string message;
+        try {
+            TaskDumpWriter dump(path, format);
+            writeTasks(dump);
+            dump.finish();
+            message = std::to_string(dump.getCount()) + " " + std::to_string(dump.getBytes());
+        } catch (const std::exception& e) {
+            message = std::string("!") + e.what();
+            status = 1;
+        }
+
+        // Bilan plus court que PIPE_BUF : une seule écriture, jamais bloquante
+        if (::write(fds[1], message.data(), message.size()) < 0) {
+            status = 1;
+        }
+        ::_exit(status);
+    }
+
+    ::close(fds[1]);
+    reportFd = fds[0];
+    child = pid;
+#endif
+}
+
+/**
+ * Vérifier la fin
+ * Récupère le statut de l'enfant avec waitpid(WNOHANG), puis lit son bilan dans le tube.
+ * report Reçoit le bilan de l'exportation terminée.
+ * Retourne true si une exportation vient de se terminer, false sinon.
+ */
+bool BackgroundExport::poll(ExportReport& report) {
+    if (!isRunning()) return false;
+
+#ifndef _WIN32
+    int status = 0;
+    pid_t result = ::waitpid(static_cast<pid_t>(child), &status, WNOHANG);
+    if (result == 0) return false;
+    if (result < 0 && errno == EINTR) return false;
+
+    std::string message;
+    char buffer[512];
+    ssize_t got;
+    while ((got = ::read(reportFd, buffer, sizeof(buffer))) != 0) {
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        message.append(buffer, static_cast<size_t>(got));
+    }
+    ::close(reportFd);
+    reportFd = -1;
+
+    bool exited = result > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (exited && !message.empty() && message[0] != '!') {
+        char* end = nullptr;
+        current.count = static_cast<size_t>(std::strtoull(message.c_str(), &end, 10));
+        current.bytes = std::strtoull(end, nullptr, 10);
+        current.succeeded = true;
+    } else {
+        current.error = !message.empty() && message[0] == '!' ? message.substr(1) : "Export process failed";
+    }
+#endif
+
+    current.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count();
+    report = current;
+    child = 0;
+    return true;
+}
+
+/**
+ * Attendre la fin
+ * Bloque sur waitpid jusqu'à la fin de l'enfant ; le bilan est abandonné.
+ */
+void BackgroundExport::wait() {
+    if (!isRunning()) return;
+#ifndef _WIN32
+    int status = 0;
+    while (::waitpid(static_cast<pid_t>(child), &status, 0) < 0 && errno == EINTR) {}
+    ::close(reportFd);
+    reportFd = -1;
+#endif
+    child = 0;
+}
@@ -0,0 +1,281 @@
+#ifndef TASKDUMP_H
+#define TASKDUMP_H
+
+#include "../models/Task.h"
+#include "../runtime/WorkStealingExecutor.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <functional>
+
+/**
+ * Convertit une ligne JSON de vidage (une tâche par ligne) en tâche.
+ * Accepte le format de Task::toJson ("id") comme celui des requêtes de création ("taskId").
+ * line La ligne JSON.
+ * Retourne Une nouvelle tâche allouée dynamiquement, ou nullptr si la ligne est invalide.
+ */
+Task* parseTaskLine(const std::string& line);
+
+/**
+ * Lecteur de vidage NDJSON (une tâche JSON par ligne). Le fichier est lu par blocs et chaque lot de
+ * blocs est analysé en parallèle sur l'ordonnanceur, un bloc par travail ; les tâches sont rendues dans
+ * l'ordre du fichier. La mémoire utilisée reste bornée par la taille d'un lot, quelle que soit la taille
+ * du fichier.
+ */
+class NdjsonTaskReader {
+private:
+    std::FILE* file;
+    WorkStealingExecutor& executor;
+    size_t threadCount; // Blocs par lot
+    size_t chunkSize;
+    std::string carry; // Début de la dernière ligne du bloc précédent, incomplète
+    bool finished;
+
+    /**
+     * Lire un bloc
+     * Lit environ 'chunkSize' octets et coupe le bloc après sa dernière fin de ligne.
+     * chunk Reçoit le bloc de lignes complètes.
+     * Retourne false si le fichier est épuisé.
+     */
+    bool readChunk(std::string& chunk);
+
+public:
+    /**
+     * Ouvre le fichier à lire. Lève une exception si le fichier ne peut pas être ouvert.
+     * path Le chemin du fichier.
+     * executor L'ordonnanceur des analyses.
+     * threads Le nombre de blocs analysés en parallèle (0 pour le nombre de threads de l'ordonnanceur).
+     * bytesPerChunk La taille approximative d'un bloc.
+     */
+    NdjsonTaskReader(const std::string& path, WorkStealingExecutor& executor, size_t threads = 0,
+                     size_t bytesPerChunk = 4 << 20);
+
+    /**
+     * Ferme le fichier.
+     */
+    ~NdjsonTaskReader();
+
+    NdjsonTaskReader(const NdjsonTaskReader&) = delete;
+    NdjsonTaskReader& operator=(const NdjsonTaskReader&) = delete;
+
+    /**
+     * Lire le lot suivant
+     * Analyse en parallèle le lot de blocs suivant.
+     * tasks Reçoit les tâches du lot, dans l'ordre du fichier (la mémoire appartient à l'appelant).
+     * rejected Est incrémenté du nombre de lignes invalides.
+     * Retourne false lorsque le fichier est épuisé.
+     */
+    bool nextBatch(std::vector<Task*>& tasks, size_t& rejected);
+
+    /**
+     * Obtenir le nombre de threads
+     * Retourne Le nombre de blocs analysés en parallèle.
+     */
+    size_t getThreadCount() const { return threadCount; }
+};
+
+/**
+ * Format d'un vidage de tâches.
+ */
+enum DumpFormat {
+    NDJSON_DUMP,  // Une tâche JSON (Task::toJson) par ligne
+    BINARY_DUMP   // Signature "TMDUMP01" puis, par tâche : [longueur u32][tâche encodée par encodeTask]
+};
+
+/**
+ * Écrivain de vidage en flux : chaque tâche est sérialisée puis ajoutée à un tampon de taille fixe vidé
+ * dans le fichier dès qu'il est plein, de sorte que la mémoire utilisée ne dépend pas du nombre de tâches.
+ */
+class TaskDumpWriter {
+private:
+    std::FILE* out;
+    bool ownsFile;      // false pour la sortie standard
+    DumpFormat format;
+    std::string buffer;
+    size_t count;
+    uint64_t bytes;
+
+    /**
+     * Vider le tampon
+     * Écrit le tampon dans le fichier. Lève une exception en cas d'erreur d'écriture.
+     */
+    void flushBuffer();
+
+public:
+    /**
+     * Ouvre le fichier de destination. Lève une exception si le fichier ne peut pas être créé.
+     * path Le chemin du fichier, ou "-" pour la sortie standard.
+     * dumpFormat Le format du vidage.
+     */
+    TaskDumpWriter(const std::string& path, DumpFormat dumpFormat);
+
+    /**
+     * Ferme le fichier (sans lever d'exception ; appeler finish pour détecter les erreurs).
+     */
+    ~TaskDumpWriter();
+
+    TaskDumpWriter(const TaskDumpWriter&) = delete;
+    TaskDumpWriter& operator=(const TaskDumpWriter&) = delete;
+
+    /**
+     * Écrire une tâche
+     * task La tâche à écrire.
+     */
+    void write(const Task& task);
+
+    /**
+     * Écrire des tâches en parallèle
+     * Sérialise les tâches par blocs sur l'ordonnanceur, quelques blocs par thread à la fois, puis les écrit
+     * dans l'ordre : la mémoire reste bornée et le fichier est identique à une suite d'appels à write.
+     * tasks Les tâches à écrire.
+     * executor L'ordonnanceur (nullptr pour écrire sur le thread courant).
+     */
+    void writeAll(const std::vector<const Task*>& tasks, WorkStealingExecutor* executor);
+
+    /**
+     * Terminer
+     * Vide le tampon et ferme le fichier. Lève une exception en cas d'erreur d'écriture.
+     */
+    void finish();
+
+    /**
+     * Obtenir le nombre de tâches écrites
+     */
+    size_t getCount() const { return count; }
+
+    /**
+     * Obtenir le nombre d'octets écrits
+     */
+    uint64_t getBytes() const { return bytes; }
+};
+
+/**
+ * Analyser un format de vidage
+ * text "ndjson" ou "binary".
+ * format Reçoit le format.
+ * Retourne true si le texte est reconnu, false sinon.
+ */
+bool parseDumpFormat(const std::string& text, DumpFormat& format);
+
+/**
+ * Est un vidage binaire
+ * Indique si un fichier commence par la signature des vidages binaires.
+ * path Le chemin du fichier.
+ * Retourne true si le fichier est un vidage binaire, false sinon.
+ */
+bool isBinaryDumpFile(const std::string& path);
+
+/**
+ * Lecteur de vidage binaire (format BINARY_DUMP), enregistrement par enregistrement.
+ */
+class BinaryTaskReader {
+private:
+    std::FILE* file;
+    std::string record;
+
+public:
+    /**
+     * Ouvre le fichier et vérifie sa signature. Lève une exception si le fichier est invalide.
+     * path Le chemin du fichier.
+     */
+    explicit BinaryTaskReader(const std::string& path);
+
+    /**
+     * Ferme le fichier.
+     */
+    ~BinaryTaskReader();
+
+    BinaryTaskReader(const BinaryTaskReader&) = delete;
+    BinaryTaskReader& operator=(const BinaryTaskReader&) = delete;
+
+    /**
+     * Lire la tâche suivante
+     * Lève une exception si le fichier est tronqué.
+     * Retourne Une nouvelle tâche (la mémoire appartient à l'appelant), ou nullptr en fin de fichier.
+     */
+    Task* next();
+};
+
+/**
+ * Bilan d'une exportation en arrière-plan.
+ */
+struct ExportReport {
+    bool succeeded = false;
+    std::string path;      // Fichier écrit
+    uint64_t lsn = 0;      // Dernier LSN du journal visible par l'exportation
+    size_t count = 0;      // Tâches écrites
+    uint64_t bytes = 0;    // Octets écrits
+    double seconds = 0;    // Durée totale
+    std::string error;     // Message d'erreur en cas d'échec
+};
+
+/**
+ * Exportation en arrière-plan : comme les instantanés, le processus est dupliqué et l'enfant parcourt la
+ * mémoire telle qu'au moment de fork. La copie-sur-écriture des pages tient lieu de version figée de
+ * l'état : l'enfant lit sans verrou une vue cohérente pendant que le parent continue d'appliquer les
+ * mutations, et les pages copiées sont libérées dès que l'enfant se termine. L'enfant rend son bilan
+ * par un tube.
+ */
+class BackgroundExport {
+private:
+    long long child;   // Identifiant du processus enfant (0 si aucun)
+    int reportFd;      // Extrémité de lecture du tube de bilan (-1 si aucune)
+    ExportReport current;
+    std::chrono::steady_clock::time_point startedAt;
+
+public:
+    /**
+     * Initialise un gestionnaire inactif.
+     */
+    BackgroundExport() : child(0), reportFd(-1) {}
+
+    /**
+     * Attend l'exportation en cours, s'il y en a une.
+     */
+    ~BackgroundExport();
+
+    BackgroundExport(const BackgroundExport&) = delete;
+    BackgroundExport& operator=(const BackgroundExport&) = delete;
+
+    /**
+     * Démarrer
+     * Lance l'exportation. Lève une exception si une exportation est en cours ou si la duplication échoue.
+     * path Le chemin du fichier.
+     * format Le format du vidage.
+     * exportLsn Le dernier LSN du journal visible par l'exportation.
+     * writeTasks La fonction qui écrit les tâches (exécutée dans l'enfant).
+     */
+    void start(const std::string& path, DumpFormat format, uint64_t exportLsn,
+               const std::function<void(TaskDumpWriter&)>& writeTasks);
+
+    /**
+     * Vérifier la fin
+     * Vérifie sans bloquer si l'exportation en cours est terminée.
+     * report Reçoit le bilan de l'exportation terminée.
+     * Retourne true si une exportation vient de se terminer, false sinon.
+     */
+    bool poll(ExportReport& report);
+
+    /**
+     * Attendre la fin
+     * Bloque jusqu'à la fin de l'exportation en cours, s'il y en a une.
+     */
+    void wait();
+
+    /**
+     * Est en cours
+     * Retourne Vrai si une exportation est en cours.
+     */
+    bool isRunning() const { return child != 0; }
+
+    /**
+     * Obtenir l'exportation en cours
+     * Retourne Le chemin et le LSN de l'exportation en cours.
+     */
+    const ExportReport& getCurrent() const { return current; }
+};
+
+#endif
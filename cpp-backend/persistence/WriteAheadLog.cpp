@@ -0,0 +1,598 @@
+#include "WriteAheadLog.h"
+#include "BinaryCodec.h"
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#define fsync _commit
+#define ftruncate _chsize
+#else
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+namespace fs = std::filesystem;
+
+/**
+ * Lever une erreur système
+ * Construit une exception à partir du message et de la valeur courante de errno.
+ */
+static std::runtime_error systemError(const std::string& message) {
+    return std::runtime_error(message + ": " + std::strerror(errno));
+}
+
+/**
+ * Constructeur
+ * Initialise un journal fermé, sans thread de synchronisation.
+ */
+WriteAheadLog::WriteAheadLog()
+    : fd(-1), activeBytes(0), policy(FSYNC_ALWAYS), intervalMs(0), nextLsn(1), stopping(false), dirty(false),
+      failed(false) {}
+
+/**
+ * Destructeur
+ * Ferme le journal en ignorant les erreurs (un destructeur ne doit pas lever d'exception).
+ */
+WriteAheadLog::~WriteAheadLog() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << "Write-ahead log close error: " << e.what() << std::endl;
+    }
+}
+
+/**
+ * Lister les segments scellés
+ * Recherche dans le répertoire du journal les fichiers nommés '<nom du journal>.<LSN>'.
+ * Retourne Les segments scellés, triés par LSN croissant.
+ */
+std::vector<std::pair<uint64_t, std::string>> WriteAheadLog::listSealedSegments() const {
+    std::vector<std::pair<uint64_t, std::string>> segments;
+
+    fs::path activePath(path);
+    fs::path directory = activePath.has_parent_path() ? activePath.parent_path() : fs::path(".");
+    std::string prefix = activePath.filename().string() + ".";
+
+    std::error_code error;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        std::string name = it->path().filename().string();
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+
+        std::string suffix = name.substr(prefix.size());
+        if (suffix.find_first_not_of("0123456789") != std::string::npos) continue;
+
+        segments.emplace_back(std::stoull(suffix), it->path().string());
+    }
+
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+/**
+ * Lire un fichier
+ * Lit le contenu complet d'un descripteur ouvert.
+ * handle Le descripteur.
+ * filePath Le chemin du fichier (pour les messages d'erreur).
+ * Retourne Le contenu du fichier.
+ */
+static std::string readAll(int handle, const std::string& filePath) {
+    std::string contents;
+    char chunk[65536];
+    while (true) {
+        auto count = ::read(handle, chunk, sizeof(chunk));
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("Cannot read write-ahead log " + filePath);
+        }
+        if (count == 0) break;
+        contents.append(chunk, static_cast<size_t>(count));
+    }
+    return contents;
+}
+
+/**
+ * Parcourir les enregistrements
+ * Valide chaque enregistrement encadré (longueur, CRC, LSN croissant à partir de 'minLsn') et le passe
+ * à 'visit'. Le parcours s'arrête au premier enregistrement invalide ou lorsque 'visit' retourne false.
+ * contents Le contenu d'un segment.
+ * minLsn Le plus petit LSN acceptable ; reçoit le LSN suivant le dernier enregistrement valide.
+ * visit La fonction appelée pour chaque enregistrement valide.
+ * Retourne La taille de la partie valide parcourue.
+ */
+static size_t scanRecords(const std::string& contents, uint64_t& minLsn,
+                          const std::function<bool(const LogRecord&)>& visit) {
+    size_t offset = 0;
+    while (contents.size() - offset >= WriteAheadLog::HEADER_SIZE) {
+        BinaryReader header(contents.data() + offset, WriteAheadLog::HEADER_SIZE);
+        uint32_t length = header.readU32();
+        uint32_t checksum = header.readU32();
+        uint64_t lsn = header.readU64();
+
+        if (length > contents.size() - offset - WriteAheadLog::HEADER_SIZE) break;
+
+        const char* body = contents.data() + offset + 8;
+        if (crc32(body, 9 + length) != checksum || lsn < minLsn) break;
+
+        LogRecord record;
+        record.lsn = lsn;
+        record.type = static_cast<RecordType>(static_cast<uint8_t>(body[8]));
+        record.payload.assign(body + 9, length);
+        if (!visit(record)) break;
+
+        minLsn = lsn + 1;
+        offset += WriteAheadLog::HEADER_SIZE + length;
+    }
+    return offset;
+}
+
+/**
+ * Lire un segment
+ * Lit le segment en entier et valide chaque enregistrement (longueur, CRC, LSN croissant). La lecture
+ * s'arrête au premier enregistrement invalide, qui correspond à une écriture interrompue.
+ * handle Le descripteur du segment ouvert.
+ * segmentPath Le chemin du segment (pour les messages d'erreur).
+ * replay La fonction appelée pour chaque enregistrement relu.
+ * afterLsn Les enregistrements jusqu'à ce LSN sont validés mais pas rejoués.
+ * validBytes Reçoit la taille de la partie valide du segment.
+ * Retourne La taille totale du segment.
+ */
+uint64_t WriteAheadLog::readSegment(int handle, const std::string& segmentPath,
+                                    const std::function<void(const LogRecord&)>& replay, uint64_t afterLsn,
+                                    uint64_t& validBytes) {
+    std::string contents = readAll(handle, segmentPath);
+
+    validBytes = scanRecords(contents, nextLsn, [&](const LogRecord& record) {
+        if (record.lsn > afterLsn) replay(record);
+        return true;
+    });
+    return contents.size();
+}
+
+/**
+ * Lire les enregistrements validés
+ * Parcourt les segments scellés dont le dernier LSN dépasse 'afterLsn', puis le segment actif. Seules les
+ * données déjà écrites sont lues : les enregistrements en attente de validation n'y figurent pas encore.
+ * afterLsn Seuls les enregistrements de LSN strictement supérieur sont rendus.
+ * maxRecords Le nombre maximal d'enregistrements rendus.
+ * visit La fonction appelée pour chaque enregistrement, dans l'ordre des LSN.
+ * Retourne Le plus petit LSN encore conservé sur disque (0 si le journal est vide).
+ */
+uint64_t WriteAheadLog::readCommitted(uint64_t afterLsn, size_t maxRecords,
+                                      const std::function<void(const LogRecord&)>& visit) const {
+    if (!isOpen()) {
+        throw std::runtime_error("Write-ahead log is not open");
+    }
+
+    // Les segments scellés entièrement antérieurs à 'afterLsn' ne sont pas relus, sauf le plus ancien,
+    // qui fournit le plus petit LSN conservé
+    std::vector<std::string> files;
+    for (const auto& segment : listSealedSegments()) {
+        if (!files.empty() && segment.first <= afterLsn) continue;
+        files.push_back(segment.second);
+    }
+    files.push_back(path);
+
+    uint64_t oldestLsn = 0;
+    size_t delivered = 0;
+    bool first = true;
+
+    for (const std::string& filePath : files) {
+        if (delivered >= maxRecords) break;
+
+        int handle = ::open(filePath.c_str(), O_RDONLY | O_BINARY);
+        if (handle < 0) {
+            if (errno == ENOENT) continue; // Segment supprimé par un point de contrôle entre-temps
+            throw systemError("Cannot open write-ahead log " + filePath);
+        }
+        std::string contents;
+        try {
+            contents = readAll(handle, filePath);
+        } catch (...) {
+            ::close(handle);
+            throw;
+        }
+        ::close(handle);
+
+        uint64_t minLsn = 0;
+        scanRecords(contents, minLsn, [&](const LogRecord& record) {
+            if (first) {
+                oldestLsn = record.lsn;
+                first = false;
+            }
+            if (record.lsn <= afterLsn) return true;
+            if (delivered >= maxRecords) return false;
+            visit(record);
+            delivered++;
+            return true;
+        });
+    }
+    return oldestLsn;
+}
+
+/**
+ * Ouvrir
+ * Les segments scellés entièrement couverts par l'instantané (dont le dernier LSN est inférieur ou égal
+ * à 'afterLsn') sont supprimés sans être lus ; ils subsistent si le programme s'est arrêté entre la fin
+ * d'un instantané et leur suppression. Les autres sont rejoués dans l'ordre, puis le segment actif, dont
+ * une fin invalide (écriture interrompue) est tronquée.
+ * filePath Le chemin du segment actif du journal.
+ * fsyncPolicy La politique de synchronisation sur disque.
+ * fsyncIntervalMs L'intervalle de synchronisation en millisecondes (FSYNC_INTERVAL).
+ * replay La fonction appelée pour chaque enregistrement relu.
+ * afterLsn Les enregistrements dont le LSN est inférieur ou égal sont déjà couverts par un instantané :
+ * ils sont validés mais pas rejoués, et les nouveaux LSN commencent après cette valeur.
+ */
+void WriteAheadLog::open(const std::string& filePath, FsyncPolicy fsyncPolicy, int fsyncIntervalMs,
+                         const std::function<void(const LogRecord&)>& replay, uint64_t afterLsn) {
+    if (isOpen()) {
+        throw std::runtime_error("Write-ahead log is already open");
+    }
+
+    path = filePath;
+
+    for (const auto& segment : listSealedSegments()) {
+        if (segment.first <= afterLsn) {
+            std::remove(segment.second.c_str());
+            continue;
+        }
+
+        int sealed = ::open(segment.second.c_str(), O_RDONLY | O_BINARY);
+        if (sealed < 0) {
+            throw systemError("Cannot open write-ahead log " + segment.second);
+        }
+        uint64_t validBytes = 0;
+        uint64_t totalBytes = 0;
+        try {
+            totalBytes = readSegment(sealed, segment.second, replay, afterLsn, validBytes);
+        } catch (...) {
+            ::close(sealed);
+            throw;
+        }
+        ::close(sealed);
+
+        if (validBytes != totalBytes) {
+            std::cerr << "Write-ahead log: ignoring " << (totalBytes - validBytes)
+                      << " bytes of corrupt records in " << segment.second << std::endl;
+        }
+    }
+
+    int handle = ::open(filePath.c_str(), O_RDWR | O_CREAT | O_BINARY, 0644);
+    if (handle < 0) {
+        throw systemError("Cannot open write-ahead log " + filePath);
+    }
+
+    uint64_t offset = 0;
+    uint64_t totalBytes = 0;
+    try {
+        totalBytes = readSegment(handle, filePath, replay, afterLsn, offset);
+    } catch (...) {
+        ::close(handle);
+        throw;
+    }
+
+    if (nextLsn <= afterLsn) {
+        nextLsn = afterLsn + 1;
+    }
+
+    if (offset != totalBytes) {
+        std::cerr << "Write-ahead log: discarding " << (totalBytes - offset)
+                  << " bytes of incomplete or corrupt records" << std::endl;
+        if (ftruncate(handle, static_cast<off_t>(offset)) != 0) {
+            ::close(handle);
+            throw systemError("Cannot truncate write-ahead log " + filePath);
+        }
+    }
+
+    if (::lseek(handle, 0, SEEK_END) < 0) {
+        ::close(handle);
+        throw systemError("Cannot seek write-ahead log " + filePath);
+    }
+
+    fd = handle;
+    activeBytes = offset;
+    policy = fsyncPolicy;
+    intervalMs = fsyncIntervalMs > 0 ? fsyncIntervalMs : 1;
+    stopping = false;
+    dirty = false;
+
+    if (policy == FSYNC_INTERVAL) {
+        syncThread = std::thread(&WriteAheadLog::syncLoop, this);
+    }
+}
+
+/**
+ * Ajouter
+ * Encadre l'enregistrement (longueur, CRC-32 du LSN, du type et du contenu) et l'ajoute au tampon.
+ * type Le type de l'enregistrement.
+ * payload Le contenu binaire de l'enregistrement.
+ * Retourne Le LSN attribué à l'enregistrement.
+ */
+uint64_t WriteAheadLog::append(RecordType type, const std::string& payload) {
+    uint64_t lsn = nextLsn++;
+
+    size_t start = pending.size();
+    BinaryWriter writer(pending);
+    writer.writeU32(static_cast<uint32_t>(payload.size()));
+    writer.writeU32(0);
+    writer.writeU64(lsn);
+    writer.writeU8(type);
+    pending.append(payload);
+
+    uint32_t checksum = crc32(pending.data() + start + 8, 9 + payload.size());
+    for (int i = 0; i < 4; i++) {
+        pending[start + 4 + i] = static_cast<char>((checksum >> (8 * i)) & 0xFF);
+    }
+    return lsn;
+}
+
+/**
+ * Valider (commit)
+ * Écrit le tampon en entier (en gérant les écritures partielles), puis synchronise immédiatement
+ * (FSYNC_ALWAYS) ou signale au thread d'arrière-plan qu'une synchronisation est nécessaire (FSYNC_INTERVAL).
+ * Les enregistrements validés sont ensuite transmis à l'écouteur de validation, s'il y en a un.
+ * Si l'écriture ou la synchronisation échoue, le segment est tronqué à sa taille d'avant l'écriture pour
+ * ne pas laisser de fin partielle, le tampon est vidé et le journal passe en échec : il n'y a pas de
+ * nouvelle tentative, car l'état en mémoire contient désormais des mutations qui ne sont pas journalisées.
+ */
+void WriteAheadLog::commit() {
+    if (!isOpen()) return;
+    if (failed) {
+        pending.clear();
+        throw std::runtime_error("Write-ahead log is unusable after an earlier failure: " + getFailure());
+    }
+    if (pending.empty()) return;
+
+    uint64_t startBytes = activeBytes;
+    try {
+        size_t written = 0;
+        while (written < pending.size()) {
+            auto count = ::write(fd, pending.data() + written, static_cast<unsigned>(pending.size() - written));
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                throw systemError("Cannot write write-ahead log " + path);
+            }
+            written += static_cast<size_t>(count);
+        }
+
+        if (policy == FSYNC_ALWAYS) {
+            syncToDisk();
+        }
+    } catch (const std::exception& e) {
+        pending.clear();
+        markFailed(e.what());
+        if (ftruncate(fd, static_cast<off_t>(startBytes)) != 0 || ::lseek(fd, static_cast<off_t>(startBytes), SEEK_SET) < 0) {
+            std::cerr << systemError("Cannot truncate write-ahead log " + path).what() << std::endl;
+        }
+        throw;
+    }
+    activeBytes += pending.size();
+
+    if (policy == FSYNC_INTERVAL) {
+        std::lock_guard<std::mutex> lock(syncMutex);
+        dirty = true;
+    }
+
+    if (commitListener) {
+        std::vector<LogRecord> records;
+        uint64_t minLsn = 0;
+        scanRecords(pending, minLsn, [&records](const LogRecord& record) {
+            records.push_back(record);
+            return true;
+        });
+        pending.clear();
+        commitListener(records);
+    } else {
+        pending.clear();
+    }
+}
+
+/**
+ * Marquer en échec
+ * Seule la première cause est conservée : c'est elle qui explique l'état du journal.
+ * reason La cause de l'échec.
+ */
+void WriteAheadLog::markFailed(const std::string& reason) {
+    std::lock_guard<std::mutex> lock(syncMutex);
+    if (failed) return;
+    failure = reason;
+    failed = true;
+}
+
+/**
+ * Obtenir la cause de l'échec
+ * Retourne Le message de l'erreur qui a mis le journal en échec (vide sinon).
+ */
+std::string WriteAheadLog::getFailure() {
+    std::lock_guard<std::mutex> lock(syncMutex);
+    return failure;
+}
+
+/**
+ * Synchroniser
+ * Appelle fdatasync (ou fsync) sur le fichier du journal.
+ */
+void WriteAheadLog::syncToDisk() {
+#if defined(__linux__)
+    int result = ::fdatasync(fd);
+#else
+    int result = fsync(fd);
+#endif
+    if (result != 0) {
+        throw systemError("Cannot sync write-ahead log " + path);
+    }
+}
+
+/**
+ * Boucle de synchronisation
+ * Se réveille toutes les 'intervalMs' millisecondes et synchronise le fichier si des données ont été écrites
+ * depuis la dernière synchronisation. Ainsi au plus 'intervalMs' millisecondes de mutations validées
+ * peuvent être perdues en cas de panne du système. Un échec de synchronisation met le journal en échec.
+ */
+void WriteAheadLog::syncLoop() {
+    std::unique_lock<std::mutex> lock(syncMutex);
+
+    while (!stopping) {
+        syncCondition.wait_for(lock, std::chrono::milliseconds(intervalMs));
+        if (!dirty) continue;
+
+        dirty = false;
+        lock.unlock();
+        try {
+            std::lock_guard<std::mutex> fdLock(fdMutex);
+            syncToDisk();
+        } catch (const std::exception& e) {
+            // Des mutations déjà confirmées ne sont peut-être pas sur disque : le journal refuse la suite
+            std::cerr << e.what() << std::endl;
+            markFailed(e.what());
+        }
+        lock.lock();
+    }
+}
+
+/**
+ * Fermer
+ * Valide les enregistrements restants, arrête le thread de synchronisation, effectue une dernière
+ * synchronisation (sauf FSYNC_OFF) et ferme le fichier. Un journal en échec est fermé sans rien écrire
+ * de plus : au redémarrage, le rejeu ne rend que ce qui a été validé avant l'échec.
+ */
+void WriteAheadLog::close() {
+    if (!isOpen()) return;
+
+    if (failed) pending.clear();
+    else commit();
+
+    if (syncThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(syncMutex);
+            stopping = true;
+        }
+        syncCondition.notify_all();
+        syncThread.join();
+    }
+
+    if (cleanupThread.joinable()) {
+        cleanupThread.join();
+    }
+
+    if (policy != FSYNC_OFF && !failed) {
+        syncToDisk();
+    }
+
+    ::close(fd);
+    fd = -1;
+}
+
+/**
+ * Sceller le segment actif
+ * Le segment est synchronisé avant d'être renommé, afin qu'un segment scellé soit toujours complet sur
+ * disque. Le remplacement du descripteur se fait sous 'fdMutex' pour ne pas croiser une synchronisation
+ * du thread d'arrière-plan.
+ * Retourne Le dernier LSN du segment scellé.
+ */
+uint64_t WriteAheadLog::rotate() {
+    if (!isOpen()) {
+        throw std::runtime_error("Write-ahead log is not open");
+    }
+
+    commit();
+
+    std::lock_guard<std::mutex> fdLock(fdMutex);
+
+    uint64_t lastLsn = getLastLsn();
+    if (activeBytes == 0) return lastLsn;
+
+    if (policy != FSYNC_OFF) {
+        syncToDisk();
+    }
+
+    std::string sealedPath = path + "." + std::to_string(lastLsn);
+    if (std::rename(path.c_str(), sealedPath.c_str()) != 0) {
+        throw systemError("Cannot seal write-ahead log segment " + path);
+    }
+
+    int handle = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0644);
+    if (handle < 0) {
+        int savedErrno = errno;
+        std::rename(sealedPath.c_str(), path.c_str());
+        errno = savedErrno;
+        throw systemError("Cannot open write-ahead log " + path);
+    }
+
+    ::close(fd);
+    fd = handle;
+    activeBytes = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(syncMutex);
+        dirty = false;
+    }
+    return lastLsn;
+}
+
+/**
+ * Supprimer les segments couverts
+ * La suppression de gros fichiers peut prendre du temps sur certains systèmes de fichiers : elle est
+ * confiée à un thread pour ne pas retarder la requête en cours.
+ * lsn Le LSN couvert par l'instantané.
+ */
+void WriteAheadLog::removeSegmentsUpTo(uint64_t lsn) {
+    if (!isOpen()) return;
+
+    if (cleanupThread.joinable()) {
+        cleanupThread.join();
+    }
+
+    std::vector<std::string> covered;
+    for (const auto& segment : listSealedSegments()) {
+        if (segment.first <= lsn) covered.push_back(segment.second);
+    }
+    if (covered.empty()) return;
+
+    cleanupThread = std::thread([covered]() {
+        for (const std::string& segmentPath : covered) {
+            if (std::remove(segmentPath.c_str()) != 0) {
+                std::cerr << "Cannot remove write-ahead log segment " << segmentPath << std::endl;
+            }
+        }
+    });
+}
+
+/**
+ * Analyser une politique de synchronisation
+ * text "always", "off" ou un nombre de millisecondes strictement positif.
+ * fsyncPolicy Reçoit la politique.
+ * fsyncIntervalMs Reçoit l'intervalle (pour une valeur numérique).
+ * Retourne true si le texte est valide, false sinon.
+ */
+bool WriteAheadLog::parseFsyncPolicy(const std::string& text, FsyncPolicy& fsyncPolicy, int& fsyncIntervalMs) {
+    if (text == "always") {
+        fsyncPolicy = FSYNC_ALWAYS;
+        return true;
+    }
+    if (text == "off") {
+        fsyncPolicy = FSYNC_OFF;
+        return true;
+    }
+
+    try {
+        size_t used = 0;
+        int value = std::stoi(text, &used);
+        if (used != text.size() || value <= 0) return false;
+        fsyncPolicy = FSYNC_INTERVAL;
+        fsyncIntervalMs = value;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
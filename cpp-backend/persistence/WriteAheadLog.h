@@ -0,0 +1,250 @@
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <string>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
+/**
+ * Définit quand les écritures du journal sont forcées sur disque (fsync).
+ */
+enum FsyncPolicy {
+    FSYNC_ALWAYS,    // À chaque validation, avant de répondre
+    FSYNC_INTERVAL,  // Au plus toutes les N millisecondes, par un thread d'arrière-plan
+    FSYNC_OFF        // Jamais explicitement (le système d'exploitation décide)
+};
+
+/**
+ * Types d'enregistrements du journal. Chaque enregistrement décrit l'effet physique d'une mutation,
+ * de sorte que le rejeu n'a pas besoin de réexécuter la logique métier.
+ */
+enum RecordType : uint8_t {
+    TASK_PUT = 1,     // État complet d'une tâche créée ou modifiée
+    TASK_DELETE,      // Suppression d'une tâche
+    QUEUE_ENQUEUE,    // Entrée ajoutée (ou remise) dans la file d'un utilisateur
+    QUEUE_DEQUEUE,    // N entrées retirées de l'avant de la file d'un utilisateur
+    QUEUE_POLICY,     // Changement de politique d'ordonnancement d'une file
+    LEASE_GRANT,      // Bail accordé
+    LEASE_END,        // Bail acquitté, rendu ou expiré
+    UNDO_PUSH,        // Opération enregistrée sur la pile d'annulation
+    UNDO_POP,         // Opération retirée de la pile d'annulation
+    CHECKPOINT        // Instantané terminé couvrant les enregistrements jusqu'au LSN indiqué (ignoré au rejeu)
+};
+
+/**
+ * Enregistrement du journal tel que relu depuis le disque.
+ */
+struct LogRecord {
+    uint64_t lsn;        // Numéro de séquence de l'enregistrement (Log Sequence Number), strictement croissant.
+    RecordType type;     // Le type de l'enregistrement.
+    std::string payload; // Le contenu binaire de l'enregistrement.
+};
+
+/**
+ * Journal d'écriture anticipée (write-ahead log) en ajout seul. Chaque enregistrement est encadré par sa
+ * longueur et un CRC-32 : [longueur u32][crc u32][lsn u64][type u8][contenu]. Les enregistrements d'une
+ * même requête sont accumulés en mémoire puis écrits en une seule fois (validation groupée), et la
+ * synchronisation sur disque suit la politique FsyncPolicy choisie.
+ *
+ * Le journal est découpé en segments : les ajouts vont dans le segment actif ('path'), et chaque point de
+ * contrôle scelle le segment actif sous le nom 'path.<dernier LSN>'. Un segment scellé entièrement couvert
+ * par un instantané est supprimé, ce qui borne la taille du journal et la durée du rejeu.
+ */
+class WriteAheadLog {
+private:
+    int fd;
+    std::string path;
+    uint64_t activeBytes; // Taille du segment actif
+    FsyncPolicy policy;
+    int intervalMs;
+    uint64_t nextLsn;
+    std::string pending; // Enregistrements en attente de validation
+
+    std::thread syncThread;
+    std::mutex syncMutex;
+    std::condition_variable syncCondition;
+    bool stopping;
+    bool dirty;          // Données écrites mais pas encore synchronisées (protégé par syncMutex)
+    std::mutex fdMutex;  // Empêche le remplacement du segment actif pendant une synchronisation d'arrière-plan
+
+    std::atomic<bool> failed; // Une écriture ou une synchronisation a échoué : le journal refuse toute validation
+    std::string failure;      // La cause de l'échec (protégé par syncMutex)
+
+    std::thread cleanupThread; // Suppression des segments scellés
+
+    std::function<void(const std::vector<LogRecord>&)> commitListener; // Reçoit les enregistrements validés
+
+    /**
+     * Lister les segments scellés
+     * Retourne Les segments scellés existants (dernier LSN, chemin), triés par LSN croissant.
+     */
+    std::vector<std::pair<uint64_t, std::string>> listSealedSegments() const;
+
+    /**
+     * Lire un segment
+     * Valide et rejoue les enregistrements d'un segment, dans l'ordre.
+     * handle Le descripteur du segment ouvert.
+     * segmentPath Le chemin du segment (pour les messages d'erreur).
+     * replay La fonction appelée pour chaque enregistrement relu.
+     * afterLsn Les enregistrements jusqu'à ce LSN sont validés mais pas rejoués.
+     * validBytes Reçoit la taille de la partie valide du segment.
+     * Retourne La taille totale du segment.
+     */
+    uint64_t readSegment(int handle, const std::string& segmentPath,
+                         const std::function<void(const LogRecord&)>& replay, uint64_t afterLsn, uint64_t& validBytes);
+
+    /**
+     * Boucle de synchronisation
+     * Exécutée par le thread d'arrière-plan en mode FSYNC_INTERVAL.
+     */
+    void syncLoop();
+
+    /**
+     * Synchroniser
+     * Force les données écrites du fichier sur disque. Lève une exception en cas d'échec.
+     */
+    void syncToDisk();
+
+    /**
+     * Marquer en échec
+     * Retient la cause du premier échec ; les validations suivantes sont refusées.
+     * reason La cause de l'échec.
+     */
+    void markFailed(const std::string& reason);
+
+public:
+    static const size_t HEADER_SIZE = 17;
+
+    /**
+     * Initialise un journal fermé.
+     */
+    WriteAheadLog();
+
+    /**
+     * Valide les enregistrements en attente et ferme le journal.
+     */
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    /**
+     * Ouvrir
+     * Rejoue les segments scellés puis le segment actif (créé si besoin), tronque une éventuelle fin
+     * incomplète ou corrompue du segment actif, puis se positionne en fin de fichier pour l'ajout.
+     * Lève une exception en cas d'erreur d'entrée/sortie.
+     * filePath Le chemin du fichier du journal.
+     * fsyncPolicy La politique de synchronisation sur disque.
+     * fsyncIntervalMs L'intervalle de synchronisation en millisecondes (FSYNC_INTERVAL).
+     * replay La fonction appelée pour chaque enregistrement relu.
+     * afterLsn Le LSN couvert par l'instantané chargé (0 si aucun) : seuls les enregistrements suivants sont rejoués.
+     */
+    void open(const std::string& filePath, FsyncPolicy fsyncPolicy, int fsyncIntervalMs,
+              const std::function<void(const LogRecord&)>& replay, uint64_t afterLsn = 0);
+
+    /**
+     * Est ouvert
+     * Retourne Vrai si le journal est ouvert, Faux sinon.
+     */
+    bool isOpen() const { return fd >= 0; }
+
+    /**
+     * Ajouter
+     * Ajoute un enregistrement au tampon de la requête courante. Il ne sera écrit qu'à la prochaine validation.
+     * type Le type de l'enregistrement.
+     * payload Le contenu binaire de l'enregistrement.
+     * Retourne Le LSN attribué à l'enregistrement.
+     */
+    uint64_t append(RecordType type, const std::string& payload);
+
+    /**
+     * Valider (commit)
+     * Écrit d'un seul bloc les enregistrements en attente et les synchronise selon la politique.
+     * En cas d'erreur d'entrée/sortie, le segment est tronqué à sa taille d'avant l'écriture, les
+     * enregistrements en attente sont abandonnés, le journal passe en échec et une exception est levée.
+     */
+    void commit();
+
+    /**
+     * Est en échec
+     * Retourne Vrai si une écriture ou une synchronisation a échoué depuis l'ouverture du journal.
+     */
+    bool hasFailed() const { return failed; }
+
+    /**
+     * Obtenir la cause de l'échec
+     * Retourne Le message de l'erreur qui a mis le journal en échec (vide sinon).
+     */
+    std::string getFailure();
+
+    /**
+     * Fermer
+     * Valide les enregistrements en attente (sauf journal en échec), arrête le thread de synchronisation et ferme le fichier.
+     */
+    void close();
+
+    /**
+     * Sceller le segment actif
+     * Valide et synchronise les enregistrements en attente, renomme le segment actif en segment scellé
+     * puis ouvre un nouveau segment actif vide. Lève une exception en cas d'erreur d'entrée/sortie.
+     * Retourne Le dernier LSN du segment scellé.
+     */
+    uint64_t rotate();
+
+    /**
+     * Supprimer les segments couverts
+     * Supprime en arrière-plan les segments scellés dont tous les enregistrements sont couverts par un instantané.
+     * lsn Le LSN couvert par l'instantané.
+     */
+    void removeSegmentsUpTo(uint64_t lsn);
+
+    /**
+     * Obtenir la taille du segment actif
+     * Retourne Le nombre d'octets écrits dans le segment actif.
+     */
+    uint64_t getActiveSize() const { return activeBytes; }
+
+    /**
+     * Définir l'écouteur de validation
+     * La fonction reçoit, dans l'ordre des LSN, les enregistrements de chaque validation une fois écrits
+     * (et synchronisés en mode FSYNC_ALWAYS). Utilisé par le flux de changements.
+     * listener La fonction appelée après chaque validation non vide.
+     */
+    void setCommitListener(const std::function<void(const std::vector<LogRecord>&)>& listener) { commitListener = listener; }
+
+    /**
+     * Lire les enregistrements validés
+     * Relit depuis le disque les enregistrements validés postérieurs à un LSN, dans la limite de la rétention
+     * (les segments supprimés par les points de contrôle ne sont plus disponibles).
+     * Lève une exception en cas d'erreur d'entrée/sortie.
+     * afterLsn Seuls les enregistrements de LSN strictement supérieur sont rendus.
+     * maxRecords Le nombre maximal d'enregistrements rendus.
+     * visit La fonction appelée pour chaque enregistrement.
+     * Retourne Le plus petit LSN encore conservé (0 si le journal est vide).
+     */
+    uint64_t readCommitted(uint64_t afterLsn, size_t maxRecords,
+                           const std::function<void(const LogRecord&)>& visit) const;
+
+    /**
+     * Obtenir le dernier LSN
+     * Retourne Le LSN du dernier enregistrement attribué (0 si aucun).
+     */
+    uint64_t getLastLsn() const { return nextLsn - 1; }
+
+    /**
+     * Analyser une politique de synchronisation
+     * Convertit "always", "off" ou un nombre de millisecondes en politique FsyncPolicy.
+     * text Le texte à analyser.
+     * fsyncPolicy Reçoit la politique.
+     * fsyncIntervalMs Reçoit l'intervalle (pour une valeur numérique).
+     * Retourne true si le texte est valide, false sinon.
+     */
+    static bool parseFsyncPolicy(const std::string& text, FsyncPolicy& fsyncPolicy, int& fsyncIntervalMs);
+};
+
+#endif
@@ -0,0 +1,350 @@
+#include "TaskQuery.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <cstring>
+
+using json = nlohmann::json;
+
+static const char BASE64URL[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+static const size_t DEFAULT_QUERY_LIMIT = 50;
+static const size_t MAX_QUERY_LIMIT = 500;
+static const size_t DUE_RANGE_PROBE_BUDGET = 4096; // Tâches examinées au plus pour sonder un intervalle d'échéances
+
+/**
+ * Encoder en base64url (sans remplissage)
+ */
+static std::string base64UrlEncode(const std::string& data) {
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+
+    size_t i = 0;
+    for (; i + 2 < data.size(); i += 3) {
+        uint32_t n = (static_cast<unsigned char>(data[i]) << 16) | (static_cast<unsigned char>(data[i + 1]) << 8) |
+                     static_cast<unsigned char>(data[i + 2]);
+        out += BASE64URL[(n >> 18) & 63];
+        out += BASE64URL[(n >> 12) & 63];
+        out += BASE64URL[(n >> 6) & 63];
+        out += BASE64URL[n & 63];
+    }
+    if (i < data.size()) {
+        uint32_t n = static_cast<unsigned char>(data[i]) << 16;
+        if (i + 1 < data.size()) n |= static_cast<unsigned char>(data[i + 1]) << 8;
+        out += BASE64URL[(n >> 18) & 63];
+        out += BASE64URL[(n >> 12) & 63];
+        if (i + 1 < data.size()) out += BASE64URL[(n >> 6) & 63];
+    }
+    return out;
+}
+
+/**
+ * Décoder du base64url (sans remplissage)
+ * Lève std::invalid_argument si le texte contient un caractère invalide.
+ */
+static std::string base64UrlDecode(const std::string& text) {
+    std::string out;
+    uint32_t buffer = 0;
+    int bits = 0;
+
+    for (char c : text) {
+        const char* found = c ? std::strchr(BASE64URL, c) : nullptr;
+        if (!found) throw std::invalid_argument("Invalid cursor");
+        buffer = (buffer << 6) | static_cast<uint32_t>(found - BASE64URL);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out += static_cast<char>((buffer >> bits) & 0xFF);
+        }
+    }
+    return out;
+}
+
+/**
+ * Initialise une requête sans filtre, triée par date de création décroissante.
+ */
+TaskQuery::TaskQuery()
+    : statusMask((1u << STATUS_COUNT) - 1), minPriority(LOW), maxPriority(HIGH), favorite(-1),
+      hasDueFrom(false), hasDueTo(false), dueFrom(0), dueTo(0), sort(SORT_CREATED_AT), descending(true),
+      limit(DEFAULT_QUERY_LIMIT), hasCursor(false), cursor{0, ""} {}
+
+/**
+ * Analyser une requête
+ * jsonData Chaîne JSON de la requête.
+ * Retourne La requête analysée.
+ */
+TaskQuery TaskQuery::parse(const std::string& jsonData) {
+    json input = json::parse(jsonData);
+    TaskQuery query;
+
+    if (input.contains("status") && !input["status"].is_null()) {
+        json statuses = input["status"].is_array() ? input["status"] : json::array({input["status"]});
+        query.statusMask = 0;
+        for (const json& status : statuses) {
+            int value = status.get<int>();
+            if (value < TO_DO || value > COMPLETED) throw std::invalid_argument("Invalid status filter");
+            query.statusMask |= 1u << value;
+        }
+    }
+
+    query.minPriority = input.value("minPriority", static_cast<int>(LOW));
+    query.maxPriority = input.value("maxPriority", static_cast<int>(HIGH));
+    if (query.minPriority > query.maxPriority) throw std::invalid_argument("minPriority is greater than maxPriority");
+
+    if (input.contains("favorite") && !input["favorite"].is_null()) {
+        query.favorite = input["favorite"].get<bool>() ? 1 : 0;
+    }
+    query.tag = input.value("tag", "");
+    query.text = input.value("text", "");
+
+    if (input.contains("dueFrom") && !input["dueFrom"].is_null()) {
+        query.hasDueFrom = true;
+        query.dueFrom = input["dueFrom"].get<time_t>();
+    }
+    if (input.contains("dueTo") && !input["dueTo"].is_null()) {
+        query.hasDueTo = true;
+        query.dueTo = input["dueTo"].get<time_t>();
+    }
+
+    std::string sort = input.value("sort", "-createdAt");
+    query.descending = !sort.empty() && sort[0] == '-';
+    if (query.descending || (!sort.empty() && sort[0] == '+')) sort.erase(0, 1);
+    if (sort == "createdAt") query.sort = SORT_CREATED_AT;
+    else if (sort == "updatedAt") query.sort = SORT_UPDATED_AT;
+    else if (sort == "dueDate") query.sort = SORT_DUE_DATE;
+    else if (sort == "priority") query.sort = SORT_PRIORITY;
+    else if (sort == "urgency") query.sort = SORT_URGENCY;
+    else throw std::invalid_argument("Unknown sort key: " + sort);
+
+    int limit = input.value("limit", static_cast<int>(DEFAULT_QUERY_LIMIT));
+    if (limit <= 0 || static_cast<size_t>(limit) > MAX_QUERY_LIMIT) {
+        throw std::invalid_argument("limit must be between 1 and " + std::to_string(MAX_QUERY_LIMIT));
+    }
+    query.limit = static_cast<size_t>(limit);
+
+    std::string cursor = input.value("cursor", "");
+    if (!cursor.empty()) {
+        // Format décodé : "<champ>|<décroissant>|<valeur>|<identifiant>"
+        std::string decoded = base64UrlDecode(cursor);
+        size_t first = decoded.find('|');
+        size_t second = first == std::string::npos ? first : decoded.find('|', first + 1);
+        size_t third = second == std::string::npos ? second : decoded.find('|', second + 1);
+        if (third == std::string::npos ||
+            decoded.substr(0, first) != std::to_string(query.sort) ||
+            decoded.substr(first + 1, second - first - 1) != (query.descending ? "1" : "0")) {
+            throw std::invalid_argument("The cursor does not belong to this sort order");
+        }
+        try {
+            query.cursor.value = std::stoll(decoded.substr(second + 1, third - second - 1));
+        } catch (...) {
+            throw std::invalid_argument("Invalid cursor");
+        }
+        query.cursor.taskId = decoded.substr(third + 1);
+        query.hasCursor = true;
+    }
+    return query;
+}
+
+/**
+ * Correspondre
+ * task La tâche à tester.
+ * Retourne true si la tâche satisfait tous les filtres sauf le texte.
+ */
+bool TaskQuery::matches(const Task& task) const {
+    Status status = task.getStatus();
+    if (status < TO_DO || status > COMPLETED || !(statusMask & (1u << status))) return false;
+    if (task.getPriority() < minPriority || task.getPriority() > maxPriority) return false;
+    if (favorite >= 0 && task.getIsFavorite() != (favorite == 1)) return false;
+
+    if (hasDueFrom || hasDueTo) {
+        time_t due = task.getDueDate();
+        if (due == 0 || (hasDueFrom && due < dueFrom) || (hasDueTo && due > dueTo)) return false;
+    }
+
+    if (!tag.empty()) {
+        std::vector<std::string> tags = task.getTags();
+        if (std::find(tags.begin(), tags.end(), tag) == tags.end()) return false;
+    }
+    return true;
+}
+
+/**
+ * Est après le curseur
+ * key La position d'une tâche.
+ * Retourne true si la position suit strictement le curseur dans l'ordre du tri.
+ */
+bool TaskQuery::isAfterCursor(const OrderKey& key) const {
+    if (!hasCursor) return true;
+    return descending ? key < cursor : cursor < key;
+}
+
+/**
+ * Encoder un curseur
+ * key La dernière position rendue.
+ * Retourne Le curseur opaque.
+ */
+std::string TaskQuery::encodeCursor(const OrderKey& key) const {
+    return base64UrlEncode(std::to_string(sort) + "|" + (descending ? "1" : "0") + "|" +
+                           std::to_string(key.value) + "|" + key.taskId);
+}
+
+/**
+ * Trier et paginer des candidats
+ * Seule la page (plus une tâche, pour savoir s'il en reste) est triée.
+ * query La requête.
+ * candidates Les tâches candidates (non filtrées).
+ * result Reçoit la page.
+ */
+void QueryPlanner::sortCandidates(const TaskQuery& query, std::vector<Task*>& candidates, QueryResult& result) const {
+    std::vector<std::pair<OrderKey, Task*>> keyed;
+    for (Task* task : candidates) {
+        result.examined++;
+        if (!query.matches(*task)) continue;
+        OrderKey key{TaskOrderIndex::sortValue(*task, query.sort), task->getId()};
+        if (query.isAfterCursor(key)) keyed.emplace_back(std::move(key), task);
+    }
+
+    auto before = [&query](const std::pair<OrderKey, Task*>& a, const std::pair<OrderKey, Task*>& b) {
+        return query.descending ? b.first < a.first : a.first < b.first;
+    };
+    size_t count = std::min(keyed.size(), query.limit + 1);
+    std::partial_sort(keyed.begin(), keyed.begin() + count, keyed.end(), before);
+
+    result.hasMore = keyed.size() > query.limit;
+    for (size_t i = 0; i < count && i < query.limit; i++) {
+        result.tasks.push_back(keyed[i].second);
+    }
+}
+
+/**
+ * Exécuter par la recherche textuelle
+ * userId L'identifiant de l'utilisateur.
+ * query La requête.
+ * Retourne La page de résultats.
+ */
+QueryResult QueryPlanner::runText(const std::string& userId, const TaskQuery& query) const {
+    QueryResult result;
+    result.plan = "text";
+
+    std::vector<Task*> candidates;
+    for (const std::string& taskId : searchIndex.search(userId, query.text)) {
+        Task* task = taskList.find(taskId);
+        if (task) candidates.push_back(task);
+    }
+    sortCandidates(query, candidates, result);
+    return result;
+}
+
+/**
+ * Exécuter par l'intervalle d'échéances
+ * Lorsque le tri porte sur l'échéance, le parcours part directement de la borne (ou du curseur) et
+ * s'arrête à la fin de la page ; sinon tout l'intervalle est lu, dans la limite du budget, puis trié.
+ * userId L'identifiant de l'utilisateur.
+ * query La requête.
+ * budget Le nombre maximal de tâches à examiner (0 pour aucune limite).
+ * result Reçoit la page.
+ * Retourne false si le budget est dépassé (le résultat est alors incomplet).
+ */
+bool QueryPlanner::runDueRange(const std::string& userId, const TaskQuery& query, size_t budget, QueryResult& result) const {
+    bool sortedByDue = query.sort == SORT_DUE_DATE;
+    bool descending = sortedByDue && query.descending;
+
+    long long low = query.hasDueFrom ? static_cast<long long>(query.dueFrom) : std::numeric_limits<long long>::min();
+    long long high = query.hasDueTo ? static_cast<long long>(query.dueTo) : std::numeric_limits<long long>::max() - 1;
+
+    // Position de départ : la borne de l'intervalle, ou le curseur s'il est plus loin dans le parcours
+    OrderKey from = descending ? OrderKey{high + 1, ""} : OrderKey{low, ""};
+    bool exclusive = descending;
+    if (sortedByDue && query.hasCursor && (descending ? query.cursor < from : from < query.cursor)) {
+        from = query.cursor;
+        exclusive = true;
+    }
+
+    std::vector<Task*> inRange;
+    bool withinBudget = true;
+    orderIndex.scan(userId, query.statusMask, SORT_DUE_DATE, descending, &from, exclusive, [&](const OrderKey& key) {
+        if (descending ? key.value < low : key.value > high) return false;
+        if (budget > 0 && inRange.size() >= budget) {
+            withinBudget = false;
+            return false;
+        }
+
+        Task* task = taskList.find(key.taskId);
+        if (!task) return true;
+        if (!sortedByDue) {
+            inRange.push_back(task);
+            return true;
+        }
+
+        result.examined++;
+        if (!query.matches(*task)) return true;
+        if (result.tasks.size() == query.limit) {
+            result.hasMore = true;
+            return false;
+        }
+        result.tasks.push_back(task);
+        return true;
+    });
+
+    if (!withinBudget) return false;
+    if (!sortedByDue) {
+        sortCandidates(query, inRange, result);
+    }
+    return true;
+}
+
+/**
+ * Exécuter par parcours ordonné
+ * userId L'identifiant de l'utilisateur.
+ * query La requête.
+ * Retourne La page de résultats.
+ */
+QueryResult QueryPlanner::runOrderedScan(const std::string& userId, const TaskQuery& query) const {
+    QueryResult result;
+    result.plan = "orderedScan";
+
+    orderIndex.scan(userId, query.statusMask, query.sort, query.descending, query.hasCursor ? &query.cursor : nullptr, true,
+                    [&](const OrderKey& key) {
+        Task* task = taskList.find(key.taskId);
+        if (!task) return true;
+
+        result.examined++;
+        if (!query.matches(*task)) return true;
+        if (result.tasks.size() == query.limit) {
+            result.hasMore = true;
+            return false;
+        }
+        result.tasks.push_back(task);
+        return true;
+    });
+    return result;
+}
+
+/**
+ * Exécuter
+ * Ordre de préférence : texte (ensemble de candidats le plus petit), intervalle d'échéances, puis
+ * parcours ordonné.
+ * userId L'identifiant de l'utilisateur.
+ * query La requête.
+ * Retourne La page de résultats.
+ */
+QueryResult QueryPlanner::run(const std::string& userId, const TaskQuery& query) const {
+    if (!query.text.empty()) {
+        return runText(userId, query);
+    }
+
+    if (query.hasDueFrom || query.hasDueTo) {
+        QueryResult result;
+        if (query.sort == SORT_DUE_DATE) {
+            result.plan = "dueRange";
+            runDueRange(userId, query, 0, result);
+            return result;
+        }
+        result.plan = "dueRangeSort";
+        if (runDueRange(userId, query, DUE_RANGE_PROBE_BUDGET, result)) {
+            return result;
+        }
+    }
+
+    return runOrderedScan(userId, query);
+}
@@ -0,0 +1,143 @@
+#ifndef TASKQUERY_H
+#define TASKQUERY_H
+
+#include "../models/Task.h"
+#include "../models/LinkedList.h"
+#include "../datastructures/TrigramIndex.h"
+#include "../datastructures/TaskOrderIndex.h"
+#include <string>
+#include <vector>
+#include <ctime>
+
+/**
+ * Requête composable sur les tâches d'un utilisateur : un prédicat (conjonction de filtres), un tri,
+ * une taille de page et un curseur opaque pour reprendre après la page précédente.
+ */
+struct TaskQuery {
+    unsigned statusMask;   // Statuts acceptés (bit 1 << statut)
+    int minPriority;
+    int maxPriority;
+    int favorite;          // -1 pour indifférent, 0 ou 1 sinon
+    std::string tag;       // Étiquette requise (vide pour aucune)
+    bool hasDueFrom;
+    bool hasDueTo;
+    time_t dueFrom;        // Échéance minimale (incluse)
+    time_t dueTo;          // Échéance maximale (incluse)
+    std::string text;      // Sous-chaîne du titre ou de la description (vide pour aucune)
+    SortField sort;
+    bool descending;
+    size_t limit;
+    bool hasCursor;
+    OrderKey cursor;       // Dernière position rendue par la page précédente
+
+    /**
+     * Initialise une requête sans filtre, triée par date de création décroissante.
+     */
+    TaskQuery();
+
+    /**
+     * Analyser une requête
+     * Champs acceptés : "status" (entier ou tableau), "minPriority", "maxPriority", "favorite", "tag",
+     * "dueFrom", "dueTo", "text", "sort" ("createdAt", "updatedAt", "dueDate", "priority" ou "urgency", préfixé
+     * de "-" pour l'ordre décroissant), "limit" et "cursor".
+     * Lève std::invalid_argument si un champ est invalide.
+     * jsonData Chaîne JSON de la requête.
+     * Retourne La requête analysée.
+     */
+    static TaskQuery parse(const std::string& jsonData);
+
+    /**
+     * Correspondre
+     * Vérifie tous les filtres sauf le texte (appliqué par l'index de recherche).
+     * task La tâche à tester.
+     * Retourne true si la tâche satisfait le prédicat.
+     */
+    bool matches(const Task& task) const;
+
+    /**
+     * Est après le curseur
+     * key La position d'une tâche dans l'ordre du tri.
+     * Retourne true si la position suit le curseur (toujours vrai sans curseur).
+     */
+    bool isAfterCursor(const OrderKey& key) const;
+
+    /**
+     * Encoder un curseur
+     * Le curseur contient le tri et la dernière position rendue ; il est encodé en base64url pour rester opaque.
+     * key La dernière position rendue.
+     * Retourne Le curseur à renvoyer au client.
+     */
+    std::string encodeCursor(const OrderKey& key) const;
+};
+
+/**
+ * Résultat d'une requête.
+ */
+struct QueryResult {
+    std::vector<Task*> tasks;   // La page, dans l'ordre du tri
+    bool hasMore;               // true si d'autres tâches suivent la page
+    std::string plan;           // Stratégie choisie par le planificateur
+    size_t examined;            // Nombre de tâches examinées
+
+    /**
+     * Initialise un résultat vide.
+     */
+    QueryResult() : hasMore(false), examined(0) {}
+};
+
+/**
+ * Planificateur de requêtes : choisit, selon les filtres et le tri, l'accès le moins coûteux parmi
+ * les index disponibles.
+ *  - "text" : candidats de l'index de trigrammes, filtrés puis triés (tri partiel) ;
+ *  - "dueRange" : parcours de l'index des échéances borné à l'intervalle demandé ;
+ *  - "dueRangeSort" : idem lorsque l'intervalle est petit mais que le tri porte sur un autre champ
+ *    (l'intervalle est sondé avec un budget ; au-delà, le planificateur se rabat sur le parcours ordonné) ;
+ *  - "orderedScan" : parcours de l'index du champ de tri, limité aux statuts demandés, qui s'arrête dès
+ *    que la page est pleine.
+ */
+class QueryPlanner {
+private:
+    TaskLinkedList& taskList;
+    const TrigramIndex& searchIndex;
+    const TaskOrderIndex& orderIndex;
+
+    /**
+     * Trier et paginer des candidats
+     * Filtre les candidats, écarte ceux qui précèdent le curseur et garde la page triée.
+     */
+    void sortCandidates(const TaskQuery& query, std::vector<Task*>& candidates, QueryResult& result) const;
+
+    /**
+     * Exécuter par la recherche textuelle
+     */
+    QueryResult runText(const std::string& userId, const TaskQuery& query) const;
+
+    /**
+     * Exécuter par l'intervalle d'échéances
+     * budget Le nombre maximal de tâches à examiner (0 pour aucune limite).
+     * Retourne false si le budget est dépassé.
+     */
+    bool runDueRange(const std::string& userId, const TaskQuery& query, size_t budget, QueryResult& result) const;
+
+    /**
+     * Exécuter par parcours ordonné
+     */
+    QueryResult runOrderedScan(const std::string& userId, const TaskQuery& query) const;
+
+public:
+    /**
+     * Initialise le planificateur sur les structures du contrôleur.
+     */
+    QueryPlanner(TaskLinkedList& list, const TrigramIndex& search, const TaskOrderIndex& order)
+        : taskList(list), searchIndex(search), orderIndex(order) {}
+
+    /**
+     * Exécuter
+     * userId L'identifiant de l'utilisateur.
+     * query La requête.
+     * Retourne La page de résultats et la stratégie utilisée.
+     */
+    QueryResult run(const std::string& userId, const TaskQuery& query) const;
+};
+
+#endif
@@ -0,0 +1,213 @@
+#include "WorkStealingExecutor.h"
+#include <chrono>
+
+/**
+ * Ordonnanceur et indice de file du thread courant (nullptr pour un thread qui n'est pas un thread de travail).
+ */
+static thread_local const WorkStealingExecutor* currentExecutor = nullptr;
+static thread_local size_t currentQueue = 0;
+
+/**
+ * Constructeur
+ * threadCount Le nombre total de threads, appelant compris (0 pour le nombre de cœurs).
+ */
+WorkStealingExecutor::WorkStealingExecutor(size_t threadCount) : queued(0), nextQueue(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+    }
+
+    for (size_t i = 1; i < threadCount; i++) {
+        queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (size_t i = 0; i < queues.size(); i++) {
+        workers.emplace_back(&WorkStealingExecutor::workerLoop, this, i);
+    }
+}
+
+/**
+ * Destructeur
+ */
+WorkStealingExecutor::~WorkStealingExecutor() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Indice du thread courant
+ * Retourne L'indice de sa file, ou queues.size() pour un thread extérieur.
+ */
+size_t WorkStealingExecutor::currentIndex() const {
+    return currentExecutor == this ? currentQueue : queues.size();
+}
+
+/**
+ * Soumettre
+ * group Le lot du travail.
+ * job Le travail.
+ */
+void WorkStealingExecutor::spawn(Group& group, Job job) {
+    {
+        std::lock_guard<std::mutex> guard(group.lock);
+        group.pending++;
+    }
+
+    Work work{std::move(job), &group};
+    if (queues.empty()) {
+        execute(work);
+        return;
+    }
+
+    size_t self = currentIndex();
+    size_t target = self < queues.size() ? self : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        std::lock_guard<std::mutex> guard(queues[target]->lock);
+        queues[target]->work.push_back(std::move(work));
+    }
+    queued.fetch_add(1);
+
+    // Prendre le verrou avant de réveiller : un thread qui vient de trouver 'queued' nul ne peut pas manquer le signal
+    { std::lock_guard<std::mutex> guard(sleepLock); }
+    wake.notify_one();
+}
+
+/**
+ * Prendre un travail
+ * self L'indice du thread courant.
+ * out Reçoit le travail.
+ * Retourne false si toutes les files sont vides.
+ */
+bool WorkStealingExecutor::take(size_t self, Work& out) {
+    if (queued.load() == 0) return false;
+
+    if (self < queues.size()) {
+        WorkerQueue& own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.work.empty()) {
+            out = std::move(own.work.back());
+            own.work.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    size_t start = self < queues.size() ? self + 1 : nextQueue.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < queues.size(); i++) {
+        WorkerQueue& victim = *queues[(start + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.work.empty()) {
+            out = std::move(victim.work.front());
+            victim.work.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Exécuter un travail
+ * La fin est signalée sous le verrou du lot : l'appelant ne peut pas détruire le lot avant que le
+ * signal soit terminé.
+ * work Le travail.
+ */
+void WorkStealingExecutor::execute(Work& work) {
+    std::exception_ptr error;
+    try {
+        work.job();
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    Group& group = *work.group;
+    std::lock_guard<std::mutex> guard(group.lock);
+    if (error && !group.error) group.error = error;
+    if (--group.pending == 0) group.done.notify_all();
+}
+
+/**
+ * Attendre un lot
+ * group Le lot.
+ */
+void WorkStealingExecutor::wait(Group& group) {
+    size_t self = currentIndex();
+    while (true) {
+        Work work;
+        if (take(self, work)) {
+            execute(work);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(group.lock);
+        if (group.pending == 0) {
+            if (group.error) std::rethrow_exception(group.error);
+            return;
+        }
+        // Réveil périodique : des travaux du lot peuvent être redéposés par d'autres threads (découpage)
+        group.done.wait_for(guard, std::chrono::microseconds(200));
+    }
+}
+
+/**
+ * Boucle d'un thread de travail
+ * Exécute les travaux disponibles puis dort jusqu'au prochain dépôt.
+ * self L'indice de sa file.
+ */
+void WorkStealingExecutor::workerLoop(size_t self) {
+    currentExecutor = this;
+    currentQueue = self;
+
+    while (true) {
+        Work work;
+        if (take(self, work)) {
+            execute(work);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        if (stopping && queued.load() == 0) return;
+        wake.wait(guard, [this] { return stopping || queued.load() > 0; });
+    }
+}
+
+/**
+ * Exécuter en parallèle
+ * jobs Les travaux.
+ */
+void WorkStealingExecutor::invokeAll(const std::vector<Job>& jobs) {
+    Group group;
+    for (const Job& job : jobs) {
+        spawn(group, job);
+    }
+    wait(group);
+}
+
+/**
+ * Boucle parallèle
+ * count Le nombre d'éléments.
+ * grain La taille maximale d'une tranche.
+ * body La fonction appelée pour chaque tranche.
+ */
+void WorkStealingExecutor::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    Group group;
+    std::function<void(size_t, size_t)> split = [&](size_t begin, size_t end) {
+        while (end - begin > grain) {
+            size_t middle = begin + (end - begin) / 2;
+            spawn(group, [&split, middle, end] { split(middle, end); });
+            end = middle;
+        }
+        body(begin, end);
+    };
+
+    spawn(group, [&split, count] { split(0, count); });
+    wait(group);
+}
@@ -0,0 +1,143 @@
+#ifndef WORKSTEALINGEXECUTOR_H
+#define WORKSTEALINGEXECUTOR_H
+
+#include "../datastructures/MPMCQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Ordonnanceur à vol de travail pour les traitements en masse (importation, exportation, reconstruction
+ * des index). Chaque thread a sa propre file double : il empile et dépile ses travaux par l'arrière (les
+ * plus récents, encore chauds dans son cache), tandis qu'un thread inoccupé vole par l'avant chez les
+ * autres (les plus anciens, donc les plus gros d'un découpage récursif). Le thread appelant participe :
+ * en attendant la fin de ses travaux, il en exécute lui-même, de sorte qu'un ordonnanceur de N threads
+ * compte N-1 threads de travail et qu'un appel imbriqué ne peut pas bloquer l'ordonnanceur.
+ *
+ * Les threads de travail sont absents d'un processus dupliqué par fork : un enfant ne doit pas l'utiliser.
+ */
+class WorkStealingExecutor {
+public:
+    using Job = std::function<void()>;
+
+private:
+    /**
+     * Lot de travaux attendu par un appelant ; la première exception levée y est conservée.
+     */
+    struct Group {
+        std::mutex lock;
+        std::condition_variable done;
+        size_t pending = 0;
+        std::exception_ptr error;
+    };
+
+    /**
+     * Travail en file.
+     */
+    struct Work {
+        Job job;
+        Group* group;
+    };
+
+    /**
+     * File double d'un thread de travail, sur sa propre ligne de cache.
+     */
+    struct alignas(CACHE_LINE_SIZE) WorkerQueue {
+        std::mutex lock;
+        std::deque<Work> work;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued;     // Travaux en file, toutes files confondues
+    std::atomic<size_t> nextQueue;  // File de dépôt des travaux venant d'un thread extérieur (tourniquet)
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping;
+
+    /**
+     * Indice du thread courant
+     * Retourne L'indice de la file du thread courant s'il travaille pour cet ordonnanceur, sinon queues.size().
+     */
+    size_t currentIndex() const;
+
+    /**
+     * Soumettre
+     * Dépose un travail du lot dans la file du thread courant (ou, depuis l'extérieur, dans une file choisie
+     * en tourniquet) ; sans thread de travail, il est exécuté sur-le-champ.
+     */
+    void spawn(Group& group, Job job);
+
+    /**
+     * Prendre un travail
+     * Dépile l'arrière de sa propre file, sinon vole l'avant d'une autre.
+     * self L'indice du thread courant (queues.size() pour un thread extérieur).
+     * out Reçoit le travail.
+     * Retourne false si toutes les files sont vides.
+     */
+    bool take(size_t self, Work& out);
+
+    /**
+     * Exécuter un travail et signaler la fin de son lot.
+     */
+    static void execute(Work& work);
+
+    /**
+     * Attendre un lot
+     * Exécute des travaux en attendant que le lot soit terminé, puis relance sa première exception.
+     */
+    void wait(Group& group);
+
+    /**
+     * Boucle d'un thread de travail.
+     */
+    void workerLoop(size_t self);
+
+public:
+    /**
+     * Démarre l'ordonnanceur.
+     * threadCount Le nombre total de threads, appelant compris (0 pour le nombre de cœurs).
+     */
+    explicit WorkStealingExecutor(size_t threadCount = 0);
+
+    /**
+     * Arrête les threads de travail une fois leurs files vidées.
+     */
+    ~WorkStealingExecutor();
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    /**
+     * Exécuter en parallèle
+     * Exécute tous les travaux et attend leur fin. Lève la première exception levée par un travail.
+     * jobs Les travaux, indépendants les uns des autres.
+     */
+    void invokeAll(const std::vector<Job>& jobs);
+
+    /**
+     * Boucle parallèle
+     * Appelle 'body' sur des tranches disjointes couvrant [0, count). L'intervalle est coupé en deux
+     * récursivement, la moitié droite restant en file pour être volée, jusqu'à des tranches d'au plus
+     * 'grain' éléments. Lève la première exception levée par 'body'.
+     * count Le nombre d'éléments.
+     * grain La taille maximale d'une tranche (au moins 1).
+     * body La fonction appelée pour chaque tranche [begin, end).
+     */
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    /**
+     * Obtenir le nombre de threads
+     * Retourne Le nombre total de threads, appelant compris.
+     */
+    size_t getThreadCount() const { return workers.size() + 1; }
+};
+
+#endif
@@ -46,6 +46,11 @@ const taskSchema = new mongoose.Schema({
   createdAt: {
     type: Date,
     default: Date.now
+  },
+  // Date du passage à COMPLETED, fixée par le moteur C++ (null si la tâche n'est pas terminée ou si la date est inconnue)
+  completedAt: {
+    type: Date,
+    default: null
   }
 });
 
@@ -2,24 +2,29 @@ const express = require('express');
 const { verifyToken } = require('../middleware/authMiddleware');
 const cppBridge = require('../utils/cppBridge');
 const Task = require('../models/Task');
-const Queue = require('../models/Queue');
 
 const queueRoute = express.Router();
 queueRoute.use(verifyToken);
 
-async function getUserQueue(userId) {
-  let queue = await Queue.findOne({ userId });
-  if (!queue) {
-    queue = new Queue({ userId, tasks: [] });
-    await queue.save();
-  }
-  return queue;
-}
+// La file de traitement vit dans le moteur C++ (journalisée avec --wal) : MongoDB n'en garde plus de copie
+
+// Dates du moteur (secondes, 0 si absente) vers des dates JavaScript
+const fromSeconds = (seconds) => (seconds ? new Date(seconds * 1000) : null);
+
+// Résumé d'une tâche du moteur tel que rendu par les routes de la file
+const taskSummary = (cppTask) => ({
+  id: cppTask.id,
+  title: cppTask.title,
+  description: cppTask.description,
+  priority: cppTask.priority,
+  status: cppTask.status,
+  dueDate: fromSeconds(cppTask.dueDate)
+});
 
 // ============================================
 // Ajouter une tâche à la file de traitement
-// Description: Ajoute une tâche à la file d'attente de traitement de l'utilisateur si son statut est TO_DO (0) ou PENDING (1). 
-//              La tâche est également ajoutée à la structure de file d'attente C++ sous-jacente.
+// Description: Ajoute une tâche à la file d'attente de traitement de l'utilisateur (file du moteur C++)
+//              si son statut est TO_DO (0) ou PENDING (1) et qu'elle n'y est pas déjà.
 // Reponse succés en json format:
 // {	
 // "success": true,	
@@ -50,32 +55,20 @@ queueRoute.post('/add/:taskId', async (req, res) => {
       });
     }
 
-    const queue = await getUserQueue(req.userId);
-
-    const alreadyQueued = queue.tasks.some(t => t.taskId.toString() === task._id.toString());
-
-    if (alreadyQueued) {
+    // The engine rejects a task that is already queued
+    const cppResult = await cppBridge.addToQueue(task.taskId);
+    if (!cppResult.success) {
       return res.status(400).json({
         success: false,
-        message: 'Task is already in the queue'
+        message: cppResult.error
       });
     }
 
-    queue.tasks.push({
-      taskId: task._id,
-      addedAt: new Date()
-    });
-
-    await queue.save();
-
-    // Send task._id to C++
-    await cppBridge.addToQueue(task._id.toString());
-
     res.json({
       success: true,
       message: 'Task added to processing queue',
-      queueSize: queue.tasks.length,
-      position: queue.tasks.length
+      queueSize: cppResult.queueSize,
+      position: cppResult.queueSize
     });
 
   } catch (err) {
@@ -90,7 +83,7 @@ queueRoute.post('/add/:taskId', async (req, res) => {
 
 // ============================================
 // Traiter la prochaine tâche (Defiller)
-// Description: Retire la première tâche de la file de l'utilisateur (FIFO) . 
+// Description: Retire la prochaine tâche de la file de l'utilisateur selon sa politique d'ordonnancement.
 //              La tâche est ensuite marquée comme `IN_PROGRESS` (2) dans la base de données.
 // Reponse succés en json format:
 // {
@@ -103,23 +96,18 @@ queueRoute.post('/add/:taskId', async (req, res) => {
 // ============================================
 queueRoute.post('/next', async (req, res) => {
   try {
-    const queue = await getUserQueue(req.userId);
-
-    if (queue.tasks.length === 0) {
-      return res.status(400).json({
+    // Dequeue in C++: the engine picks the next task and marks it IN_PROGRESS
+    const cppResult = await cppBridge.processNextTask(req.userId);
+    if (!cppResult.success) {
+      const status = cppResult.error === 'Task not found' ? 404 : 400;
+      return res.status(status).json({
         success: false,
-        message: 'Processing queue is empty'
+        message: cppResult.error
       });
     }
 
-    const queuedTask = queue.tasks.shift();
-    await queue.save();
-
-    // Process in C++ queue
-    const cppResult = await cppBridge.processNextTask(req.userId);
-
-    const task = await Task.findByIdAndUpdate(
-      queuedTask.taskId,
+    const task = await Task.findOneAndUpdate(
+      { taskId: cppResult.task.id, userId: req.userId },
       { status: 2 },
       { new: true }
     );
@@ -135,7 +123,7 @@ queueRoute.post('/next', async (req, res) => {
       success: true,
       message: 'Started working on task',
       task: task,
-      remainingInQueue: queue.tasks.length
+      remainingInQueue: cppResult.remainingInQueue
     });
 
   } catch (err) {
@@ -149,13 +137,17 @@ queueRoute.post('/next', async (req, res) => {
 
 // ============================================
 // Voir la file de traitement
-// Description: Renvoie une liste complète des tâches actuellement en attente dans la file de l'utilisateur, 
+// Description: Renvoie une page des tâches en attente dans la file de l'utilisateur, dans leur ordre de sortie,
 //              y compris leurs métadonnées (position, date d'ajout) et les détails de la tâche.
+//              Pagination : ?offset=&limit= ou ?cursor= (nextCursor de la page précédente) ; un curseur
+//              dont la tâche a quitté la file est refusé (409), le client repart alors du début.
 // Reponse succés en json format:
 // {
 //   "success": true,
 //   "queueSize": 1,
 //   "isEmpty": false,
+//   "policy": "fifo",
+//   "nextCursor": null,
 //   "queue": [
 //     {
 //       "position": 1,
@@ -169,36 +161,31 @@ queueRoute.post('/next', async (req, res) => {
 // ============================================
 queueRoute.get('/', async (req, res) => {
   try {
-    const queue = await getUserQueue(req.userId);
-
-    const taskIds = queue.tasks.map(t => t.taskId);
-
-    const tasks = await Task.find({ _id: { $in: taskIds } });
-
-    const queueWithDetails = queue.tasks.map((queueItem, index) => {
-      const task = tasks.find(t => t._id.toString() === queueItem.taskId.toString());
-
-      return {
-        position: index + 1,
-        taskId: queueItem.taskId,
-        addedAt: queueItem.addedAt,
-        task: task
-          ? {
-              title: task.title,
-              description: task.description,
-              status: task.status,
-              priority: task.priority,
-              dueDate: task.dueDate,
-            }
-          : null
-      };
-    });
+    const options = {};
+    if (req.query.limit !== undefined) options.limit = parseInt(req.query.limit, 10);
+    if (req.query.cursor) options.cursor = String(req.query.cursor);
+    else if (req.query.offset !== undefined) options.offset = parseInt(req.query.offset, 10);
+
+    const cppResult = await cppBridge.viewQueue(req.userId, options);
+    if (!cppResult.success) {
+      return res.status(cppResult.staleCursor ? 409 : 400).json({
+        success: false,
+        error: cppResult.error
+      });
+    }
 
     res.json({
       success: true,
-      queueSize: queue.tasks.length,
-      isEmpty: queue.tasks.length === 0,
-      queue: queueWithDetails
+      queueSize: cppResult.queueSize,
+      isEmpty: cppResult.isEmpty,
+      policy: cppResult.policy,
+      nextCursor: cppResult.nextCursor,
+      queue: cppResult.queue.map(item => ({
+        position: item.position,
+        taskId: item.taskId,
+        addedAt: fromSeconds(item.enqueuedAt),
+        task: item.task ? taskSummary(item.task) : null
+      }))
     });
 
   } catch (err) {
@@ -222,19 +209,12 @@ queueRoute.get('/', async (req, res) => {
 // ============================================
 queueRoute.delete('/clear', async (req, res) => {
   try {
-    const queue = await getUserQueue(req.userId);
-    const clearedCount = queue.tasks.length;
-
-    // Clear MongoDB queue
-    queue.tasks = [];
-    await queue.save();
-
-    // Clear C++ queue too (important!)
-    await cppBridge.clearQueue(req.userId);
+    const cppResult = await cppBridge.clearQueue(req.userId);
+    if (!cppResult.success) throw new Error(cppResult.error);
 
     res.json({
       success: true,
-      message: `Cleared ${clearedCount} tasks from queue`,
+      message: `Cleared ${cppResult.cleared} tasks from queue`,
       queueSize: 0
     });
 
@@ -249,9 +229,8 @@ queueRoute.delete('/clear', async (req, res) => {
 
 // ============================================
 // Obtenir le statut de la file
-// Description: Renvoie des informations agrégées sur l'état de la file d'attente de l'utilisateur,
-//              y compris la taille de la file MongoDB et la taille de la file C++ sous-jacente,
-//              pour des raisons de surveillance et de cohérence
+// Description: Renvoie des informations agrégées sur l'état de la file d'attente de l'utilisateur
+//              (file du moteur C++). cppQueueSize est conservé pour les clients existants : il vaut queueSize.
 // Reponse succés en json format:
 // {
 // "success": true,
@@ -265,41 +244,19 @@ queueRoute.delete('/clear', async (req, res) => {
 // ============================================
 queueRoute.get('/status', async (req, res) => {
   try {
-    const queue = await getUserQueue(req.userId);
-    const isEmpty = queue.tasks.length === 0;
-
-    let nextTask = null;
-    if (!isEmpty) {
-      nextTask = await Task.findById(queue.tasks[0].taskId).select(
-        'title description priority status dueDate'
-      );
-    }
+    // The first page of one entry gives both the size and the next task
+    const cppResult = await cppBridge.viewQueue(req.userId, { limit: 1 });
+    if (!cppResult.success) throw new Error(cppResult.error);
 
-    // --- Get C++ queue status safely ---
-    let cppQueueSize = 0;
-    try {
-      const cppResult = await cppBridge.getQueueStatus(req.userId);
-      cppQueueSize = cppResult?.queueSize ?? 0;
-    } catch (cppErr) {
-      cppQueueSize = -1;
-    }
+    const next = cppResult.queue[0];
 
     res.json({
       success: true,
-      queueSize: queue.tasks.length,
-      isEmpty,
-      hasNext: !isEmpty,
-      nextTask: nextTask
-        ? {
-            id: nextTask._id.toString(),
-            title: nextTask.title,
-            description: nextTask.description,
-            priority: nextTask.priority,
-            status: nextTask.status,
-            dueDate: nextTask.dueDate
-          }
-        : null,
-      cppQueueSize
+      queueSize: cppResult.queueSize,
+      isEmpty: cppResult.isEmpty,
+      hasNext: !cppResult.isEmpty,
+      nextTask: next && next.task ? taskSummary(next.task) : null,
+      cppQueueSize: cppResult.queueSize
     });
 
   } catch (err) {
@@ -325,42 +282,31 @@ queueRoute.get('/status', async (req, res) => {
 // ============================================
 queueRoute.get('/peek', async (req, res) => {
   try {
-    const queue = await getUserQueue(req.userId);
+    const cppResult = await cppBridge.viewQueue(req.userId, { limit: 1 });
+    if (!cppResult.success) throw new Error(cppResult.error);
 
-    if (queue.tasks.length === 0) {
+    if (cppResult.isEmpty) {
       return res.status(404).json({
         success: false,
         message: 'Queue is empty'
       });
     }
 
-    const nextTaskId = queue.tasks[0].taskId;
+    const next = cppResult.queue[0];
 
-    // Fetch correct task
-    const nextTask = await Task.findById(nextTaskId).select(
-      'title description priority status dueDate'
-    );
-
-    if (!nextTask) {
+    if (!next.task) {
       return res.status(404).json({
         success: false,
-        message: 'Task not found in database'
+        message: 'Task not found'
       });
     }
 
     res.json({
       success: true,
       message: 'Next task in queue',
-      task: {
-        id: nextTask._id.toString(),
-        title: nextTask.title,
-        description: nextTask.description,
-        priority: nextTask.priority,
-        status: nextTask.status,
-        dueDate: nextTask.dueDate
-      },
+      task: taskSummary(next.task),
       position: 1,
-      remainingInQueue: queue.tasks.length
+      remainingInQueue: cppResult.queueSize
     });
 
   } catch (err) {
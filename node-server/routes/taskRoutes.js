@@ -3,7 +3,6 @@ const { verifyToken } = require('../middleware/authMiddleware');
 const cppBridge = require('../utils/cppBridge');
 const Task = require('../models/Task');
 const Stack = require('../models/Stack');
-const moment = require('moment');
 const crypto = require('crypto');
 const User = require('../models/User');
 
@@ -13,6 +12,29 @@ const router = express.Router();
 // All task operations require a valid user token.
 router.use(verifyToken);
 
+// Extrait l'ETag d'un en-tête If-None-Match (sans le préfixe faible W/ ni les guillemets)
+const requestEtag = (req) => {
+  const header = req.get('If-None-Match');
+  return header ? header.replace(/^W\//, '').replace(/"/g, '') : undefined;
+};
+
+// Extrait la version attendue d'un en-tête If-Match (l'ETag d'une tâche commence par sa version)
+const expectedVersion = (req) => {
+  const header = req.get('If-Match');
+  const version = header ? parseInt(header.replace(/^W\//, '').replace(/"/g, ''), 10) : NaN;
+  return Number.isNaN(version) ? undefined : version;
+};
+
+// Date d'achèvement tenue par le moteur C++ (en secondes, 0 si inconnue), au format de MongoDB
+const completionDate = (cppTask) => (cppTask && cppTask.completedAt ? new Date(cppTask.completedAt * 1000) : null);
+
+// Réponse 412 lorsque la tâche a été modifiée depuis la version indiquée par If-Match
+const versionConflict = (res, result) => res.status(412).json({
+  success: false,
+  message: 'Task was modified by another request',
+  currentVersion: result.currentVersion
+});
+
 // ============================================
 //  Créer une Tâche
 // Description: Gère la création d'une nouvelle tâche.
@@ -50,7 +72,7 @@ router.post('/', async (req, res) => {
     const cppResult = await cppBridge.createTask(taskData);
     if (!cppResult.success) return res.status(400).json(cppResult);
 
-    const dbTask = new Task(taskData);
+    const dbTask = new Task({ ...taskData, completedAt: completionDate(cppResult.data) });
     await dbTask.save();
 
     let stack = await Stack.findOne({ userId: req.userId });
@@ -84,10 +106,16 @@ router.post('/', async (req, res) => {
 //   count: tasks.length,
 //   data: tasks // Tableau de toutres les Taches Objet
 // }
+// En-têtes: ETag sur la réponse ; If-None-Match renvoie 304 sans relire MongoDB si aucune tâche n'a changé
 // Route:  GET /api/tasks
 // ============================================
 router.get('/', async (req, res) => {
   try {
+    // Version de la liste tenue par le moteur C++ (seuls les identifiants sont projetés)
+    const probe = await cppBridge.getTasks(req.userId, ['id'], requestEtag(req));
+    if (probe.notModified) return res.status(304).end();
+    if (probe.etag) res.set('ETag', `"${probe.etag}"`);
+
     // Fetch from MongoDB
     const tasks = await Task.find({ userId: req.userId }).sort({ createdAt: -1 });
 
@@ -134,24 +162,16 @@ router.get('/stats' ,async (req, res) => {
       });
     }
 
-    const totalTasks = await Task.countDocuments();
+    // Compteurs maintenus par le moteur C++ à chaque mutation : aucune requête de comptage sur les tâches
+    const stats = await cppBridge.getStats(userId);
+    if (!stats.success) return res.status(500).json(stats);
 
-    const totalUserTasks = await Task.countDocuments({ userId: userId });
-    
-    const totalUsers = await User.countDocuments({ isVerified: true });
+    const totalTasks = stats.totalTasks;
+    const totalUserTasks = stats.data.total;
+    const completedTasks = stats.data.byStatus.completed;
+    const tasksThisMonth = stats.data.createdThisMonth;
 
-    const completedTasks = await Task.countDocuments({
-      userId,
-      status: 3 // COMPLETED
-    });
-
-    const now = new Date();
-    const firstDayOfMonth = new Date(now.getFullYear(), now.getMonth(), 1);
-
-    const tasksThisMonth = await Task.countDocuments({
-      userId,
-      createdAt: { $gte: firstDayOfMonth }
-    });
+    const totalUsers = await User.countDocuments({ isVerified: true });
 
     return res.json({
       success: true,
@@ -216,9 +236,11 @@ router.get('/status-stats', async (req, res) => {
     console.log(req.user);
     
 
-    const tasks = await Task.find({ userId });
+    // Répartition par statut lue dans les compteurs du moteur C++, sans charger les tâches
+    const stats = await cppBridge.getStats(userId);
+    if (!stats.success) return res.status(500).json(stats);
 
-    if (!tasks || tasks.length === 0) {
+    if (stats.data.total === 0) {
       return res.json({
         success: true,
         message: "No tasks found",
@@ -231,27 +253,7 @@ router.get('/status-stats', async (req, res) => {
       });
     }
 
-    let todo = 0;
-    let pending = 0;
-    let inProgress = 0;
-    let completed = 0;
-
-    tasks.forEach(task => {
-      switch (task.status) {
-        case 0:
-          todo++;
-          break;
-        case 1:
-          pending++;
-          break;
-        case 2:
-          inProgress++;
-          break;
-        case 3:
-          completed++;
-          break;
-      }
-    });
+    const { todo, pending, inProgress, completed } = stats.data.byStatus;
 
     return res.json({
       success: true,
@@ -275,50 +277,25 @@ router.get('/status-stats', async (req, res) => {
 
 // ============================================
 //   Obtenir les Statistiques Hebdomadaires (Graphique Linéaire)
-// Description: Agrège le nombre de tâches complétées (status: 3) par jour pour la semaine en cours (du lundi au dimanche), souvent utilisé pour un graphique linéaire .
+// Description: Nombre de tâches de l'utilisateur complétées (et créées) par jour pour la semaine en cours (du lundi au dimanche), souvent utilisé pour un graphique linéaire .
 // Reponse succés en json format:
 // {
 //   "success": true,
 //     "data": [
-//       { "day": "Mon", "completed": 2 },
-//       { "day": "Tue", "completed": 0 },
-//     { "day": "Wed", "completed": 5 }, // ... 
+//       { "day": "Mon", "completed": 2, "created": 3 },
+//       { "day": "Tue", "completed": 0, "created": 1 },
+//     { "day": "Wed", "completed": 5, "created": 0 }, // ... 
 //   ]
 // }
 // Route:  GET /api/tasks/week-stats
 // ============================================
 router.get('/week-stats', async (req, res) => {
   try {
-    const startOfWeek = moment().startOf("isoWeek").toDate();
-    const endOfWeek = moment().endOf("isoWeek").toDate();
-
-    const tasks = await Task.aggregate([
-      {
-        $match: {
-          status: 3, // COMPLETED
-          createdAt: { $gte: startOfWeek, $lte: endOfWeek }
-        }
-      },
-      {
-        $group: {
-          _id: { $dayOfWeek: "$createdAt" },
-          count: { $sum: 1 }
-        }
-      }
-    ]);
-
-    const week = ["Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"];
+    // Historique quotidien maintenu par le moteur C++ (tâches de l'utilisateur terminées chaque jour de la semaine)
+    const stats = await cppBridge.getWeekStats(req.userId);
+    if (!stats.success) return res.status(500).json({ success: false, message: "Server error" });
 
-    const result = week.map((day, index) => {
-      let mongoDay = index + 2;
-      if (mongoDay === 8) mongoDay = 1;
-
-      const found = tasks.find(t => t._id === mongoDay);
-      return {
-        day,
-        completed: found ? found.count : 0
-      };
-    });
+    const result = stats.data.map(({ day, completed, created }) => ({ day, completed, created }));
 
     res.json({ success: true, data: result });
 
@@ -329,7 +306,7 @@ router.get('/week-stats', async (req, res) => {
 
 // ============================================
 // Rechercher des Tâches par Titre
-// Description: Permet aux utilisateurs de rechercher leurs tâches par titre en utilisant une expression régulière insensible à la casse (`$regex`, `$options: 'i'`).
+// Description: Permet aux utilisateurs de rechercher leurs tâches par sous-chaîne (insensible à la casse) du titre ou de la description, via l'index de recherche du moteur C++ ; résultats classés par priorité puis échéance.
 // Reponse succés en json format:
 // {
 //   "success": true,
@@ -350,10 +327,15 @@ router.get('/search', async (req, res) => {
       });
     }
 
-    const tasks = await Task.find({
-      userId,
-      title: { $regex: title.trim(), $options: 'i' }
-    }).sort({ dueDate: 1 });
+    // Index de trigrammes du moteur C++ : identifiants classés par priorité puis échéance, sans $regex sur Mongo
+    // (seul l'identifiant est projeté : les documents complets viennent de Mongo)
+    const result = await cppBridge.searchTasks(userId, title.trim(), 500, ['id']);
+    if (!result.success) return res.status(400).json(result);
+
+    const ids = result.data.map(task => task.id);
+    const found = await Task.find({ userId, taskId: { $in: ids } });
+    const byId = new Map(found.map(task => [task.taskId, task]));
+    const tasks = ids.map(id => byId.get(id)).filter(Boolean);
 
     res.json({
       success: true,
@@ -370,6 +352,252 @@ router.get('/search', async (req, res) => {
   }
 });
 
+// ============================================
+// Compléter un Titre (Autocomplétion)
+// Description: Propose, pendant la saisie, les titres distincts de l'utilisateur qui commencent par le texte saisi (insensible à la casse), via l'index d'autocomplétion du moteur C++.
+// Reponse succés en json format:
+// {
+//   "success": true,
+//   "data": [ { "title": "Weekly report", "count": 3 } ]
+// }
+// Route:  GET /api/tasks/autocomplete?prefix=wee&limit=10
+// ============================================
+router.get('/autocomplete', async (req, res) => {
+  try {
+    const { prefix, limit } = req.query;
+
+    if (!prefix || prefix.trim() === '') {
+      return res.status(400).json({
+        success: false,
+        message: 'Prefix query parameter is required'
+      });
+    }
+
+    const result = await cppBridge.autocomplete(req.userId, prefix, limit ? Number(limit) : undefined);
+    if (!result.success) return res.status(400).json(result);
+
+    res.json({ success: true, data: result.data });
+
+  } catch (err) {
+    res.status(500).json({
+      success: false,
+      message: 'Failed to autocomplete titles',
+      error: err.message
+    });
+  }
+});
+
+// ============================================
+// Interroger les Tâches (Filtre, Tri et Pagination)
+// Description: Filtre, trie et pagine les tâches de l'utilisateur dans le moteur C++, qui choisit l'index le moins coûteux ; seule la page demandée est renvoyée.
+// Corps de la requête (tous les champs sont optionnels):
+// {
+//   "status": [0, 1], "minPriority": 2, "maxPriority": 3, "favorite": true, "tag": "work",
+//   "dueFrom": 1760000000, "dueTo": 1770000000, "text": "rapport",
+//   "sort": "-createdAt" | "updatedAt" | "dueDate" | "priority", "limit": 50, "cursor": "<nextCursor>",
+//   "fields": ["title", "status", "priority"] // projection : seuls ces champs (et l'id) sont renvoyés
+// }
+// Reponse succés en json format:
+// {
+//   "success": true,
+//   "count": 50,
+//   "data": [ /* Tableau de Tache objets */ ],
+//   "nextCursor": "..." // null sur la dernière page
+// }
+// Route:  POST /api/tasks/query
+// ============================================
+router.post('/query', async (req, res) => {
+  try {
+    const result = await cppBridge.queryTasks(req.userId, req.body || {});
+    if (!result.success) return res.status(400).json(result);
+
+    res.json({
+      success: true,
+      count: result.count,
+      data: result.data,
+      nextCursor: result.nextCursor
+    });
+
+  } catch (err) {
+    res.status(500).json({
+      success: false,
+      message: 'Failed to query tasks',
+      error: err.message
+    });
+  }
+});
+
+// ============================================
+// Tâches à Traiter en Priorité
+// Description: Renvoie les tâches non terminées les plus urgentes de l'utilisateur (priorité décroissante, puis échéance la plus proche ; les tâches sans échéance en dernier), lues en tête d'un index ordonné du moteur C++ sans trier toute la liste.
+// Paramètres: ?limit=10 (100 au plus) &includeCompleted=true
+// Reponse succés en json format:
+// {
+//   "success": true,
+//   "count": 10,
+//   "data": [ /* Tableau de Tache objets */ ]
+// }
+// Route:  GET /api/tasks/next
+// ============================================
+router.get('/next', async (req, res) => {
+  try {
+    const { limit, includeCompleted } = req.query;
+    const options = {};
+    if (limit) options.limit = Number(limit);
+    if (includeCompleted === 'true') options.includeCompleted = true;
+
+    const result = await cppBridge.getTopTasks(req.userId, options);
+    if (!result.success) return res.status(400).json(result);
+
+    res.json({
+      success: true,
+      count: result.count,
+      data: result.data
+    });
+
+  } catch (err) {
+    res.status(500).json({
+      success: false,
+      message: 'Failed to fetch next tasks',
+      error: err.message
+    });
+  }
+});
+
+// ============================================
+// Synchronisation Différentielle
+// Description: Renvoie seulement ce qui a changé depuis la version connue du client : tâches créées ou modifiées, identifiants des tâches supprimées (à appliquer en premier), et la nouvelle version à conserver. Sans "since", ou si la version est trop ancienne (redémarrage du moteur, trop de suppressions), renvoie la liste complète avec "resync": true.
+// Paramètres: ?since=<version> &limit=500 (5000 au plus ; rappeler avec la version renvoyée tant que hasMore est vrai)
+// Reponse succés en json format:
+// {
+//   "success": true,
+//   "resync": false,
+//   "version": 1792315673734944,
+//   "hasMore": false,
+//   "changed": [ /* Tableau de Tache objets */ ],
+//   "deleted": [ "taskId", ... ]
+// }
+// Route:  GET /api/tasks/sync?since=<version>
+// ============================================
+router.get('/sync', async (req, res) => {
+  try {
+    const { since, limit } = req.query;
+
+    if (since !== undefined) {
+      const result = await cppBridge.getChangesSince(req.userId, Number(since), limit ? Number(limit) : undefined);
+      if (!result.success) return res.status(400).json(result);
+
+      if (!result.resync) {
+        return res.json({
+          success: true,
+          resync: false,
+          version: result.version,
+          hasMore: result.hasMore,
+          changed: result.changed,
+          deleted: result.deleted
+        });
+      }
+    }
+
+    const all = await cppBridge.getTasks(req.userId);
+    if (!all.success) return res.status(400).json(all);
+
+    res.json({
+      success: true,
+      resync: true,
+      version: all.version,
+      hasMore: false,
+      changed: all.data,
+      deleted: []
+    });
+
+  } catch (err) {
+    res.status(500).json({
+      success: false,
+      message: 'Failed to sync tasks',
+      error: err.message
+    });
+  }
+});
+
+// ============================================
+// Tâches en Retard
+// Description: Renvoie les tâches non terminées dont l'échéance est dépassée, de la plus ancienne à la plus récente, lues dans l'index des échéances du moteur C++ (sans parcourir toutes les tâches).
+// Paramètres: ?limit=100 (1000 au plus)
+// Reponse succés en json format:
+// {
+//   "success": true,
+//   "count": 3,
+//   "hasMore": false,
+//   "data": [ /* Tableau de Tache objets */ ]
+// }
+// Route:  GET /api/tasks/overdue
+// ============================================
+router.get('/overdue', async (req, res) => {
+  try {
+    const { limit } = req.query;
+    const result = await cppBridge.getOverdueTasks(req.userId, limit ? Number(limit) : undefined);
+    if (!result.success) return res.status(400).json(result);
+
+    res.json({
+      success: true,
+      count: result.count,
+      hasMore: result.hasMore,
+      data: result.data
+    });
+
+  } catch (err) {
+    res.status(500).json({
+      success: false,
+      message: 'Failed to fetch overdue tasks',
+      error: err.message
+    });
+  }
+});
+
+// ============================================
+// Tâches à Échéance Proche
+// Description: Renvoie les tâches non terminées dont l'échéance tombe dans les prochaines secondes, de la plus proche à la plus lointaine.
+// Paramètres: ?seconds=86400 (obligatoire) &limit=100
+// Reponse succés en json format:
+// {
+//   "success": true,
+//   "count": 2,
+//   "hasMore": false,
+//   "data": [ /* Tableau de Tache objets */ ]
+// }
+// Route:  GET /api/tasks/due-within?seconds=86400
+// ============================================
+router.get('/due-within', async (req, res) => {
+  try {
+    const seconds = Number(req.query.seconds);
+    if (!Number.isInteger(seconds) || seconds < 0) {
+      return res.status(400).json({
+        success: false,
+        message: 'seconds query parameter must be a positive integer'
+      });
+    }
+
+    const { limit } = req.query;
+    const result = await cppBridge.getDueWithin(req.userId, seconds, limit ? Number(limit) : undefined);
+    if (!result.success) return res.status(400).json(result);
+
+    res.json({
+      success: true,
+      count: result.count,
+      hasMore: result.hasMore,
+      data: result.data
+    });
+
+  } catch (err) {
+    res.status(500).json({
+      success: false,
+      message: 'Failed to fetch tasks due soon',
+      error: err.message
+    });
+  }
+});
+
 // ============================================
 // Effacer Toutes les Tâches
 // Description: Supprime toutes les tâches appartenant à l'utilisateur connecté.
@@ -385,7 +613,13 @@ router.post('/clear', async (req, res) => {
   try {
     const userId = req.userId; // Auth middleware should provide this
 
-    // Delete all tasks for the current user
+    // 1️⃣ Clear in C++ first, so the engine's ETag and stats follow the deletion
+    const cppResult = await cppBridge.clearTasks(userId);
+    if (!cppResult.success) {
+      return res.status(500).json({ success: false, message: 'Failed to clear tasks', error: cppResult.error });
+    }
+
+    // 2️⃣ Delete all tasks for the current user in Mongo
     const result = await Task.deleteMany({ userId });
 
     res.json({
@@ -411,12 +645,19 @@ router.post('/clear', async (req, res) => {
 //   "success": true,
 //   "data": { /* task object */ }
 // }
+// En-têtes: ETag sur la réponse ; If-None-Match renvoie 304 sans relire MongoDB si la tâche n'a pas changé
 // Route:  GET /api/tasks/:id
 // ============================================
 router.get('/:id', async (req, res) => {
   try {
     const taskId = req.params.id;
 
+    // Version de la tâche tenue par le moteur C++, utilisée comme ETag (seulement pour les tâches de l'utilisateur)
+    const probe = await cppBridge.getTaskById(taskId, ['userId', 'version']);
+    const etag = probe.success && probe.data.userId === String(req.userId) ? String(probe.data.version) : undefined;
+    if (etag && etag === requestEtag(req)) return res.status(304).end();
+    if (etag) res.set('ETag', `"${etag}"`);
+
     // Fetch from MongoDB
     const task = await Task.findOne({ taskId, userId: req.userId });
 
@@ -452,6 +693,7 @@ router.get('/:id', async (req, res) => {
 //   "message": "Task updated successfully",
 //   "data": { /* updated task object */ }
 // }
+// En-têtes: If-Match: <ETag de la tâche> rend la mise à jour conditionnelle (412 si la tâche a changé entre-temps)
 //   // Route:  PUT /api/tasks/:id
 // ============================================
 router.put('/:id', async (req, res) => {
@@ -462,16 +704,18 @@ router.put('/:id', async (req, res) => {
     const oldTask = await Task.findOne({ taskId, userId: req.userId });
     if (!oldTask) return res.status(404).json({ success: false, message: 'Task not found' });
 
-    // Update in Mongo
+    // Update in C++ first: a stale If-Match version is rejected before anything is written
+    const cppResult = await cppBridge.updateTask(taskId, updateData, expectedVersion(req));
+    if (cppResult.conflict) return versionConflict(res, cppResult);
+    if (cppResult.data) res.set('ETag', `"${cppResult.data.version}"`);
+
+    // Update in Mongo (the completion date is stamped by the engine, so it survives a restart without a WAL)
     const task = await Task.findOneAndUpdate(
       { taskId, userId: req.userId },
-      updateData,
+      cppResult.data ? { ...updateData, completedAt: completionDate(cppResult.data) } : updateData,
       { new: true }
     );
 
-    // Update in C++
-    await cppBridge.updateTask(taskId, updateData);
-
     // 3️⃣ Push UPDATE to undo stack
     let stack = await Stack.findOne({ userId: req.userId });
     if (!stack) stack = new Stack({ userId: req.userId, stack: [] });
@@ -503,6 +747,7 @@ router.put('/:id', async (req, res) => {
 //    "success": true,
 //    "message": "Task deleted successfully" 
 // }
+// En-têtes: If-Match: <ETag de la tâche> rend la suppression conditionnelle (412 si la tâche a changé entre-temps)
 //     // Route:  DELETE /api/tasks/:id
 // ============================================
 router.delete('/:id', async (req, res) => {
@@ -512,11 +757,12 @@ router.delete('/:id', async (req, res) => {
 
     if (!task) return res.status(404).json({ success: false, message: 'Task not found' });
 
-    // 1️⃣ Delete in Mongo
-    await Task.deleteOne({ taskId, userId: req.userId });
+    // 1️⃣ Delete in C++ first: a stale If-Match version is rejected before anything is deleted
+    const cppResult = await cppBridge.deleteTask(taskId, expectedVersion(req));
+    if (cppResult.conflict) return versionConflict(res, cppResult);
 
-    // 2️⃣ Delete in C++
-    await cppBridge.deleteTask(taskId);
+    // 2️⃣ Delete in Mongo
+    await Task.deleteOne({ taskId, userId: req.userId });
 
     // 3️⃣ Push DELETE to undo stack
     let stack = await Stack.findOne({ userId: req.userId });
@@ -1,4 +1,7 @@
 const express = require('express');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
 const mongoose = require('mongoose');
 const cors = require('cors');
 require('dotenv').config();
@@ -16,6 +19,8 @@ const cppBridge = require('./utils/cppBridge');
 
 const Task = require('./models/Task');
 const Queue = require('./models/Queue');
+const User = require('./models/User');
+const { sendDueReminderEmail } = require('./utils/emailService');
 
 const app = express();
 
@@ -84,22 +89,85 @@ process.on('SIGTERM', () => {
     process.exit(0);
 });
 
+// --- Rappels d'Échéance ---
+
+// Le moteur C++ annonce chaque échéance atteinte (CPP_DUE_REMINDERS=true) : aucun parcours périodique des tâches
+cppBridge.onTaskDue(async (event) => {
+    try {
+        const user = await User.findById(event.userId);
+        if (!user || !user.isVerified) return;
+        await sendDueReminderEmail(user.email, user.username, event);
+    } catch (err) {
+        console.error('Échec du rappel d\'échéance :', err.message);
+    }
+});
+
 // --- Synchronisation des Données au Démarrage ---
 
 /**
- * Charge les files d'attente persistantes depuis MongoDB et synchronise leur état avec le système de gestion des tâches en C++.
- * Ceci garantit que la file d'attente du système C++ (basée sur la mémoire) démarre avec les données les plus récentes.
+ * Charge toutes les tâches de MongoDB dans le système C++ en une seule importation : les tâches sont écrites
+ * dans un fichier NDJSON temporaire (une tâche par ligne, dates en secondes) que le moteur analyse en parallèle.
+ * Inutile lorsque le moteur restaure lui-même son état (journal ou instantané).
+ */
+async function loadTasks() {
+    if (process.env.CPP_WAL_PATH || process.env.CPP_SNAPSHOT_PATH) return;
+
+    const dumpPath = path.join(os.tmpdir(), `task-manager-import-${process.pid}.ndjson`);
+    const toSeconds = (date) => (date ? Math.floor(new Date(date).getTime() / 1000) : null);
+
+    try {
+        const out = fs.createWriteStream(dumpPath);
+        for await (const task of Task.find({}).lean().cursor()) {
+            const line = JSON.stringify({
+                taskId: task.taskId,
+                userId: String(task.userId),
+                title: task.title,
+                description: task.description || '',
+                priority: task.priority,
+                status: task.status,
+                tags: task.tags || [],
+                isFavorite: !!task.isFavorite,
+                dueDate: toSeconds(task.dueDate),
+                createdAt: toSeconds(task.createdAt),
+                // Absente des tâches terminées avant son ajout : l'achèvement reste alors non daté
+                completedAt: toSeconds(task.completedAt)
+            }) + '\n';
+            if (!out.write(line)) await new Promise(resolve => out.once('drain', resolve));
+        }
+        await new Promise((resolve, reject) => out.end(err => (err ? reject(err) : resolve())));
+
+        const result = await cppBridge.importTasks(dumpPath);
+        if (!result.success) throw new Error(result.error);
+        console.log(`Tâches importées dans C++ : ${result.imported} (${result.tasksPerSecond} tâches/s)`);
+    } finally {
+        fs.promises.unlink(dumpPath).catch(() => {});
+    }
+}
+
+/**
+ * Charge les tâches dans le moteur C++, puis y transfère les files d'attente que d'anciennes versions gardaient
+ * dans MongoDB. La file vit désormais dans le moteur : chaque ancienne file est mise en file une seule fois
+ * (ses tâches repérées par leur taskId), puis supprimée de MongoDB.
  */
 (async function loadQueue() {
   try {
+        await loadTasks();
       
         const allQueues = await Queue.find({});
 
         for (const queue of allQueues) {
-            for (const task of queue.tasks) {
-                // Appeler le pont C++ pour ajouter la tâche à la structure de file d'attente C++
-                await cppBridge.addToQueue(task.taskId);
+            if (queue.tasks.length > 0) {
+                const queuedIds = queue.tasks.map(task => task.taskId);
+                const tasks = await Task.find({ _id: { $in: queuedIds } }).select('taskId').lean();
+                const taskIds = new Map(tasks.map(task => [String(task._id), task.taskId]));
+
+                // Appeler le pont C++ une seule fois par file, dans l'ordre de la file
+                const result = await cppBridge.enqueueMany(
+                    queuedIds.map(id => taskIds.get(String(id))).filter(Boolean)
+                );
+                if (!result.success) throw new Error(result.error);
             }
+            await Queue.deleteOne({ _id: queue._id });
         }
 
         console.log('Files d\'attente de traitement synchronisées avec C++');
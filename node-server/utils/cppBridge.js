@@ -1,5 +1,6 @@
 const { spawn } = require('child_process');
 const path = require('path');
+const readline = require('readline');
 
 // CppBridge : Classe de passerelle entre Node.js et le processus C++
 // Cette classe gère le processus enfant C++ et toute la communication bidirectionnelle
@@ -8,14 +9,78 @@ class CppBridge {
   // Constructeur : initialise le processus C++ au moment de l'instanciation
   constructor() {
     this.cppProcess = null;
+    this.dueHandlers = [];
+    this.dueEvents = process.env.CPP_DUE_REMINDERS === 'true';
     this.initProcess();
+
+    // Le moteur vérifie les échéances à chaque commande : une commande légère le réveille lorsque le serveur est inactif
+    // (sa réponse prend sa place dans la file des commandes en attente, comme celle de toute autre commande)
+    if (this.dueEvents) {
+      this.dueTimer = setInterval(() => this.getDueStatus().catch(() => {}), 30 * 1000);
+      this.dueTimer.unref();
+    }
   }
 
   initProcess() {
     const cppExecutable = path.join(__dirname, '../../cpp-backend/task_manager');
 
+    // Options du moteur : journal d'écriture anticipée (CPP_WAL_PATH) et politique fsync (CPP_WAL_FSYNC),
+    // instantanés (CPP_SNAPSHOT_PATH) et leur période en secondes (CPP_SNAPSHOT_INTERVAL),
+    // points de contrôle par taille du journal (CPP_CHECKPOINT_BYTES) et débit d'écriture (CPP_CHECKPOINT_RATE),
+    // flux des mutations validées vers un fichier ou un descripteur "fd:N" (CPP_CDC_PATH, nécessite le journal),
+    // événements d'échéance sur le descripteur 3 (CPP_DUE_REMINDERS=true),
+    // threads des traitements en masse : importation, exportation, reconstruction des index (CPP_THREADS)
+    const args = [];
+    if (process.env.CPP_THREADS) args.push('--threads', process.env.CPP_THREADS);
+    if (process.env.CPP_SNAPSHOT_PATH) {
+      args.push('--snapshot', process.env.CPP_SNAPSHOT_PATH);
+      if (process.env.CPP_SNAPSHOT_INTERVAL) args.push('--snapshot-interval', process.env.CPP_SNAPSHOT_INTERVAL);
+      if (process.env.CPP_CHECKPOINT_BYTES) args.push('--checkpoint-bytes', process.env.CPP_CHECKPOINT_BYTES);
+      if (process.env.CPP_CHECKPOINT_RATE) args.push('--checkpoint-rate', process.env.CPP_CHECKPOINT_RATE);
+    }
+    if (process.env.CPP_WAL_PATH) {
+      args.push('--wal', process.env.CPP_WAL_PATH);
+      if (process.env.CPP_WAL_FSYNC) args.push('--fsync', process.env.CPP_WAL_FSYNC);
+      if (process.env.CPP_CDC_PATH) args.push('--cdc', process.env.CPP_CDC_PATH);
+    }
+
+    if (this.dueEvents) args.push('--due-events', 'fd:3');
+
     // Démarre le processus C++ en tant que processus enfant Node.js 
-    this.cppProcess = spawn(cppExecutable);
+    this.cppProcess = spawn(cppExecutable, args, {
+      stdio: this.dueEvents ? ['pipe', 'pipe', 'pipe', 'pipe'] : 'pipe'
+    });
+
+    // Le moteur répond à chaque commande par une ligne, dans l'ordre de réception : chaque ligne de stdout
+    // règle la plus ancienne commande en attente, quel que soit le découpage des données par le tube
+    const pending = [];
+    this.pending = pending;
+    readline.createInterface({ input: this.cppProcess.stdout }).on('line', (line) => {
+      const request = pending.shift();
+      if (!request) {
+        return console.error('Unexpected output from C++: ' + line);
+      }
+      clearTimeout(request.timeout);
+
+      try {
+        request.resolve(JSON.parse(line));
+      } catch (err) {
+        request.reject(new Error('Invalid JSON from C++: ' + line));
+      }
+    });
+
+    // Chaque ligne du descripteur 3 est un événement {"type":"task.due", taskId, userId, title, dueDate}
+    if (this.dueEvents) {
+      readline.createInterface({ input: this.cppProcess.stdio[3] }).on('line', (line) => {
+        let event;
+        try {
+          event = JSON.parse(line);
+        } catch (err) {
+          return console.error('Invalid due event from C++: ' + line);
+        }
+        this.dueHandlers.forEach(handler => handler(event));
+      });
+    }
 
     // Gère les erreurs envoyées par le flux d'erreur standard (stderr) du processus C++
     this.cppProcess.stderr.on('data', (data) => {
@@ -26,6 +91,12 @@ class CppBridge {
     this.cppProcess.on('close', (code) => {
       console.log(`C++ process exited with code ${code}`);
 
+      // Les commandes restées sans réponse ne seront jamais réglées par ce processus
+      pending.splice(0).forEach((request) => {
+        clearTimeout(request.timeout);
+        request.reject(new Error('C++ process exited'));
+      });
+
       if (code !== 0) {
         setTimeout(() => this.initProcess(), 1000);
       }
@@ -33,33 +104,21 @@ class CppBridge {
   }
 
   // Méthode générique asynchrone pour envoyer des commandes au processus C++
-  async sendCommand(command) {
+  // (timeoutMs : délai maximal de réponse, plus long pour les commandes en masse comme l'importation)
+  async sendCommand(command, timeoutMs = 5000) {
     return new Promise((resolve, reject) => {
       // Convertit l'objet de commande en chaîne JSON et ajoute un saut de ligne ('\n')
       // nécessaire pour que le processus C++ puisse lire la commande en une seule ligne.
       const jsonCommand = JSON.stringify(command) + '\n';
 
-      // Définit un délai d'attente (timeout) pour éviter que l'application ne se bloque si le processus C++ ne répond pas
+      // Définit un délai d'attente (timeout) pour éviter que l'application ne se bloque si le processus C++ ne répond pas ;
+      // la commande garde sa place dans la file : sa réponse tardive sera consommée puis ignorée
       const timeout = setTimeout(() => {
         reject(new Error('C++ process timeout'));
-      }, 5000);
+      }, timeoutMs);
 
-      // Gestionnaire de données reçues sur le flux de sortie standard (stdout) du processus C++
-      const onData = (data) => {
-        clearTimeout(timeout);
-        this.cppProcess.stdout.removeListener('data', onData);
-
-        try {
-          const str = data.toString().trim();
-          const response = JSON.parse(str);
-          resolve(response);
-        } catch (err) {
-          reject(new Error('Invalid JSON from C++: ' + data.toString()));
-        }
-      };
-
-      // Écoute la prochaine donnée sur stdout (la réponse à notre commande)
-      this.cppProcess.stdout.once('data', onData);
+      // Réserve la prochaine réponse du processus C++ (voir le lecteur de stdout dans initProcess)
+      this.pending.push({ resolve, reject, timeout });
       // Envoie la commande JSON au flux d'entrée standard (stdin) du processus C++
       this.cppProcess.stdin.write(jsonCommand);
     });
@@ -87,35 +146,52 @@ class CppBridge {
   }
 
   // Envoie une commande pour récupérer toutes les tâches d'un utilisateur
-  async getTasks(userId) {
+  // (fields : liste optionnelle des champs à renvoyer, ex. ['title', 'status'] ; l'id est toujours inclus ;
+  // ifNoneMatch : ETag déjà détenu, la réponse est alors { notModified: true } s'il est toujours valide)
+  async getTasks(userId, fields, ifNoneMatch) {
     return this.sendCommand({
       action: 'getAll',
-      userId: String(userId)
+      userId: String(userId),
+      ...(fields ? { fields } : {}),
+      ...(ifNoneMatch ? { ifNoneMatch } : {})
     });
   }
 
-  // Envoie une commande pour récupérer une tâche par son ID
-  async getTaskById(taskId) {
+  // Envoie une commande pour récupérer une tâche par son ID (fields : projection optionnelle ; ifNoneMatch : ETag déjà détenu)
+  async getTaskById(taskId, fields, ifNoneMatch) {
     return this.sendCommand({
       action: 'getById',
-      taskId: String(taskId)
+      taskId: String(taskId),
+      ...(fields ? { fields } : {}),
+      ...(ifNoneMatch ? { ifNoneMatch } : {})
     });
   }
 
   // Envoie une commande pour mettre à jour une tâche
-  async updateTask(taskId, updateData) {
+  // (expectedVersion : version lue par le client ; en cas de changement entre-temps, la réponse porte conflict: true)
+  async updateTask(taskId, updateData, expectedVersion) {
     return this.sendCommand({
       action: 'update',
       taskId: String(taskId),
-      data: updateData
+      data: updateData,
+      ...(expectedVersion ? { expectedVersion } : {})
     });
   }
 
-  // Envoie une commande pour supprimer une tâche
-  async deleteTask(taskId) {
+  // Envoie une commande pour supprimer une tâche (expectedVersion : suppression conditionnelle)
+  async deleteTask(taskId, expectedVersion) {
     return this.sendCommand({
       action: 'delete',
-      taskId: String(taskId)
+      taskId: String(taskId),
+      ...(expectedVersion ? { expectedVersion } : {})
+    });
+  }
+
+  // Envoie une commande pour supprimer toutes les tâches d'un utilisateur
+  async clearTasks(userId) {
+    return this.sendCommand({
+      action: 'clear',
+      userId: String(userId)
     });
   }
 
@@ -163,10 +239,38 @@ class CppBridge {
     });
   }
 
-  // Envoie une commande pour visualiser la file d'attente C++
-  async viewQueue(userId) {
+  // Envoie un lot de tâches à ajouter à la file d'attente C++ en une seule commande
+  async enqueueMany(taskIds) {
+    return this.sendCommand({
+      action: 'enqueueMany',
+      data: { taskIds: taskIds.map(String) }
+    });
+  }
+
+  // Envoie une commande pour traiter les N prochaines tâches de la file en une seule commande
+  async processNextTasks(userId, count) {
+    return this.sendCommand({
+      action: 'processNextN',
+      userId: String(userId),
+      data: { count }
+    });
+  }
+
+  // Envoie une commande pour visualiser le contenu ordonné de la file d'attente C++
+  // (options : { offset, limit } ou { cursor, limit } avec le nextCursor de la page précédente ;
+  //  un curseur dont l'entrée a quitté la file est refusé avec staleCursor: true)
+  async viewQueue(userId, options = {}) {
     return this.sendCommand({
       action: 'viewQueue',
+      userId: String(userId),
+      data: options
+    });
+  }
+
+  // Envoie une commande pour vider la file d'attente C++ d'un utilisateur
+  async clearQueue(userId) {
+    return this.sendCommand({
+      action: 'clearQueue',
       userId: String(userId)
     });
   }
@@ -179,6 +283,215 @@ class CppBridge {
     });
   }
 
+  // Envoie une commande pour changer la politique d'ordonnancement de la file C++
+  // (policy : 'fifo', 'priority', 'deadline' ou 'aging')
+  async setQueuePolicy(userId, policy, agingSeconds) {
+    return this.sendCommand({
+      action: 'setQueuePolicy',
+      userId: String(userId),
+      data: agingSeconds !== undefined ? { policy, agingSeconds } : { policy }
+    });
+  }
+
+  // Envoie une commande pour obtenir la politique d'ordonnancement de la file C++
+  async getQueuePolicy(userId) {
+    return this.sendCommand({
+      action: 'queuePolicy',
+      userId: String(userId)
+    });
+  }
+
+  // --- BAUX (LEASES) DE LA FILE DE TRAITEMENT ---
+
+  // Retire la prochaine tâche de la file C++ avec un bail limité dans le temps
+  async leaseNextTask(userId, leaseSeconds) {
+    return this.sendCommand({
+      action: 'leaseNext',
+      userId: String(userId),
+      data: leaseSeconds !== undefined ? { leaseSeconds } : {}
+    });
+  }
+
+  // Acquitte un bail : la tâche louée est marquée comme terminée
+  async ackLease(leaseId) {
+    return this.sendCommand({
+      action: 'ack',
+      leaseId
+    });
+  }
+
+  // Rend un bail : la tâche louée est remise dans la file, sauf si elle a été modifiée entre-temps (requeued: false)
+  async nackLease(leaseId) {
+    return this.sendCommand({
+      action: 'nack',
+      leaseId
+    });
+  }
+
+  // --- RECHERCHE ---
+
+  // Envoie une requête composable (filtres, tri, limite et curseur opaque) ; renvoie une page et son nextCursor
+  // (query.fields : projection optionnelle des tâches rendues)
+  async queryTasks(userId, query = {}) {
+    const { fields, ...data } = query;
+    return this.sendCommand({
+      action: 'query',
+      userId: String(userId),
+      data,
+      ...(fields ? { fields } : {})
+    });
+  }
+
+  // Envoie une commande pour lire les k tâches les plus urgentes (priorité décroissante puis échéance la plus proche)
+  // (options : { limit, includeCompleted } ; fields : projection optionnelle)
+  async getTopTasks(userId, options = {}, fields) {
+    return this.sendCommand({
+      action: 'top',
+      userId: String(userId),
+      data: options,
+      ...(fields ? { fields } : {})
+    });
+  }
+
+  // Envoie une commande de recherche (sous-chaîne du titre ou de la description) ; résultats classés par priorité puis échéance
+  // (fields : projection optionnelle des tâches rendues)
+  async searchTasks(userId, query, limit, fields) {
+    return this.sendCommand({
+      action: 'search',
+      userId: String(userId),
+      data: limit !== undefined ? { query, limit } : { query },
+      ...(fields ? { fields } : {})
+    });
+  }
+
+  // Envoie une commande d'autocomplétion : titres distincts commençant par le préfixe saisi
+  async autocomplete(userId, prefix, limit) {
+    return this.sendCommand({
+      action: 'autocomplete',
+      userId: String(userId),
+      data: limit !== undefined ? { prefix, limit } : { prefix }
+    });
+  }
+
+  // --- SYNCHRONISATION DIFFÉRENTIELLE ---
+
+  // Envoie une commande pour lire les tâches modifiées et supprimées depuis une version (fields : projection optionnelle)
+  async getChangesSince(userId, since, limit, fields) {
+    return this.sendCommand({
+      action: 'changesSince',
+      userId: String(userId),
+      data: limit !== undefined ? { since, limit } : { since },
+      ...(fields ? { fields } : {})
+    });
+  }
+
+  // --- ÉCHÉANCES ---
+
+  // Envoie une commande pour lister les tâches non terminées dont l'échéance est dépassée (les plus anciennes d'abord)
+  async getOverdueTasks(userId, limit, fields) {
+    return this.sendCommand({
+      action: 'overdue',
+      userId: String(userId),
+      data: limit !== undefined ? { limit } : {},
+      ...(fields ? { fields } : {})
+    });
+  }
+
+  // Envoie une commande pour lister les tâches non terminées dont l'échéance tombe dans les prochaines secondes
+  async getDueWithin(userId, seconds, limit, fields) {
+    return this.sendCommand({
+      action: 'dueWithin',
+      userId: String(userId),
+      data: limit !== undefined ? { seconds, limit } : { seconds },
+      ...(fields ? { fields } : {})
+    });
+  }
+
+  // Envoie une commande pour lire l'état de l'échéancier (et faire publier les échéances atteintes)
+  async getDueStatus() {
+    return this.sendCommand({
+      action: 'dueStatus'
+    });
+  }
+
+  // Enregistre une fonction appelée pour chaque tâche dont l'échéance est atteinte (CPP_DUE_REMINDERS=true)
+  onTaskDue(handler) {
+    this.dueHandlers.push(handler);
+  }
+
+  // --- STATISTIQUES ---
+
+  // Envoie une commande pour lire les compteurs de l'utilisateur (totaux, statuts, priorités, favoris, retards, créations par mois)
+  async getStats(userId) {
+    return this.sendCommand({
+      action: 'stats',
+      userId: String(userId)
+    });
+  }
+
+  // Envoie une commande pour lire les tâches créées et terminées chaque jour de la semaine courante (lundi à dimanche)
+  async getWeekStats(userId) {
+    return this.sendCommand({
+      action: 'weekStats',
+      userId: String(userId)
+    });
+  }
+
+  // Envoie une commande pour lire les tâches créées et terminées par jour entre deux dates (horodatages en secondes)
+  async getRangeStats(userId, from, to) {
+    const data = {};
+    if (from !== undefined) data.from = from;
+    if (to !== undefined) data.to = to;
+    return this.sendCommand({
+      action: 'rangeStats',
+      userId: String(userId),
+      data
+    });
+  }
+
+  // Importe en une seule commande toutes les tâches d'un fichier de vidage (NDJSON ou instantané binaire)
+  async importTasks(filePath, options = {}) {
+    return this.sendCommand({
+      action: 'import',
+      data: { path: filePath, ...options }
+    }, 10 * 60 * 1000);
+  }
+
+  // Exporte en flux les tâches vers un fichier NDJSON ou binaire (options : format, userId, modifiedSince en secondes,
+  // background pour lire une vue figée dans un processus séparé sans bloquer les autres commandes)
+  async exportTasks(filePath, options = {}) {
+    return this.sendCommand({
+      action: 'export',
+      data: { path: filePath, ...options }
+    }, options.background ? 5000 : 10 * 60 * 1000);
+  }
+
+  async getExportStatus() {
+    return this.sendCommand({
+      action: 'exportStatus'
+    });
+  }
+
+  async takeSnapshot() {
+    return this.sendCommand({
+      action: 'snapshot'
+    });
+  }
+
+  async getSnapshotStatus() {
+    return this.sendCommand({
+      action: 'snapshotStatus'
+    });
+  }
+
+  // Relit les mutations validées après un LSN (fromLsn exclu) ; reprendre ensuite avec le nextLsn renvoyé
+  async getChanges(fromLsn, limit) {
+    return this.sendCommand({
+      action: 'changes',
+      data: limit !== undefined ? { fromLsn, limit } : { fromLsn }
+    });
+  }
+
   // Arrête proprement le processus enfant C++
   close() {
     if (this.cppProcess) {
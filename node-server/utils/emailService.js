@@ -101,8 +101,53 @@ const sendPasswordResetEmail = async (email, username, otp) => {
   }
 };
 
+const sendDueReminderEmail = async (email, username, task) => {
+  try {
+    const dueDate = new Date(task.dueDate * 1000).toUTCString();
+    const request = mailjet
+      .post('send', { version: 'v3.1' })
+      .request({
+        Messages: [
+          {
+            From: {
+              Email: process.env.MAILJET_SENDER_EMAIL || 'noreply@yourdomain.com',
+              Name: 'Task Manager'
+            },
+            To: [
+              {
+                Email: email,
+                Name: username
+              }
+            ],
+            Subject: `Task Due: ${task.title} - Task Manager`,
+            TextPart: `Hi ${username}, your task "${task.title}" was due on ${dueDate}.`,
+            HTMLPart: `
+              <div style="font-family: Arial, sans-serif; padding: 20px; max-width: 600px; margin: 0 auto;">
+                <h2 style="color: #333;">Task Due</h2>
+                <p>Hi <strong>${username}</strong>,</p>
+                <p>Your task has reached its due date:</p>
+                <div style="background-color: #f4f4f4; padding: 15px; text-align: center; font-size: 18px; font-weight: bold; margin: 20px 0;">
+                  ${task.title}
+                </div>
+                <p style="color: #666;">Due on <strong>${dueDate}</strong>.</p>
+              </div>
+            `
+          }
+        ]
+      });
+
+    await request;
+    console.log('Due reminder sent to:', email);
+    return true;
+  } catch (error) {
+    console.error('Mailjet error:', error.statusCode || error.message);
+    throw new Error('Failed to send due reminder email');
+  }
+};
+
 module.exports = {
   generateOTP,
   sendVerificationEmail,
-  sendPasswordResetEmail
+  sendPasswordResetEmail,
+  sendDueReminderEmail
 };
\ No newline at end of file